@@ -0,0 +1,228 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/IoUring.h"
+
+#ifdef LOGTAIL_HAS_IO_URING
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace logtail {
+
+namespace {
+
+inline uint32_t loadAcquire(const uint32_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void storeRelease(uint32_t* p, uint32_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+} // namespace
+
+bool IoUring::Init(uint32_t entries) {
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+    Exit();
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+        return false;
+    }
+    mRingFd = fd;
+    mSqEntries = params.sq_entries;
+
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+    }
+    mSqRingPtr = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (mSqRingPtr == MAP_FAILED) {
+        mSqRingPtr = nullptr;
+        Exit();
+        return false;
+    }
+    if (singleMmap) {
+        mCqRingPtr = mSqRingPtr;
+    } else {
+        mCqRingPtr
+            = mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (mCqRingPtr == MAP_FAILED) {
+            mCqRingPtr = nullptr;
+            Exit();
+            return false;
+        }
+    }
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        Exit();
+        return false;
+    }
+    mSqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(mSqRingPtr);
+    mSqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    mSqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    mSqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    mSqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    mSqeTail = mSqeSubmitted = *mSqTail;
+
+    char* cq = static_cast<char*>(mCqRingPtr);
+    mCqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    mCqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    mCqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    mCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void IoUring::Exit() {
+    if (mSqes != nullptr) {
+        munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if (mCqRingPtr != nullptr && mCqRingPtr != mSqRingPtr) {
+        munmap(mCqRingPtr, mCqRingSize);
+    }
+    mCqRingPtr = nullptr;
+    if (mSqRingPtr != nullptr) {
+        munmap(mSqRingPtr, mSqRingSize);
+        mSqRingPtr = nullptr;
+    }
+    if (mRingFd >= 0) {
+        close(mRingFd);
+        mRingFd = -1;
+    }
+    mSqEntries = 0;
+}
+
+bool IoUring::IsOpSupported(uint8_t op) const {
+#if defined(__NR_io_uring_register)
+    if (mRingFd < 0) {
+        return false;
+    }
+    const size_t opCount = 256;
+    size_t probeSize = sizeof(io_uring_probe) + opCount * sizeof(io_uring_probe_op);
+    std::unique_ptr<char[]> buf(new char[probeSize]);
+    memset(buf.get(), 0, probeSize);
+    auto* probe = reinterpret_cast<io_uring_probe*>(buf.get());
+    // IORING_REGISTER_PROBE is supported since 5.6, older kernels return -EINVAL.
+    if (syscall(__NR_io_uring_register, mRingFd, IORING_REGISTER_PROBE, probe, opCount) < 0) {
+        return false;
+    }
+    if (op > probe->last_op) {
+        return false;
+    }
+    return probe->ops[op].flags & IO_URING_OP_SUPPORTED;
+#else
+    return false;
+#endif
+}
+
+io_uring_sqe* IoUring::GetSqe() {
+    if (mRingFd < 0) {
+        return nullptr;
+    }
+    uint32_t head = loadAcquire(mSqHead);
+    if (mSqeTail - head >= mSqEntries) {
+        return nullptr;
+    }
+    uint32_t idx = mSqeTail & mSqMask;
+    io_uring_sqe* sqe = &mSqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    mSqArray[idx] = idx;
+    ++mSqeTail;
+    return sqe;
+}
+
+int IoUring::Submit(uint32_t waitNr) {
+    uint32_t toSubmit = mSqeTail - mSqeSubmitted;
+    if (toSubmit == 0 && waitNr == 0) {
+        return 0;
+    }
+    storeRelease(mSqTail, mSqeTail);
+    int ret = enter(toSubmit, waitNr, waitNr > 0 ? IORING_ENTER_GETEVENTS : 0);
+    if (ret > 0) {
+        mSqeSubmitted += static_cast<uint32_t>(ret);
+    }
+    return ret;
+}
+
+int IoUring::WaitCqe() {
+    if (loadAcquire(mCqTail) != *mCqHead) {
+        return 0;
+    }
+    int ret = enter(0, 1, IORING_ENTER_GETEVENTS);
+    return ret < 0 ? ret : 0;
+}
+
+bool IoUring::PeekCqe(uint64_t& userData, int32_t& res) {
+    if (mRingFd < 0) {
+        return false;
+    }
+    uint32_t head = *mCqHead;
+    if (head == loadAcquire(mCqTail)) {
+        return false;
+    }
+    const io_uring_cqe& cqe = mCqes[head & mCqMask];
+    userData = cqe.user_data;
+    res = cqe.res;
+    storeRelease(mCqHead, head + 1);
+    return true;
+}
+
+int IoUring::enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+#if defined(__NR_io_uring_enter)
+    int ret;
+    do {
+        ret = static_cast<int>(syscall(__NR_io_uring_enter, mRingFd, toSubmit, minComplete, flags, nullptr, 0));
+    } while (ret < 0 && errno == EINTR);
+    return ret < 0 ? -errno : ret;
+#else
+    return -ENOSYS;
+#endif
+}
+
+bool IoUring::IsSupported(uint8_t op) {
+    static std::mutex sMutex;
+    static bool sProbed[256] = {false};
+    static bool sSupported[256] = {false};
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (!sProbed[op]) {
+        IoUring ring;
+        sSupported[op] = ring.Init(2) && ring.IsOpSupported(op);
+        sProbed[op] = true;
+    }
+    return sSupported[op];
+}
+
+} // namespace logtail
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define LOGTAIL_HAS_IO_URING 1
+#endif
+#endif
+
+#ifdef LOGTAIL_HAS_IO_URING
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace logtail {
+
+// IoUring is a minimal wrapper of the raw io_uring syscalls (no liburing dependency).
+// It is NOT thread-safe, each thread should own its ring.
+//
+// Usage:
+//   1. GetSqe() to get a submission entry and fill it, repeat until nullptr or done.
+//   2. Submit() to hand over all filled entries to kernel, optionally waiting.
+//   3. PeekCqe() to consume completions.
+class IoUring {
+public:
+    IoUring() = default;
+    ~IoUring() { Exit(); }
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Init sets up a ring with at least @entries submission entries.
+    // @return false if io_uring is not available (old kernel, seccomp, etc.).
+    bool Init(uint32_t entries);
+    void Exit();
+    bool IsValid() const { return mRingFd >= 0; }
+
+    // IsOpSupported checks if @op is supported by running kernel (via IORING_REGISTER_PROBE).
+    bool IsOpSupported(uint8_t op) const;
+
+    uint32_t GetSqEntries() const { return mSqEntries; }
+
+    // GetSqe returns a zeroed submission entry, or nullptr if submission queue is full.
+    io_uring_sqe* GetSqe();
+
+    // Submit submits all entries got by GetSqe since last Submit and waits for at least
+    // @waitNr completions.
+    // @return number of entries submitted, or -errno.
+    int Submit(uint32_t waitNr = 0);
+
+    // WaitCqe blocks until at least one completion is available.
+    // @return 0 on success, or -errno.
+    int WaitCqe();
+
+    // PeekCqe consumes one completion if available.
+    bool PeekCqe(uint64_t& userData, int32_t& res);
+
+    // IsSupported probes (once) whether current process can create a ring and run @op.
+    static bool IsSupported(uint8_t op);
+
+private:
+    int enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags);
+
+    int mRingFd = -1;
+    uint32_t mSqEntries = 0;
+
+    void* mSqRingPtr = nullptr;
+    size_t mSqRingSize = 0;
+    void* mCqRingPtr = nullptr;
+    size_t mCqRingSize = 0;
+    io_uring_sqe* mSqes = nullptr;
+    size_t mSqesSize = 0;
+
+    uint32_t* mSqHead = nullptr;
+    uint32_t* mSqTail = nullptr;
+    uint32_t mSqMask = 0;
+    uint32_t* mSqArray = nullptr;
+    // Local tail of entries got by GetSqe, published to mSqTail by Submit.
+    uint32_t mSqeTail = 0;
+    uint32_t mSqeSubmitted = 0;
+
+    uint32_t* mCqHead = nullptr;
+    uint32_t* mCqTail = nullptr;
+    uint32_t mCqMask = 0;
+    io_uring_cqe* mCqes = nullptr;
+};
+
+} // namespace logtail
+
+#endif
@@ -0,0 +1,491 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/RegexMatcher.h"
+
+#include <bitset>
+#include <cctype>
+
+#include "common/StringTools.h"
+
+namespace logtail {
+
+static const uint8_t kMaybe = 1;
+static const uint8_t kSure = 2;
+// longer prefix rarely rejects more lines
+static const size_t kMaxPrefixSize = 64;
+
+namespace {
+
+// CharSet is a set of bytes an atom can match. Classes like \w depend on locale for bytes >= 0x80, so they are
+// only in mMaybe.
+struct CharSet {
+    std::bitset<256> mSure;
+    std::bitset<256> mMaybe;
+
+    void Add(uint8_t c) {
+        mSure.set(c);
+        mMaybe.set(c);
+    }
+    void Add(const CharSet& other) {
+        mSure |= other.mSure;
+        mMaybe |= other.mMaybe;
+    }
+    void Negate() {
+        std::bitset<256> sure = ~mMaybe;
+        mMaybe = ~mSure;
+        mSure = sure;
+    }
+};
+
+bool IsSpecial(char c) {
+    static const std::string sSpecials = "\\^$.|?*+()[]{}";
+    return sSpecials.find(c) != std::string::npos;
+}
+
+// GetEscapeClass handles \d \w \s and their negations.
+bool GetEscapeClass(char c, CharSet& set) {
+    char lower = static_cast<char>(tolower(c));
+    if (lower != 'd' && lower != 'w' && lower != 's') {
+        return false;
+    }
+    for (int b = 0; b < 128; ++b) {
+        if ((lower == 'd' && isdigit(b)) || (lower == 'w' && (isalnum(b) || b == '_'))
+            || (lower == 's' && (b == ' ' || (b >= '\t' && b <= '\r')))) {
+            set.Add(static_cast<uint8_t>(b));
+        }
+    }
+    for (int b = 128; b < 256; ++b) {
+        set.mMaybe.set(b);
+    }
+    if (c != lower) {
+        set.Negate();
+    }
+    return true;
+}
+
+// GetEscapeLiteral handles escaped punctuations, control characters and \xHH.
+// @return the number of chars consumed after '\', 0 if it is not a literal.
+size_t GetEscapeLiteral(const std::string& pattern, size_t pos, uint8_t& c) {
+    if (pos >= pattern.size()) {
+        return 0;
+    }
+    char e = pattern[pos];
+    switch (e) {
+        case 't':
+            c = '\t';
+            return 1;
+        case 'n':
+            c = '\n';
+            return 1;
+        case 'r':
+            c = '\r';
+            return 1;
+        case 'f':
+            c = '\f';
+            return 1;
+        case 'x':
+            if (pos + 2 < pattern.size() && isxdigit(pattern[pos + 1]) && isxdigit(pattern[pos + 2])) {
+                c = static_cast<uint8_t>(std::stoi(pattern.substr(pos + 1, 2), nullptr, 16));
+                return 3;
+            }
+            return 0;
+        default:
+            if (isalnum(static_cast<unsigned char>(e)) || static_cast<unsigned char>(e) >= 0x80) {
+                // anchors, backreferences and other escapes, \v is a class of vertical spaces in boost
+                return 0;
+            }
+            c = static_cast<uint8_t>(e);
+            return 1;
+    }
+}
+
+// ParseBracket parses a bracket expression starting at @pos ('['), and moves @pos after ']'.
+bool ParseBracket(const std::string& pattern, size_t& pos, CharSet& set) {
+    size_t i = pos + 1;
+    bool negated = false;
+    if (i < pattern.size() && pattern[i] == '^') {
+        negated = true;
+        ++i;
+    }
+    bool first = true;
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        if (c == ']' && !first) {
+            break;
+        }
+        first = false;
+        if (c == '[' && i + 1 < pattern.size()
+            && (pattern[i + 1] == ':' || pattern[i + 1] == '=' || pattern[i + 1] == '.')) {
+            // posix class, equivalence class or collating element
+            return false;
+        }
+        uint8_t lo = 0;
+        if (c == '\\') {
+            CharSet cls;
+            if (i + 1 < pattern.size() && GetEscapeClass(pattern[i + 1], cls)) {
+                set.Add(cls);
+                i += 2;
+                continue;
+            }
+            size_t len = GetEscapeLiteral(pattern, i + 1, lo);
+            if (len == 0) {
+                return false;
+            }
+            i += 1 + len;
+        } else {
+            lo = static_cast<uint8_t>(c);
+            ++i;
+        }
+        if (i + 1 < pattern.size() && pattern[i] == '-' && pattern[i + 1] != ']') {
+            uint8_t hi = 0;
+            if (pattern[i + 1] == '\\') {
+                size_t len = GetEscapeLiteral(pattern, i + 2, hi);
+                if (len == 0) {
+                    return false;
+                }
+                i += 2 + len;
+            } else {
+                hi = static_cast<uint8_t>(pattern[i + 1]);
+                i += 2;
+            }
+            // boost compares bytes >= 0x80 as signed char
+            if (hi < lo || hi >= 0x80) {
+                return false;
+            }
+            for (int b = lo; b <= hi; ++b) {
+                set.Add(static_cast<uint8_t>(b));
+            }
+        } else {
+            set.Add(lo);
+        }
+    }
+    if (i >= pattern.size()) {
+        return false;
+    }
+    if (negated) {
+        set.Negate();
+    }
+    pos = i + 1;
+    return true;
+}
+
+bool HasTopLevelAlternation(const std::string& pattern) {
+    int depth = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '\\') {
+            ++i;
+        } else if (c == '[') {
+            CharSet ignored;
+            size_t pos = i;
+            if (!ParseBracket(pattern, pos, ignored)) {
+                // cannot tell where the bracket ends
+                return true;
+            }
+            i = pos - 1;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (c == '|' && depth == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// AnalyzePrefix collects the fixed-width atoms at the beginning of @pattern.
+// @return true if the whole pattern is collected.
+bool AnalyzePrefix(const std::string& pattern, std::vector<CharSet>& prefix) {
+    if (HasTopLevelAlternation(pattern)) {
+        return false;
+    }
+    size_t i = 0;
+    if (!pattern.empty() && pattern[0] == '^') {
+        // Search and Match are anchored at the beginning of buffer already
+        ++i;
+    }
+    while (i < pattern.size()) {
+        CharSet atom;
+        char c = pattern[i];
+        if (c == '.') {
+            atom.mSure.set();
+            atom.mMaybe.set();
+            ++i;
+        } else if (c == '[') {
+            if (!ParseBracket(pattern, i, atom)) {
+                return false;
+            }
+        } else if (c == '\\') {
+            uint8_t literal = 0;
+            if (i + 1 < pattern.size() && GetEscapeClass(pattern[i + 1], atom)) {
+                i += 2;
+            } else {
+                size_t len = GetEscapeLiteral(pattern, i + 1, literal);
+                if (len == 0) {
+                    return false;
+                }
+                atom.Add(literal);
+                i += 1 + len;
+            }
+        } else if (IsSpecial(c)) {
+            return false;
+        } else {
+            atom.Add(static_cast<uint8_t>(c));
+            ++i;
+        }
+
+        size_t repeat = 1;
+        bool last = false;
+        if (i < pattern.size()) {
+            char q = pattern[i];
+            if (q == '*' || q == '?') {
+                return false;
+            } else if (q == '+') {
+                last = true;
+            } else if (q == '{') {
+                size_t close = pattern.find('}', i);
+                if (close == std::string::npos) {
+                    return false;
+                }
+                std::string range = pattern.substr(i + 1, close - i - 1);
+                size_t comma = range.find(',');
+                std::string min = range.substr(0, comma);
+                if (min.empty() || min.find_first_not_of("0123456789") != std::string::npos || min.size() > 4) {
+                    return false;
+                }
+                repeat = StringTo<size_t>(min);
+                if (comma != std::string::npos) {
+                    last = true;
+                } else {
+                    i = close + 1;
+                    // lazy or possessive exact repetition is the same
+                    if (i < pattern.size() && (pattern[i] == '?' || pattern[i] == '+')) {
+                        ++i;
+                    }
+                }
+            }
+        }
+        for (size_t r = 0; r < repeat; ++r) {
+            if (prefix.size() >= kMaxPrefixSize) {
+                return false;
+            }
+            prefix.push_back(atom);
+        }
+        if (last) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ConvertToRE2 rewrites @pattern in RE2 syntax with the same meaning as boost.
+// @return false if the meaning cannot be kept, RE2 itself rejects unsupported syntax like backreferences.
+bool ConvertToRE2(const std::string& pattern, std::string& res, bool& trailingDollar) {
+    // boost \s contains \v, RE2 \s does not
+    static const std::string sSpaces = "\\t\\n\\v\\f\\r ";
+    trailingDollar = false;
+    res.clear();
+    if (pattern.find("\\Q") != std::string::npos || pattern.find("{,") != std::string::npos) {
+        return false;
+    }
+    // unicode classes differ for bytes, \v is a class in boost but vertical tab in RE2
+    if (pattern.find("\\p") != std::string::npos || pattern.find("\\P") != std::string::npos
+        || pattern.find("\\v") != std::string::npos) {
+        return false;
+    }
+    bool inBracket = false;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '\\' && i + 1 < pattern.size()) {
+            char e = pattern[++i];
+            if (e == 's') {
+                res += inBracket ? sSpaces : "[" + sSpaces + "]";
+            } else if (e == 'S') {
+                if (inBracket) {
+                    return false;
+                }
+                res += "[^" + sSpaces + "]";
+            } else {
+                res += c;
+                res += e;
+            }
+            continue;
+        }
+        if (inBracket) {
+            if (c == '[' && i + 1 < pattern.size() && pattern[i + 1] == ':') {
+                size_t end = pattern.find(":]", i + 2);
+                if (end == std::string::npos) {
+                    return false;
+                }
+                res += pattern.substr(i, end + 2 - i);
+                i = end + 1;
+                continue;
+            }
+            if (c == ']') {
+                inBracket = false;
+            }
+            res += c;
+            continue;
+        }
+        if (c == '[') {
+            inBracket = true;
+            res += c;
+            // ']' right after '[' or '[^' is a literal
+            if (i + 1 < pattern.size() && pattern[i + 1] == '^') {
+                res += pattern[++i];
+            }
+            if (i + 1 < pattern.size() && pattern[i + 1] == ']') {
+                res += "\\]";
+                ++i;
+            }
+            continue;
+        }
+        // boost matches '^' and '$' at line boundaries (\n, \r, \f), only keep those at the boundary of pattern
+        if (c == '^' && i != 0) {
+            return false;
+        }
+        if (c == '$') {
+            if (i + 1 != pattern.size()) {
+                return false;
+            }
+            trailingDollar = true;
+        }
+        res += c;
+    }
+    return !inBracket;
+}
+
+} // namespace
+
+RegexMatcher::RegexMatcher(const std::string& pattern) : mPattern(pattern), mBoostRegex(pattern) {
+    std::vector<CharSet> prefix;
+    mPrefixIsPattern = AnalyzePrefix(pattern, prefix);
+    for (const auto& atom : prefix) {
+        ByteClass cls{};
+        for (int b = 0; b < 256; ++b) {
+            cls[b] = (atom.mMaybe[b] ? kMaybe : 0) | (atom.mSure[b] ? kSure : 0);
+        }
+        mPrefix.push_back(cls);
+    }
+
+    // RE2 is still needed if the prefix is not sure about bytes >= 0x80
+    std::string re2Pattern;
+    bool trailingDollar = false;
+    if (ConvertToRE2(pattern, re2Pattern, trailingDollar)) {
+        RE2::Options options;
+        options.set_encoding(RE2::Options::EncodingLatin1);
+        options.set_dot_nl(true);
+        options.set_log_errors(false);
+        std::unique_ptr<RE2> re(new RE2(re2Pattern, options));
+        // group count differs if RE2 parses the pattern differently
+        if (re->ok() && static_cast<size_t>(re->NumberOfCapturingGroups()) == mBoostRegex.mark_count()) {
+            mRE2 = std::move(re);
+            mRE2ForSearch = !trailingDollar;
+        }
+    }
+}
+
+RegexMatcher::Engine RegexMatcher::GetEngine() const {
+    if (mPrefixIsPattern) {
+        return Engine::PREFIX;
+    }
+    return mRE2ForSearch ? Engine::RE2 : Engine::BOOST;
+}
+
+RegexMatcher::PrefixResult RegexMatcher::checkPrefix(const char* buffer, size_t size, bool wholeBuffer) const {
+    if (size < mPrefix.size() || (mPrefixIsPattern && wholeBuffer && size != mPrefix.size())) {
+        return PrefixResult::REJECT;
+    }
+    uint8_t all = kMaybe | kSure;
+    for (size_t i = 0; i < mPrefix.size(); ++i) {
+        uint8_t res = mPrefix[i][static_cast<uint8_t>(buffer[i])];
+        if (!(res & kMaybe)) {
+            return PrefixResult::REJECT;
+        }
+        all &= res;
+    }
+    return mPrefixIsPattern && (all & kSure) ? PrefixResult::ACCEPT : PrefixResult::UNKNOWN;
+}
+
+bool RegexMatcher::Search(const char* buffer, size_t size, std::string& exception) const {
+    switch (checkPrefix(buffer, size, false)) {
+        case PrefixResult::REJECT:
+            return false;
+        case PrefixResult::ACCEPT:
+            return true;
+        default:
+            break;
+    }
+    if (mRE2ForSearch) {
+        return mRE2->Match(re2::StringPiece(buffer, size), 0, size, RE2::ANCHOR_START, nullptr, 0);
+    }
+    return BoostRegexSearch(buffer, size, mBoostRegex, exception);
+}
+
+bool RegexMatcher::Match(const char* buffer, size_t size, std::string& exception) const {
+    switch (checkPrefix(buffer, size, true)) {
+        case PrefixResult::REJECT:
+            return false;
+        case PrefixResult::ACCEPT:
+            return true;
+        default:
+            break;
+    }
+    if (mRE2) {
+        return mRE2->Match(re2::StringPiece(buffer, size), 0, size, RE2::ANCHOR_BOTH, nullptr, 0);
+    }
+    return BoostRegexMatch(buffer, size, mBoostRegex, exception);
+}
+
+bool RegexMatcher::Match(const char* buffer,
+                         size_t size,
+                         std::vector<StringView>& groups,
+                         std::string& exception) const {
+    groups.clear();
+    switch (checkPrefix(buffer, size, true)) {
+        case PrefixResult::REJECT:
+            return false;
+        case PrefixResult::ACCEPT:
+            // the pattern has no group
+            return true;
+        default:
+            break;
+    }
+    if (mRE2) {
+        static thread_local std::vector<re2::StringPiece> sPieces;
+        sPieces.resize(GetGroupCount() + 1);
+        if (!mRE2->Match(re2::StringPiece(buffer, size), 0, size, RE2::ANCHOR_BOTH, sPieces.data(), sPieces.size())) {
+            return false;
+        }
+        for (size_t i = 1; i < sPieces.size(); ++i) {
+            // unmatched group
+            groups.emplace_back(sPieces[i].data() ? sPieces[i].data() : buffer + size, sPieces[i].size());
+        }
+        return true;
+    }
+    boost::match_results<const char*> what;
+    if (!BoostRegexMatch(buffer, size, mBoostRegex, exception, what, boost::match_default)) {
+        return false;
+    }
+    for (size_t i = 1; i < what.size(); ++i) {
+        groups.emplace_back(what[i].first, what[i].length());
+    }
+    return true;
+}
+
+} // namespace logtail
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <re2/re2.h>
+
+#include <array>
+#include <boost/regex.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "models/StringView.h"
+
+namespace logtail {
+
+// RegexMatcher runs a boost (perl syntax) regex with cheaper engines when the result is the same.
+//
+// At construction the pattern is analyzed for:
+//   1. a prefix of fixed-width atoms every match must start with, e.g. `\d{4}-\d{2}-\d{2}` or `\[`. Lines not
+//      starting with such bytes are rejected without running any regex engine. If the whole pattern is such a
+//      prefix, the prefix check is the final result.
+//   2. whether RE2 (DFA) gives the same result as boost, i.e. no backreference, lookaround or other construct RE2
+//      does not support, and no anchor whose meaning differs between them. boost::regex is used otherwise.
+// Both engines treat input as bytes, and '.' matches newline as boost does by default.
+class RegexMatcher {
+public:
+    enum class Engine { PREFIX, RE2, BOOST };
+
+    // @throw boost::regex_error if @pattern is not a valid regex, same as boost::regex.
+    explicit RegexMatcher(const std::string& pattern);
+    RegexMatcher(const RegexMatcher&) = delete;
+    RegexMatcher& operator=(const RegexMatcher&) = delete;
+
+    // Search checks if @buffer starts with a match, same as BoostRegexSearch (match_continuous).
+    bool Search(const char* buffer, size_t size, std::string& exception) const;
+    // Match checks if the whole @buffer matches, same as BoostRegexMatch.
+    bool Match(const char* buffer, size_t size, std::string& exception) const;
+    // Match checks if the whole @buffer matches, and sets @groups to capturing groups (without the whole match).
+    bool Match(const char* buffer, size_t size, std::vector<StringView>& groups, std::string& exception) const;
+
+    const std::string& GetPattern() const { return mPattern; }
+    const boost::regex& GetBoostRegex() const { return mBoostRegex; }
+    size_t GetGroupCount() const { return mBoostRegex.mark_count(); }
+    // GetEngine returns the engine used by Search, for tests and benchmarks.
+    Engine GetEngine() const;
+
+private:
+    enum class PrefixResult { REJECT, ACCEPT, UNKNOWN };
+
+    // bit 0: the byte may match the atom, bit 1: the byte surely matches the atom
+    using ByteClass = std::array<uint8_t, 256>;
+
+    PrefixResult checkPrefix(const char* buffer, size_t size, bool wholeBuffer) const;
+
+    std::string mPattern;
+    boost::regex mBoostRegex;
+    std::unique_ptr<RE2> mRE2;
+    // RE2 differs from boost for trailing '$' in Search, as boost also matches before '\r' and '\f'
+    bool mRE2ForSearch = false;
+    std::vector<ByteClass> mPrefix;
+    // the whole pattern is mPrefix, so a match is exactly mPrefix.size() bytes
+    bool mPrefixIsPattern = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RegexMatcherUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,630 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/TimeFormatParser.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace logtail {
+
+namespace {
+
+const int kTmYearBase = 1900;
+const int kMinYear = std::numeric_limits<decltype(tm::tm_year)>::min();
+// seconds are at most 10 digits in epoch format, the rest is the fraction
+const size_t kEpochSecondLength = 10;
+
+const char* const kDays[7] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+const char* const kAbDays[7] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+const char* const kMonths[12] = {"January",
+                                 "February",
+                                 "March",
+                                 "April",
+                                 "May",
+                                 "June",
+                                 "July",
+                                 "August",
+                                 "September",
+                                 "October",
+                                 "November",
+                                 "December"};
+const char* const kAbMonths[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+const char* const kAmPm[2] = {"AM", "PM"};
+const char* const kNaStandard[4] = {"EST", "CST", "MST", "PST"};
+const char* const kNaDaylight[4] = {"EDT", "CDT", "MDT", "PDT"};
+
+const uint32_t kPow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// same as isspace in C locale
+inline bool IsSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline char ToLower(char c) {
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define TIME_FORMAT_PARSER_SWAR
+#endif
+
+#ifdef TIME_FORMAT_PARSER_SWAR
+// CountDigits8 returns the number of leading digits in the 8 bytes at @buf.
+inline size_t CountDigits8(const char* buf) {
+    uint64_t v;
+    memcpy(&v, buf, sizeof(v));
+    uint64_t x = v ^ 0x3030303030303030ULL;
+    // a byte is not a digit if its high nibble is not 3, or its low nibble is greater than 9
+    uint64_t nonDigit = (x & 0xF0F0F0F0F0F0F0F0ULL)
+        | (((x & 0x0F0F0F0F0F0F0F0FULL) + 0x0606060606060606ULL) & 0x1010101010101010ULL);
+    return nonDigit == 0 ? 8 : static_cast<size_t>(__builtin_ctzll(nonDigit)) / 8;
+}
+
+// ParseDigits8 converts the first @n (1 <= @n <= 8) bytes at @buf, which must be digits.
+inline uint32_t ParseDigits8(const char* buf, size_t n) {
+    uint64_t v;
+    memcpy(&v, buf, sizeof(v));
+    // leading bytes (the first ones in little endian) are moved to the high end, shifted in zeros are 0 digits
+    v = (v & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - n));
+    v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v * 10000 + (v >> 32)) & 0xFFFFFFFFULL;
+    return static_cast<uint32_t>(v);
+}
+
+inline bool IsDigits4(const char* buf) {
+    uint32_t v;
+    memcpy(&v, buf, sizeof(v));
+    uint32_t x = v ^ 0x30303030U;
+    return ((x & 0xF0F0F0F0U) | (((x & 0x0F0F0F0FU) + 0x06060606U) & 0x10101010U)) == 0;
+}
+
+inline uint32_t ParseDigits4(const char* buf) {
+    uint32_t v;
+    memcpy(&v, buf, sizeof(v));
+    v &= 0x0F0F0F0FU;
+    v = (v * 10 + (v >> 8)) & 0x00FF00FFU;
+    return (v * 100 + (v >> 16)) & 0xFFFFU;
+}
+#endif
+
+// ConvNum is conv_num of strptime_ns: the upper limit also determines the max number of digits.
+const char* ConvNum(const char* bp, const char* end, int& dest, unsigned int lowerLimit, unsigned int upperLimit) {
+    if (bp >= end || !IsDigit(*bp)) {
+        return nullptr;
+    }
+    unsigned int result = 0;
+    unsigned int rulim = upperLimit;
+    do {
+        result = result * 10 + (*bp - '0');
+        rulim /= 10;
+        ++bp;
+    } while (result * 10 <= upperLimit && rulim && bp < end && IsDigit(*bp));
+    if (result < lowerLimit || result > upperLimit) {
+        return nullptr;
+    }
+    dest = result;
+    return bp;
+}
+
+// ConvYear is ConvNum(0, 9999), which takes 4 digits at most.
+inline const char* ConvYear(const char* bp, const char* end, int& dest) {
+#ifdef TIME_FORMAT_PARSER_SWAR
+    if (end - bp >= 4 && IsDigits4(bp)) {
+        dest = ParseDigits4(bp);
+        return bp + 4;
+    }
+#endif
+    return ConvNum(bp, end, dest, 0, 9999);
+}
+
+// FindString is find_string of strptime_ns: full names are checked before abbreviated ones, case insensitive.
+const char*
+FindString(const char* bp, const char* end, int& target, const char* const* n1, const char* const* n2, int c) {
+    for (; n1 != nullptr; n1 = n2, n2 = nullptr) {
+        for (int i = 0; i < c; ++i) {
+            size_t len = strlen(n1[i]);
+            if (static_cast<size_t>(end - bp) < len) {
+                continue;
+            }
+            size_t j = 0;
+            for (; j < len && ToLower(n1[i][j]) == ToLower(bp[j]); ++j) {
+            }
+            if (j == len) {
+                target = i;
+                return bp + len;
+            }
+        }
+    }
+    return nullptr;
+}
+
+// ConvZone is %z of strptime_ns. The offset is not applied to the result, only tm_isdst may be set.
+const char* ConvZone(const char* bp, const char* end, struct tm& tm) {
+    while (bp < end && IsSpace(*bp)) {
+        ++bp;
+    }
+    if (bp >= end) {
+        return nullptr;
+    }
+    bool isUTC = false;
+    switch (*bp) {
+        case 'G':
+            if (end - bp < 3 || bp[1] != 'M' || bp[2] != 'T') {
+                return nullptr;
+            }
+            bp += 3;
+            isUTC = true;
+            break;
+        case 'U':
+            if (end - bp < 2 || bp[1] != 'T') {
+                return nullptr;
+            }
+            bp += 2;
+            isUTC = true;
+            break;
+        case 'Z':
+            ++bp;
+            isUTC = true;
+            break;
+        case '+':
+        case '-':
+            break;
+        default: {
+            int i = 0;
+            const char* ep = FindString(bp, end, i, kNaStandard, nullptr, 4);
+            if (ep != nullptr) {
+                return ep;
+            }
+            ep = FindString(bp, end, i, kNaDaylight, nullptr, 4);
+            if (ep != nullptr) {
+                tm.tm_isdst = 1;
+                return ep;
+            }
+            // military time zones, no 'J'
+            if ((*bp >= 'A' && *bp <= 'I') || (*bp >= 'L' && *bp <= 'Y')) {
+                return bp + 1;
+            }
+            return nullptr;
+        }
+    }
+    if (isUTC) {
+        tm.tm_isdst = 0;
+        return bp;
+    }
+    ++bp;
+    int offs = 0;
+    int i = 0;
+    while (i < 4 && bp < end) {
+        if (IsDigit(*bp)) {
+            offs = offs * 10 + (*bp++ - '0');
+            ++i;
+            continue;
+        }
+        if (i == 2 && *bp == ':') {
+            ++bp;
+            continue;
+        }
+        break;
+    }
+    if (i != 2 && (i != 4 || offs % 100 >= 60)) {
+        return nullptr;
+    }
+    tm.tm_isdst = 0;
+    return bp;
+}
+
+// LocalMidnight caches the result of mktime for midnight of recent days.
+struct LocalMidnight {
+    int64_t mKey = -1;
+    time_t mTime = 0;
+    // mktime(day + seconds) == mktime(day) + seconds holds for the whole day, false if the utc offset of local
+    // standard time changes during the day
+    bool mUniform = false;
+};
+
+// MakeLocalTime returns mktime(@tm) for tm_isdst = 0.
+time_t MakeLocalTime(struct tm& tm) {
+    if (tm.tm_isdst != 0 || tm.tm_year < -kTmYearBase || tm.tm_year > 9999 - kTmYearBase || tm.tm_mon < 0
+        || tm.tm_mon > 11 || tm.tm_mday < 1 || tm.tm_mday > 31) {
+        return mktime(&tm);
+    }
+    static thread_local std::array<LocalMidnight, 64> sDays;
+    int64_t key = ((static_cast<int64_t>(tm.tm_year) + kTmYearBase) * 12 + tm.tm_mon) * 32 + tm.tm_mday;
+    LocalMidnight& day = sDays[key % sDays.size()];
+    if (day.mKey != key) {
+        struct tm dayTm = {0};
+        dayTm.tm_year = tm.tm_year;
+        dayTm.tm_mon = tm.tm_mon;
+        dayTm.tm_mday = tm.tm_mday;
+        // mktime normalizes its argument, so the last second is set up before
+        struct tm lastSecondTm = dayTm;
+        lastSecondTm.tm_hour = 23;
+        lastSecondTm.tm_min = 59;
+        lastSecondTm.tm_sec = 59;
+        day.mTime = mktime(&dayTm);
+        day.mUniform = day.mTime != -1 && mktime(&lastSecondTm) - day.mTime == 86399;
+        day.mKey = key;
+    }
+    if (!day.mUniform) {
+        return mktime(&tm);
+    }
+    return day.mTime + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+}
+
+// GetCurrentLocalTime returns localtime of now, cached for a second.
+bool GetCurrentLocalTime(struct tm& currentTm) {
+    static thread_local time_t sLastTime = -1;
+    static thread_local struct tm sLastTm = {0};
+    time_t now = time(nullptr);
+    if (now != sLastTime) {
+#if defined(_MSC_VER)
+        if (localtime_s(&sLastTm, &now) != 0)
+#else
+        if (nullptr == localtime_r(&now, &sLastTm))
+#endif
+        {
+            return false;
+        }
+        sLastTime = now;
+    }
+    currentTm = sLastTm;
+    return true;
+}
+
+} // namespace
+
+const char* ParseNanosecond(const char* buf, size_t size, long& nanosecond, int& nanosecondLength) {
+    const char* bp = buf;
+    const char* end = buf + size;
+    if (bp >= end || !IsDigit(*bp)) {
+        return nullptr;
+    }
+    // same as conv_nanosecond, digits after the 9th one overflow as unsigned int
+    unsigned int result = 0;
+#ifdef TIME_FORMAT_PARSER_SWAR
+    if (end - bp >= 8) {
+        size_t n = CountDigits8(bp);
+        result = ParseDigits8(bp, n);
+        bp += n;
+    }
+#endif
+    for (; bp < end && IsDigit(*bp); ++bp) {
+        result = result * 10 + (*bp - '0');
+    }
+    int digitNum = static_cast<int>(bp - buf);
+    if (digitNum < 9) {
+        result *= kPow10[9 - digitNum];
+    }
+    nanosecond = result;
+    nanosecondLength = digitNum;
+    return bp;
+}
+
+void TimeFormatParser::Init(const std::string& format, int32_t specifiedYear) {
+    mFormat = format;
+    mSpecifiedYear = specifiedYear;
+    mInstructions.clear();
+    const char* nanosecondPos = strstr(mFormat.c_str(), "%f");
+    mHasNanosecond = nanosecondPos != nullptr;
+    mEndsWithNanosecond = mHasNanosecond && nanosecondPos == mFormat.c_str() + mFormat.size() - 2;
+    mIsEpoch = mFormat == "%s";
+    // "%f" alone does not set seconds
+    mCompiled = mIsEpoch || (mFormat != "%f" && compile(mFormat.c_str(), 0));
+    if (!mCompiled) {
+        mInstructions.clear();
+    }
+}
+
+bool TimeFormatParser::compile(const char* format, int depth) {
+    Instruction inst;
+    while (char c = *format++) {
+        inst = Instruction();
+        if (IsSpace(c)) {
+            inst.mCode = OpCode::SPACE;
+            mInstructions.push_back(inst);
+            continue;
+        }
+        if (c != '%') {
+            inst.mCode = OpCode::LITERAL;
+            inst.mLiteral = c;
+            mInstructions.push_back(inst);
+            continue;
+        }
+        const char* subFormat = nullptr;
+        switch (c = *format++) {
+            case '%':
+                inst.mCode = OpCode::LITERAL;
+                inst.mLiteral = '%';
+                break;
+            case 'c':
+                subFormat = "%a %b %d %H:%M:%S %Y";
+                break;
+            case 'F':
+                subFormat = "%Y-%m-%d";
+                break;
+            case 'R':
+                subFormat = "%H:%M";
+                break;
+            case 'r':
+                subFormat = "%I:%M:%S %p";
+                break;
+            case 'T':
+            case 'X':
+                subFormat = "%H:%M:%S";
+                break;
+            case 'A':
+            case 'a':
+                inst.mCode = OpCode::WEEKDAY_NAME;
+                break;
+            case 'B':
+            case 'b':
+            case 'h':
+                inst.mCode = OpCode::MONTH_NAME;
+                break;
+            case 'd':
+            case 'e':
+                inst = {OpCode::NUMBER, 0, Field::MDAY, 1, 31};
+                break;
+            case 'f':
+                inst.mCode = OpCode::NANOSECOND;
+                break;
+            case 'k':
+            case 'H':
+                inst = {OpCode::NUMBER, 0, Field::HOUR, 0, 23};
+                break;
+            case 'l':
+            case 'I':
+                inst.mCode = OpCode::HOUR12;
+                break;
+            case 'j':
+                inst = {OpCode::NUMBER, 0, Field::NONE, 1, 366};
+                break;
+            case 'M':
+                inst = {OpCode::NUMBER, 0, Field::MIN, 0, 59};
+                break;
+            case 'm':
+                inst = {OpCode::NUMBER, 0, Field::MON, 1, 12};
+                break;
+            case 'p':
+                inst.mCode = OpCode::AM_PM;
+                break;
+            case 'S':
+                inst = {OpCode::NUMBER, 0, Field::SEC, 0, 61};
+                break;
+            case 'U':
+            case 'W':
+            case 'V':
+                inst = {OpCode::NUMBER, 0, Field::NONE, 0, 53};
+                break;
+            case 'w':
+                // week day is not used by mktime
+                inst = {OpCode::NUMBER, 0, Field::WDAY, 0, 6};
+                break;
+            case 'u':
+                inst = {OpCode::NUMBER, 0, Field::WDAY, 1, 7};
+                break;
+            case 'g':
+                inst = {OpCode::NUMBER, 0, Field::NONE, 0, 99};
+                break;
+            case 'Y':
+                inst.mCode = OpCode::YEAR;
+                break;
+            case 'y':
+                inst.mCode = OpCode::SHORT_YEAR;
+                break;
+            case 'z':
+                inst.mCode = OpCode::ZONE;
+                break;
+            case 'n':
+            case 't':
+                inst.mCode = OpCode::SPACE;
+                break;
+            default:
+                // %C, %D and %x share century state with the outer format, %Z depends on tzname, %E and %O are
+                // alternative modifiers, and unknown conversions fail anyway.
+                return false;
+        }
+        if (subFormat != nullptr) {
+            // strptime_ns parses sub format recursively, which resets nanosecond
+            if (depth > 0) {
+                return false;
+            }
+            inst.mCode = OpCode::RESET_NANOSECOND;
+            mInstructions.push_back(inst);
+            if (!compile(subFormat, depth + 1)) {
+                return false;
+            }
+            continue;
+        }
+        mInstructions.push_back(inst);
+    }
+    return true;
+}
+
+const char* TimeFormatParser::Parse(const char* buf, size_t size, LogtailTime& ts, int& nanosecondLength) const {
+    if (!mCompiled) {
+        return Strptime(buf, mFormat.c_str(), &ts, nanosecondLength, mSpecifiedYear);
+    }
+    const char* end = buf + size;
+    if (mIsEpoch) {
+        return parseEpoch(buf, end, ts, nanosecondLength);
+    }
+
+    struct tm tm = {0};
+    tm.tm_year = kMinYear;
+    long nanosecond = 0;
+    bool splitYear = false;
+    const char* bp = buf;
+    for (const auto& inst : mInstructions) {
+        int i = 0;
+        switch (inst.mCode) {
+            case OpCode::LITERAL:
+                if (bp >= end || *bp != inst.mLiteral) {
+                    return nullptr;
+                }
+                ++bp;
+                break;
+            case OpCode::SPACE:
+                while (bp < end && IsSpace(*bp)) {
+                    ++bp;
+                }
+                break;
+            case OpCode::YEAR:
+                bp = ConvYear(bp, end, i);
+                tm.tm_year = i - kTmYearBase;
+                break;
+            case OpCode::SHORT_YEAR:
+                bp = ConvNum(bp, end, i, 0, 99);
+                if (splitYear) {
+                    // preserve century
+                    i += (tm.tm_year / 100) * 100;
+                } else {
+                    splitYear = true;
+                    i += i <= 68 ? 2000 - kTmYearBase : 1900 - kTmYearBase;
+                }
+                tm.tm_year = i;
+                break;
+            case OpCode::NUMBER:
+                bp = ConvNum(bp, end, i, inst.mLowerLimit, inst.mUpperLimit);
+                switch (inst.mField) {
+                    case Field::MON:
+                        tm.tm_mon = i - 1;
+                        break;
+                    case Field::MDAY:
+                        tm.tm_mday = i;
+                        break;
+                    case Field::HOUR:
+                        tm.tm_hour = i;
+                        break;
+                    case Field::MIN:
+                        tm.tm_min = i;
+                        break;
+                    case Field::SEC:
+                        tm.tm_sec = i;
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case OpCode::HOUR12:
+                bp = ConvNum(bp, end, tm.tm_hour, 1, 12);
+                if (tm.tm_hour == 12) {
+                    tm.tm_hour = 0;
+                }
+                break;
+            case OpCode::AM_PM:
+                bp = FindString(bp, end, i, kAmPm, nullptr, 2);
+                if (tm.tm_hour > 11) {
+                    return nullptr;
+                }
+                tm.tm_hour += i * 12;
+                break;
+            case OpCode::MONTH_NAME:
+                bp = FindString(bp, end, tm.tm_mon, kMonths, kAbMonths, 12);
+                break;
+            case OpCode::WEEKDAY_NAME:
+                bp = FindString(bp, end, i, kDays, kAbDays, 7);
+                break;
+            case OpCode::NANOSECOND:
+                bp = bp < end ? ParseNanosecond(bp, end - bp, nanosecond, nanosecondLength) : nullptr;
+                break;
+            case OpCode::RESET_NANOSECOND:
+                nanosecond = 0;
+                break;
+            case OpCode::ZONE:
+                bp = ConvZone(bp, end, tm);
+                break;
+        }
+        if (bp == nullptr) {
+            return nullptr;
+        }
+    }
+    ts.tv_nsec = nanosecond;
+
+    if (mSpecifiedYear < 0 || tm.tm_year != kMinYear) {
+        ts.tv_sec = MakeLocalTime(tm);
+        return bp;
+    }
+    if (mSpecifiedYear > 0) {
+        tm.tm_year = mSpecifiedYear - kTmYearBase;
+        ts.tv_sec = MakeLocalTime(tm);
+        return bp;
+    }
+    tm.tm_year = 0;
+    struct tm currentTm;
+    if (!GetCurrentLocalTime(currentTm)) {
+        return bp;
+    }
+    auto deduction = DeduceYear(&tm, &currentTm);
+    if (deduction != -1) {
+        tm.tm_year = deduction;
+    }
+    ts.tv_sec = MakeLocalTime(tm);
+    return bp;
+}
+
+const char* TimeFormatParser::parseEpoch(const char* buf,
+                                         const char* end,
+                                         LogtailTime& ts,
+                                         int& nanosecondLength) const {
+    // strptime_ns locates the fraction by the printed length of the value, so signs, spaces and leading zeros
+    // are left to it, as well as values that may overflow.
+    size_t digits = 0;
+    if (buf < end && *buf >= '1' && *buf <= '9') {
+#ifdef TIME_FORMAT_PARSER_SWAR
+        if (end - buf >= 8) {
+            digits = CountDigits8(buf);
+        }
+#endif
+        while (buf + digits < end && digits < 19 && IsDigit(buf[digits])) {
+            ++digits;
+        }
+    }
+    if (digits == 0 || digits >= 19) {
+        return Strptime(buf, mFormat.c_str(), &ts, nanosecondLength, mSpecifiedYear);
+    }
+    size_t secondLength = digits < kEpochSecondLength ? digits : kEpochSecondLength;
+    time_t second = 0;
+#ifdef TIME_FORMAT_PARSER_SWAR
+    if (end - buf >= 16) {
+        if (secondLength > 8) {
+            second = static_cast<time_t>(ParseDigits8(buf, 8)) * kPow10[secondLength - 8]
+                + ParseDigits8(buf + 8, secondLength - 8);
+        } else {
+            second = ParseDigits8(buf, secondLength);
+        }
+    } else
+#endif
+    {
+        for (size_t i = 0; i < secondLength; ++i) {
+            second = second * 10 + (buf[i] - '0');
+        }
+    }
+    ts.tv_sec = second;
+    ts.tv_nsec = 0;
+    nanosecondLength = 0;
+    if (digits > secondLength) {
+        ParseNanosecond(buf + secondLength, digits - secondLength, ts.tv_nsec, nanosecondLength);
+    }
+    return buf + digits;
+}
+
+} // namespace logtail
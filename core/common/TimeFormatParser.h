@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+
+namespace logtail {
+
+// TimeFormatParser parses time strings of one format, with the same result as Strptime.
+//
+// The format is compiled once into a sequence of instructions, so that it is not interpreted again for each log.
+// Digits of fixed-width fields (%Y, %f, epoch seconds) are converted several bytes at a time, and the local time of
+// midnight is cached per day, so mktime is only called when a new day is seen.
+// Formats containing conversions that are not compiled (e.g. %Z, %C, %D, alternative modifiers) fall back to
+// Strptime.
+class TimeFormatParser {
+public:
+    // Init compiles @format. @specifiedYear is the same as the one of Strptime.
+    void Init(const std::string& format, int32_t specifiedYear = -1);
+
+    // Parse parses the beginning of [@buf, @buf + @size) as Strptime(@buf, format, @ts, @nanosecondLength,
+    // specifiedYear) does. @nanosecondLength is only set when %f is parsed.
+    // @return the position where parsing ends, or NULL if parsing fails.
+    const char* Parse(const char* buf, size_t size, LogtailTime& ts, int& nanosecondLength) const;
+
+    const std::string& GetFormat() const { return mFormat; }
+    // IsCompiled returns false if Parse falls back to Strptime.
+    bool IsCompiled() const { return mCompiled; }
+    bool HasNanosecond() const { return mHasNanosecond; }
+    // EndsWithNanosecond is true if the format ends with %f, i.e. a time string is second prefix + nanosecond.
+    bool EndsWithNanosecond() const { return mEndsWithNanosecond; }
+    bool IsEpoch() const { return mIsEpoch; }
+
+private:
+    enum class OpCode : uint8_t {
+        LITERAL,
+        SPACE,
+        YEAR,
+        SHORT_YEAR,
+        NUMBER,
+        HOUR12,
+        AM_PM,
+        MONTH_NAME,
+        WEEKDAY_NAME,
+        NANOSECOND,
+        RESET_NANOSECOND,
+        ZONE,
+    };
+    // tm fields written by NUMBER
+    enum class Field : uint8_t { MON, MDAY, HOUR, MIN, SEC, WDAY, NONE };
+
+    struct Instruction {
+        OpCode mCode;
+        char mLiteral = 0;
+        Field mField = Field::NONE;
+        uint16_t mLowerLimit = 0;
+        uint16_t mUpperLimit = 0;
+    };
+
+    bool compile(const char* format, int depth);
+    const char* parseEpoch(const char* buf, const char* end, LogtailTime& ts, int& nanosecondLength) const;
+
+    std::string mFormat;
+    int32_t mSpecifiedYear = -1;
+    std::vector<Instruction> mInstructions;
+    bool mCompiled = false;
+    bool mIsEpoch = false;
+    bool mHasNanosecond = false;
+    bool mEndsWithNanosecond = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class TimeFormatParserUnittest;
+#endif
+};
+
+// ParseNanosecond parses the beginning of [@buf, @buf + @size) as Strptime(@buf, "%f", ...) does.
+// @return the position where parsing ends, or NULL if @buf does not start with a digit.
+const char* ParseNanosecond(const char* buf, size_t size, long& nanosecond, int& nanosecondLength);
+
+} // namespace logtail
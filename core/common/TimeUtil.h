@@ -74,6 +74,9 @@ inline void sleep(uint64_t s) {
 const char*
 Strptime(const char* buf, const char* fmt, LogtailTime* ts, int& nanosecondLength, int32_t specifiedYear = -1);
 
+// DeduceYear deduces year for @tm according to current date (@currentTm), used by Strptime when @specifiedYear is 0.
+int DeduceYear(const struct tm* tm, const struct tm* currentTm);
+
 int32_t GetSystemBootTime();
 
 // For feature enable_log_time_auto_adjust.
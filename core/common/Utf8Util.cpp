@@ -0,0 +1,361 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/Utf8Util.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LOGTAIL_UTF8_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace logtail {
+
+static inline bool IsContinuation(uint8_t c) {
+    return (c & 0xC0) == 0x80;
+}
+
+// SequenceLength returns the length of the valid sequence starting at @p, or 0 if it is invalid.
+static inline size_t SequenceLength(const uint8_t* p, const uint8_t* end) {
+    const uint8_t c = p[0];
+    size_t len = 0;
+    uint8_t lo = 0x80, hi = 0xBF;
+    if (c < 0x80) {
+        return 1;
+    } else if (c < 0xC2) { // continuation, or overlong 2 bytes
+        return 0;
+    } else if (c < 0xE0) {
+        len = 2;
+    } else if (c < 0xF0) {
+        len = 3;
+        if (c == 0xE0) { // overlong
+            lo = 0xA0;
+        }
+    } else if (c < 0xF5) {
+        len = 4;
+        if (c == 0xF0) { // overlong
+            lo = 0x90;
+        } else if (c == 0xF4) { // > U+10FFFF
+            hi = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+    if (static_cast<size_t>(end - p) < len || p[1] < lo || p[1] > hi) {
+        return 0;
+    }
+    for (size_t i = 2; i < len; ++i) {
+        if (!IsContinuation(p[i])) {
+            return 0;
+        }
+    }
+    return len;
+}
+
+// FindFirstInvalidScalar scans from @pos, which must be a character boundary.
+static size_t FindFirstInvalidScalar(const uint8_t* data, size_t size, size_t pos) {
+    const uint8_t* p = data + pos;
+    const uint8_t* end = data + size;
+    while (p < end) {
+        if (*p < 0x80) {
+            // skip ascii 8 bytes at a time
+            uint64_t v = 0;
+            while (end - p >= 8 && (memcpy(&v, p, 8), (v & 0x8080808080808080ULL) == 0)) {
+                p += 8;
+            }
+            while (p < end && *p < 0x80) {
+                ++p;
+            }
+            continue;
+        }
+        size_t len = SequenceLength(p, end);
+        if (len == 0) {
+            return p - data;
+        }
+        p += len;
+    }
+    return size;
+}
+
+#ifdef LOGTAIL_UTF8_SIMD
+// Error bits of the lookup tables. Each table maps a nibble to the errors it may be part of, and a pair of
+// bytes is invalid if the high and low nibble of the first byte and the high nibble of the second byte agree
+// on any error. SURROGATE of the original algorithm is left out, see header.
+static const uint8_t TOO_SHORT = 1 << 0; // lead byte not followed by continuation
+static const uint8_t TOO_LONG = 1 << 1; // ascii followed by continuation
+static const uint8_t OVERLONG_3 = 1 << 2;
+static const uint8_t TOO_LARGE = 1 << 3;
+static const uint8_t OVERLONG_2 = 1 << 5;
+static const uint8_t TOO_LARGE_1000 = 1 << 6;
+static const uint8_t OVERLONG_4 = 1 << 6;
+static const uint8_t TWO_CONTS = 1 << 7; // continuation not preceded by lead byte, checked with prev2 and prev3
+static const uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+alignas(16) static const uint8_t kByte1High[16] = {
+    // 0_______ ascii
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    // 10______ continuation
+    TWO_CONTS,
+    TWO_CONTS,
+    TWO_CONTS,
+    TWO_CONTS,
+    // 1100____
+    TOO_SHORT | OVERLONG_2,
+    // 1101____
+    TOO_SHORT,
+    // 1110____
+    TOO_SHORT | OVERLONG_3,
+    // 1111____
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+
+alignas(16) static const uint8_t kByte1Low[16] = {
+    // ____0000
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    // ____0001
+    CARRY | OVERLONG_2,
+    // ____001_
+    CARRY,
+    CARRY,
+    // ____0100
+    CARRY | TOO_LARGE,
+    // ____0101 - ____1111
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+
+alignas(16) static const uint8_t kByte2High[16] = {
+    // 0_______ ascii
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    // 1000____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    // 1001____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    // 101_____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | TOO_LARGE,
+    // 11______ lead byte
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+};
+
+// the last 3 bytes of a block must not be a lead byte whose sequence needs more bytes
+alignas(32) static const uint8_t kIncompleteMax[32]
+    = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+       0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF};
+
+// CharacterStart returns the start of the character containing byte @pos - 1, given [0, @pos) is valid except
+// that the last character may be truncated, so that scalar validation can resume from there.
+static inline size_t CharacterStart(const uint8_t* data, size_t pos) {
+    if (pos == 0) {
+        return 0;
+    }
+    size_t start = pos - 1;
+    while (start > 0 && pos - 1 - start < 3 && IsContinuation(data[start])) {
+        --start;
+    }
+    return start;
+}
+
+__attribute__((target("sse4.1"))) static size_t FindFirstInvalidSse4(const uint8_t* data, size_t size) {
+    const __m128i byte1High = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High));
+    const __m128i byte1Low = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low));
+    const __m128i byte2High = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High));
+    const __m128i incompleteMax = _mm_load_si128(reinterpret_cast<const __m128i*>(kIncompleteMax + 16));
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i thirdByteMin = _mm_set1_epi8(static_cast<char>(0xE0 - 0x80));
+    const __m128i fourthByteMin = _mm_set1_epi8(static_cast<char>(0xF0 - 0x80));
+    const __m128i highBit = _mm_set1_epi8(static_cast<char>(0x80));
+
+    __m128i prevInput = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+    size_t pos = 0;
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        if (_mm_movemask_epi8(input) == 0) {
+            if (!_mm_testz_si128(prevIncomplete, prevIncomplete)) {
+                break;
+            }
+        } else {
+            const __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+            const __m128i special = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibbleMask)),
+                    _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibbleMask))),
+                _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask)));
+            const __m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+            const __m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+            const __m128i mustBeContinuation = _mm_and_si128(
+                _mm_or_si128(_mm_subs_epu8(prev2, thirdByteMin), _mm_subs_epu8(prev3, fourthByteMin)), highBit);
+            const __m128i error = _mm_xor_si128(mustBeContinuation, special);
+            if (!_mm_testz_si128(error, error)) {
+                break;
+            }
+        }
+        prevIncomplete = _mm_subs_epu8(input, incompleteMax);
+        prevInput = input;
+    }
+    return FindFirstInvalidScalar(data, size, CharacterStart(data, pos));
+}
+
+__attribute__((target("avx2"))) static size_t FindFirstInvalidAvx2(const uint8_t* data, size_t size) {
+    const __m256i byte1High
+        = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High)));
+    const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low)));
+    const __m256i byte2High
+        = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High)));
+    const __m256i incompleteMax = _mm256_load_si256(reinterpret_cast<const __m256i*>(kIncompleteMax));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i thirdByteMin = _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80));
+    const __m256i fourthByteMin = _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80));
+    const __m256i highBit = _mm256_set1_epi8(static_cast<char>(0x80));
+
+    __m256i prevInput = _mm256_setzero_si256();
+    __m256i prevIncomplete = _mm256_setzero_si256();
+    size_t pos = 0;
+    for (; pos + 32 <= size; pos += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        if (_mm256_movemask_epi8(input) == 0) {
+            if (!_mm256_testz_si256(prevIncomplete, prevIncomplete)) {
+                break;
+            }
+        } else {
+            // [high lane of prevInput, low lane of input], to shift bytes across lanes
+            const __m256i shifted = _mm256_permute2x128_si256(prevInput, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            const __m256i special = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibbleMask)),
+                    _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibbleMask))),
+                _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask)));
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            const __m256i mustBeContinuation = _mm256_and_si256(
+                _mm256_or_si256(_mm256_subs_epu8(prev2, thirdByteMin), _mm256_subs_epu8(prev3, fourthByteMin)),
+                highBit);
+            const __m256i error = _mm256_xor_si256(mustBeContinuation, special);
+            if (!_mm256_testz_si256(error, error)) {
+                break;
+            }
+        }
+        prevIncomplete = _mm256_subs_epu8(input, incompleteMax);
+        prevInput = input;
+    }
+    return FindFirstInvalidScalar(data, size, CharacterStart(data, pos));
+}
+#endif
+
+Utf8SimdLevel GetUtf8SimdLevel() {
+#ifdef LOGTAIL_UTF8_SIMD
+    static const Utf8SimdLevel sLevel = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Utf8SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return Utf8SimdLevel::SSE4;
+        }
+        return Utf8SimdLevel::NONE;
+    }();
+    return sLevel;
+#else
+    return Utf8SimdLevel::NONE;
+#endif
+}
+
+size_t FindFirstInvalidUtf8(const char* data, size_t size) {
+    return FindFirstInvalidUtf8(data, size, GetUtf8SimdLevel());
+}
+
+size_t FindFirstInvalidUtf8(const char* data, size_t size, Utf8SimdLevel level) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+#ifdef LOGTAIL_UTF8_SIMD
+    switch (level) {
+        case Utf8SimdLevel::AVX2:
+            return FindFirstInvalidAvx2(bytes, size);
+        case Utf8SimdLevel::SSE4:
+            return FindFirstInvalidSse4(bytes, size);
+        default:
+            break;
+    }
+#endif
+    return FindFirstInvalidScalar(bytes, size, 0);
+}
+
+bool ReplaceInvalidUtf8(char* data, size_t size, size_t from, char replacement) {
+    bool replaced = false;
+    size_t pos = from;
+    while (pos < size) {
+        // the byte after a replaced one is treated as the start of a new character
+        pos += FindFirstInvalidUtf8(data + pos, size - pos);
+        if (pos >= size) {
+            break;
+        }
+        data[pos++] = replacement;
+        replaced = true;
+    }
+    return replaced;
+}
+
+size_t AlignUtf8Tail(const char* data, size_t size) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    // a character has at most 3 continuation bytes
+    for (size_t n = 1; n <= 4 && n <= size; ++n) {
+        const uint8_t c = bytes[size - n];
+        if (IsContinuation(c)) {
+            continue;
+        }
+        size_t len = 1;
+        if ((c & 0xE0) == 0xC0) {
+            len = 2;
+        } else if ((c & 0xF0) == 0xE0) {
+            len = 3;
+        } else if ((c & 0xF8) == 0xF0) {
+            len = 4;
+        }
+        return len > n ? size - n : size;
+    }
+    return size;
+}
+
+} // namespace logtail
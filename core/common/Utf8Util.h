@@ -0,0 +1,56 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace logtail {
+
+// UTF-8 validation shared by file readers and processors.
+//
+// A byte is valid if it starts a well-formed UTF-8 sequence (no overlong form, code point <= 0x10FFFF) that
+// fits in the buffer, or is a continuation byte of such a sequence. Surrogates (U+D800 - U+DFFF) encoded in 3
+// bytes are accepted, as logs written by Java (CESU-8) contain them and they were never replaced before.
+//
+// Validation runs on 32 bytes (AVX2) or 16 bytes (SSE4.1) at a time with the lookup-table algorithm of
+// Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte". The instruction set is selected
+// at runtime, and other platforms use the scalar implementation.
+
+enum class Utf8SimdLevel { NONE, SSE4, AVX2 };
+
+// GetUtf8SimdLevel returns the best implementation supported by running cpu.
+Utf8SimdLevel GetUtf8SimdLevel();
+
+// FindFirstInvalidUtf8 returns the offset of the first invalid byte, or @size if the whole buffer is valid.
+size_t FindFirstInvalidUtf8(const char* data, size_t size);
+// FindFirstInvalidUtf8 with a given implementation, @level must be supported by running cpu.
+size_t FindFirstInvalidUtf8(const char* data, size_t size, Utf8SimdLevel level);
+
+inline bool IsValidUtf8(const char* data, size_t size) {
+    return FindFirstInvalidUtf8(data, size) == size;
+}
+
+// ReplaceInvalidUtf8 replaces every invalid byte in [@from, @size) with @replacement in place.
+// @from must be a character boundary, e.g. the result of FindFirstInvalidUtf8, so that the valid prefix
+// is not scanned again.
+// @return true if any byte is replaced.
+bool ReplaceInvalidUtf8(char* data, size_t size, size_t from = 0, char replacement = ' ');
+
+// AlignUtf8Tail returns the size of @data without the last character if it is truncated.
+size_t AlignUtf8Tail(const char* data, size_t size);
+
+} // namespace logtail
@@ -30,6 +30,7 @@ struct HttpResponse {
     int32_t mStatusCode = 0; // 0 means no response from server
     std::map<std::string, std::string, decltype(compareHeader)*> mHeader;
     std::string mBody;
+    uint32_t mResponseTimeMs = 0; // time from sending the request to receiving the whole response
 
     HttpResponse(): mHeader(compareHeader) {}
 };
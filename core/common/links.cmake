@@ -18,6 +18,7 @@ macro(common_link target_name)
     link_jsoncpp(${target_name})
     link_yamlcpp(${target_name})
     link_boost(${target_name})
+    link_re2(${target_name})
     link_gflags(${target_name})
     link_lz4(${target_name})
     link_zlib(${target_name})
@@ -18,6 +18,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "models/StringView.h"
 
@@ -89,6 +90,19 @@ public:
 
     int64_t GetAllocatedSize() const { return mAllocated + mAllocatedChunks.size() * sizeof(void*); }
 
+    // Absorb takes over the memory allocated by @other, so that it lives as long as this allocator. @other can still
+    // be used to allocate new memory afterwards.
+    void Absorb(BufferAllocator& other) {
+        mAllocatedChunks.insert(mAllocatedChunks.end(), other.mAllocatedChunks.begin(), other.mAllocatedChunks.end());
+        mAllocated += other.mAllocated;
+        mUsed += other.mUsed;
+        other.mAllocatedChunks.clear();
+        other.mAllocPtr = nullptr;
+        other.mFreeBytesInChunk = 0;
+        other.mAllocated = 0;
+        other.mUsed = 0;
+    }
+
 private:
     // Please do not make it public, user should always use Allocate() to get a better performance.
     // If you have a strong reason to do it, please drop a email to me: shiquan.yangsq@aliyun-inc.com
@@ -167,6 +181,9 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    // Absorb keeps strings allocated by @other valid as long as this buffer.
+    void Absorb(SourceBuffer& other) { mAllocator.Absorb(other.mAllocator); }
+
 private:
     BufferAllocator mAllocator;
 
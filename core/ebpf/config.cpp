@@ -35,6 +35,10 @@ DEFINE_FLAG_INT32(ebpf_socket_probe_config_max_raw_record_per_sec, "ebpf socket
 DEFINE_FLAG_INT32(ebpf_profile_probe_config_profile_sample_rate, "ebpf profile probe profile sample rate", 10);
 DEFINE_FLAG_INT32(ebpf_profile_probe_config_profile_upload_duration, "ebpf profile probe profile upload duration", 10);
 DEFINE_FLAG_BOOL(ebpf_process_probe_config_enable_oom_detect, "if ebpf process probe enable oom detect", false);
+DEFINE_FLAG_INT32(ebpf_security_aggregation_window_ms, "ebpf security event aggregation window, 0 to disable", 0);
+DEFINE_FLAG_INT32(ebpf_security_aggregation_max_keys, "ebpf security event aggregation max keys in one window", 4096);
+DEFINE_FLAG_INT32(ebpf_security_max_pending_groups, "ebpf security max groups kept when process queue is full", 16);
+DEFINE_FLAG_INT32(ebpf_security_flush_interval_ms, "ebpf security interval of flushing aggregated events", 1000);
 
 namespace logtail {
 namespace ebpf {
@@ -507,6 +511,8 @@ void eBPFAdminConfig::LoadEbpfConfig(const Json::Value& confJson) {
     mProfileProbeConfig = ProfileProbeConfig{INT32_FLAG(ebpf_profile_probe_config_profile_sample_rate), INT32_FLAG(ebpf_profile_probe_config_profile_upload_duration)};
     // process_probe_config (Optional)
     mProcessProbeConfig = ProcessProbeConfig{BOOL_FLAG(ebpf_process_probe_config_enable_oom_detect)};
+    // security_aggregation_config (Optional)
+    mSecurityAggregationConfig = SecurityAggregationConfig{INT32_FLAG(ebpf_security_aggregation_window_ms), INT32_FLAG(ebpf_security_aggregation_max_keys), INT32_FLAG(ebpf_security_max_pending_groups), INT32_FLAG(ebpf_security_flush_interval_ms)};
 }
 
 } // ebpf
@@ -88,6 +88,17 @@ struct ProcessProbeConfig {
     bool mEnableOOMDetect;
 };
 
+struct SecurityAggregationConfig {
+    // events with the same call name, binary, arguments and container are merged within the window, 0 to disable
+    int32_t mAggWindowMs = 0;
+    // merged events are flushed earlier once this many distinct keys are held
+    int32_t mMaxAggKeys = 0;
+    // groups kept locally while the process queue is full, the oldest one is dropped beyond it
+    int32_t mMaxPendingGroups = 0;
+    // interval of flushing expired windows and refused groups when no event comes
+    int32_t mFlushIntervalMs = 1000;
+};
+
 class eBPFAdminConfig {
 public:
     eBPFAdminConfig() {}
@@ -111,6 +122,8 @@ public:
 
     const ProcessProbeConfig& GetProcessProbeConfig() const { return mProcessProbeConfig; }
 
+    const SecurityAggregationConfig& GetSecurityAggregationConfig() const { return mSecurityAggregationConfig; }
+
 private:
     int32_t mReceiveEventChanCap;
     AdminConfig mAdminConfig;
@@ -126,6 +139,8 @@ private:
     ProfileProbeConfig mProfileProbeConfig;
 
     ProcessProbeConfig mProcessProbeConfig;
+
+    SecurityAggregationConfig mSecurityAggregationConfig;
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class eBPFServerUnittest;
 #endif
@@ -46,12 +46,61 @@ void eBPFServer::Init() {
     mSpanCB = std::make_unique<OtelSpanHandler>(nullptr, -1, 0);
 #endif
 
-    mNetworkSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0);
-    mProcessSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0);
-    mFileSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0);
+    const auto& securityAggConfig = mAdminConfig.GetSecurityAggregationConfig();
+    mNetworkSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0, securityAggConfig);
+    mProcessSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0, securityAggConfig);
+    mFileSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0, securityAggConfig);
+    {
+        std::lock_guard<std::mutex> lock(mSecurityFlushMux);
+        mSecurityFlushStopped = false;
+    }
+    mSecurityFlushRes = std::async(
+        std::launch::async, &eBPFServer::RunSecurityFlush, this, securityAggConfig.mFlushIntervalMs);
     mInited = true;
 }
 
+void eBPFServer::RunSecurityFlush(int32_t intervalMs) {
+    std::unique_lock<std::mutex> lock(mSecurityFlushMux);
+    while (!mSecurityFlushStopped) {
+        mSecurityFlushCV.wait_for(lock, std::chrono::milliseconds(intervalMs));
+        if (mSecurityFlushStopped) {
+            break;
+        }
+        lock.unlock();
+        mNetworkSecureCB->Flush();
+        mProcessSecureCB->Flush();
+        mFileSecureCB->Flush();
+        lock.lock();
+    }
+}
+
+void eBPFServer::StopSecurityFlush() {
+    {
+        std::lock_guard<std::mutex> lock(mSecurityFlushMux);
+        mSecurityFlushStopped = true;
+    }
+    mSecurityFlushCV.notify_all();
+    if (mSecurityFlushRes.valid()) {
+        mSecurityFlushRes.get();
+    }
+}
+
+void eBPFServer::FlushSecurityCB(nami::PluginType type) {
+    switch (type) {
+    case nami::PluginType::PROCESS_SECURITY:
+        if (mProcessSecureCB) mProcessSecureCB->Flush(true);
+        return;
+    case nami::PluginType::NETWORK_SECURITY:
+        if (mNetworkSecureCB) mNetworkSecureCB->Flush(true);
+        return;
+    case nami::PluginType::FILE_SECURITY:
+        if (mFileSecureCB) mFileSecureCB->Flush(true);
+        return;
+    default:
+        return;
+    }
+}
+
 void eBPFServer::Stop() {
     if (!mInited) return;
     mInited = false;
@@ -59,6 +108,11 @@ void eBPFServer::Stop() {
     mSourceManager->StopAll();
     // destroy source manager 
     mSourceManager.reset();
+    StopSecurityFlush();
+    // no callback any more, push what security handlers hold before the contexts are reset
+    FlushSecurityCB(nami::PluginType::NETWORK_SECURITY);
+    FlushSecurityCB(nami::PluginType::PROCESS_SECURITY);
+    FlushSecurityCB(nami::PluginType::FILE_SECURITY);
     for (std::size_t i = 0; i < mLoadedPipeline.size(); i ++) {
         UpdatePipelineName(static_cast<nami::PluginType>(i), "");
     }
@@ -182,7 +236,10 @@ bool eBPFServer::DisablePlugin(const std::string& pipeline_name, nami::PluginTyp
     }
     bool ret = mSourceManager->StopPlugin(type);
     // UpdateContext must after than StopPlugin
-    if (ret) UpdateCBContext(type, nullptr, -1, -1);
+    if (ret) {
+        FlushSecurityCB(type);
+        UpdateCBContext(type, nullptr, -1, -1);
+    }
     return ret;
 }
 
@@ -200,7 +257,10 @@ void eBPFServer::UpdatePipelineName(nami::PluginType type, const std::string& na
 bool eBPFServer::SuspendPlugin(const std::string& pipeline_name, nami::PluginType type) {
     // mark plugin status is update
     bool ret = mSourceManager->SuspendPlugin(type);
-    if (ret) UpdateCBContext(type, nullptr, -1, -1);
+    if (ret) {
+        FlushSecurityCB(type);
+        UpdateCBContext(type, nullptr, -1, -1);
+    }
     return ret;
 }
 
@@ -18,6 +18,8 @@
 #include <atomic>
 #include <map>
 #include <array>
+#include <condition_variable>
+#include <future>
 #include <memory>
 #include <mutex>
 
@@ -67,9 +69,13 @@ private:
                         const logtail::PipelineContext* ctx, 
                         const std::variant<SecurityOptions*, nami::ObserverNetworkOption*> options);
     eBPFServer() = default;
-    ~eBPFServer() = default;
+    ~eBPFServer() { StopSecurityFlush(); }
 
     void UpdateCBContext(nami::PluginType type, const logtail::PipelineContext* ctx, logtail::QueueKey key, int idx);
+    // security handlers hold events between callbacks, they are flushed periodically and before contexts are reset
+    void RunSecurityFlush(int32_t intervalMs);
+    void StopSecurityFlush();
+    void FlushSecurityCB(nami::PluginType type);
 
     std::unique_ptr<SourceManager> mSourceManager;
     // source manager
@@ -86,6 +92,11 @@ private:
     eBPFAdminConfig mAdminConfig;
     volatile bool mInited = false;
 
+    std::future<void> mSecurityFlushRes;
+    std::mutex mSecurityFlushMux;
+    std::condition_variable mSecurityFlushCV;
+    bool mSecurityFlushStopped = false;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class eBPFServerUnittest;
 #endif
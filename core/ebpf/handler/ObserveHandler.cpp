@@ -30,45 +30,83 @@
 namespace logtail {
 namespace ebpf {
 
+using MeasureTags = std::map<std::string, std::string>;
+using TagViews = std::vector<std::pair<StringView, StringView>>;
+
+// Copies the tags of a measure or a span into the source buffer of the group once, the views are shared by all the
+// events converted from it. Measures and spans of one service come in a row with mostly the same workload tags, so a
+// tag equal to the one at the same position of the previous measure reuses its copy instead.
+static void CopyTags(SourceBuffer* sourceBuffer, const MeasureTags& tags, const MeasureTags* prevTags, TagViews& views) {
+    size_t i = 0;
+    auto prevIt = prevTags ? prevTags->begin() : tags.end();
+    for (const auto& tag : tags) {
+        bool samePrevKey = prevTags && prevIt != prevTags->end() && i < views.size() && prevIt->first == tag.first;
+        if (!samePrevKey) {
+            StringBuffer key = sourceBuffer->CopyString(tag.first);
+            StringBuffer value = sourceBuffer->CopyString(tag.second);
+            if (i < views.size()) {
+                views[i] = {StringView(key.data, key.size), StringView(value.data, value.size)};
+            } else {
+                views.emplace_back(StringView(key.data, key.size), StringView(value.data, value.size));
+            }
+        } else if (prevIt->second != tag.second) {
+            StringBuffer value = sourceBuffer->CopyString(tag.second);
+            views[i].second = StringView(value.data, value.size);
+        }
+        if (prevTags && prevIt != prevTags->end()) {
+            ++prevIt;
+        }
+        ++i;
+    }
+    views.resize(i);
+}
+
+template <typename Event>
+static void SetTags(Event* event, const TagViews& tags) {
+    for (const auto& tag : tags) {
+        event->SetTagNoCopy(tag.first, tag.second);
+    }
+}
+
 #define ADD_STATUS_METRICS(METRIC_NAME, FIELD_NAME, VALUE) \
     {if (!inner->FIELD_NAME) return; \
     auto event = group.AddMetricEvent(); \
-    for (auto& tag : measure->tags_) { \
-        event->SetTag(tag.first, tag.second); \
-    } \
-    event->SetTag(std::string("status_code"), std::string(VALUE)); \
-    event->SetName(METRIC_NAME); \
+    SetTags(event, tags); \
+    event->SetTagNoCopy(status_code_key, VALUE); \
+    event->SetNameNoCopy(METRIC_NAME); \
     event->SetTimestamp(ts); \
     event->SetValue(UntypedSingleValue{(double)inner->FIELD_NAME});} \
 
 #define GENERATE_METRICS(FUNC_NAME, MEASURE_TYPE, INNER_TYPE, METRIC_NAME, FIELD_NAME) \
-void FUNC_NAME(PipelineEventGroup& group, std::unique_ptr<Measure>& measure, uint64_t ts) { \
+void FUNC_NAME(PipelineEventGroup& group, const TagViews& tags, std::unique_ptr<Measure>& measure, uint64_t ts) { \
     if (measure->type_ != MEASURE_TYPE) return; \
     auto inner = static_cast<INNER_TYPE*>(measure->inner_measure_.get()); \
     if (!inner->FIELD_NAME) return; \
     auto event = group.AddMetricEvent(); \
-    for (auto& tag : measure->tags_) { \
-        event->SetTag(tag.first, tag.second); \
-    } \
-    event->SetName(METRIC_NAME); \
+    SetTags(event, tags); \
+    event->SetNameNoCopy(METRIC_NAME); \
     event->SetTimestamp(ts); \
     event->SetValue(UntypedSingleValue{(double)inner->FIELD_NAME}); \
 }
 
+static const std::string service_requests_total = "service_requests_total";
+
 void OtelMeterHandler::handle(std::vector<std::unique_ptr<ApplicationBatchMeasure>>&& measures, uint64_t timestamp) {
     if (measures.empty()) return;
 
     for (auto& appBatchMeasures : measures) {
         PipelineEventGroup eventGroup(std::make_shared<SourceBuffer>());
+        eventGroup.MutableEvents().reserve(appBatchMeasures->measures_.size());
+        const MeasureTags* prevTags = nullptr;
         for (auto& measure : appBatchMeasures->measures_) {
             auto type = measure->type_;
             if (type == MeasureType::MEASURE_TYPE_APP) {
                 auto inner = static_cast<AppSingleMeasure*>(measure->inner_measure_.get());
                 auto event = eventGroup.AddMetricEvent();
-                for (auto& tag : measure->tags_) {
-                    event->SetTag(tag.first, tag.second);
-                }
-                event->SetName("service_requests_total");
+                CopyTags(eventGroup.GetSourceBuffer().get(), measure->tags_, prevTags, mTags);
+                prevTags = &measure->tags_;
+                SetTags(event, mTags);
+                event->SetNameNoCopy(service_requests_total);
                 event->SetTimestamp(timestamp);
                 event->SetValue(UntypedSingleValue{(double)inner->request_total_});
             }
@@ -92,11 +130,13 @@ void OtelSpanHandler::handle(std::vector<std::unique_ptr<ApplicationBatchSpan>>&
     for (auto& span : spans) {
         std::shared_ptr<SourceBuffer> sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
+        eventGroup.MutableEvents().reserve(span->single_spans_.size());
+        const MeasureTags* prevTags = nullptr;
         for (auto& x : span->single_spans_) {
             auto spanEvent = eventGroup.AddSpanEvent();
-            for (auto& tag : x->tags_) {
-                spanEvent->SetTag(tag.first, tag.second);
-            }
+            CopyTags(sourceBuffer.get(), x->tags_, prevTags, mTags);
+            prevTags = &x->tags_;
+            SetTags(spanEvent, mTags);
             spanEvent->SetName(x->span_name_);
             spanEvent->SetKind(static_cast<SpanEvent::Kind>(x->span_kind_));
             spanEvent->SetStartTimeNs(x->start_timestamp_);
@@ -162,6 +202,7 @@ static const std::string status_2xx_key = "2xx";
 static const std::string status_3xx_key = "2xx";
 static const std::string status_4xx_key = "2xx";
 static const std::string status_5xx_key = "2xx";
+static const std::string status_code_key = "status_code";
 
 // FOR APP METRICS
 GENERATE_METRICS(GenerateRequestsTotalMetrics, MeasureType::MEASURE_TYPE_APP, AppSingleMeasure, rpc_request_total_count, request_total_)
@@ -169,7 +210,7 @@ GENERATE_METRICS(GenerateRequestsSlowMetrics, MeasureType::MEASURE_TYPE_APP, App
 GENERATE_METRICS(GenerateRequestsErrorMetrics, MeasureType::MEASURE_TYPE_APP, AppSingleMeasure, rpc_request_err_count, error_total_)
 GENERATE_METRICS(GenerateRequestsDurationSumMetrics, MeasureType::MEASURE_TYPE_APP, AppSingleMeasure, rpc_request_status_count, duration_ms_sum_)
 
-void GenerateRequestsStatusMetrics(PipelineEventGroup& group, std::unique_ptr<Measure>& measure, uint64_t ts) {
+void GenerateRequestsStatusMetrics(PipelineEventGroup& group, const TagViews& tags, std::unique_ptr<Measure>& measure, uint64_t ts) {
     if (measure->type_ != MeasureType::MEASURE_TYPE_APP) return;
     auto inner = static_cast<AppSingleMeasure*>(measure->inner_measure_.get());
     ADD_STATUS_METRICS(rpc_request_status_count, status_2xx_count_, status_2xx_key);
@@ -202,11 +243,13 @@ void ArmsSpanHandler::handle(std::vector<std::unique_ptr<ApplicationBatchSpan>>&
         std::shared_ptr<SourceBuffer> sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
         eventGroup.SetTag(app_id_key, span->app_id_);
+        eventGroup.MutableEvents().reserve(span->single_spans_.size());
+        const MeasureTags* prevTags = nullptr;
         for (auto& x : span->single_spans_) {
             auto spanEvent = eventGroup.AddSpanEvent();
-            for (auto& tag : x->tags_) {
-                spanEvent->SetTag(tag.first, tag.second);
-            }
+            CopyTags(sourceBuffer.get(), x->tags_, prevTags, mTags);
+            prevTags = &x->tags_;
+            SetTags(spanEvent, mTags);
             spanEvent->SetName(x->span_name_);
             spanEvent->SetKind(static_cast<SpanEvent::Kind>(x->span_kind_));
             spanEvent->SetStartTimeNs(x->start_timestamp_);
@@ -237,23 +280,26 @@ void ArmsMeterHandler::handle(std::vector<std::unique_ptr<ApplicationBatchMeasur
         // source_ip
         eventGroup.SetTag(std::string(app_id_key), appBatchMeasures->app_id_);
         eventGroup.SetTag(std::string(ip_key), appBatchMeasures->ip_);
+        const MeasureTags* prevTags = nullptr;
         for (auto& measure : appBatchMeasures->measures_) {
             auto type = measure->type_;
+            CopyTags(sourceBuffer.get(), measure->tags_, prevTags, mTags);
+            prevTags = &measure->tags_;
             if (type == MeasureType::MEASURE_TYPE_APP) {
-                GenerateRequestsTotalMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsSlowMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsErrorMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsDurationSumMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsStatusMetrics(eventGroup, measure, timestamp);
+                GenerateRequestsTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateRequestsSlowMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateRequestsErrorMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateRequestsDurationSumMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateRequestsStatusMetrics(eventGroup, mTags, measure, timestamp);
                 
             } else if (type == MeasureType::MEASURE_TYPE_NET) {
-                GenerateTcpDropTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpRetransTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpConnectionTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpRecvPktsTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpRecvBytesTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpSendPktsTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpSendBytesTotalMetrics(eventGroup, measure, timestamp);
+                GenerateTcpDropTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateTcpRetransTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateTcpConnectionTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateTcpRecvPktsTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateTcpRecvBytesTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateTcpSendPktsTotalMetrics(eventGroup, mTags, measure, timestamp);
+                GenerateTcpSendBytesTotalMetrics(eventGroup, mTags, measure, timestamp);
             }
             mProcessTotalCnt++;
         }
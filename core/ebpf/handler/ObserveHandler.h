@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "ebpf/handler/AbstractHandler.h"
 #include "ebpf/include/export.h"
+#include "models/StringView.h"
 
 namespace logtail {
 namespace ebpf {
@@ -27,6 +29,10 @@ public:
     MeterHandler(const logtail::PipelineContext* ctx, QueueKey key, uint32_t idx) : AbstractHandler(ctx, key, idx) {}
 
     virtual void handle(std::vector<std::unique_ptr<ApplicationBatchMeasure>>&&, uint64_t) = 0;
+
+protected:
+    // tag views of the current measure, reused across batches since handle is only called by the probe thread
+    std::vector<std::pair<StringView, StringView>> mTags;
 };
 
 class OtelMeterHandler : public MeterHandler {
@@ -39,6 +45,10 @@ class SpanHandler : public AbstractHandler {
 public:
     SpanHandler(const logtail::PipelineContext* ctx, QueueKey key, uint32_t idx) : AbstractHandler(ctx, key, idx) {}
     virtual void handle(std::vector<std::unique_ptr<ApplicationBatchSpan>>&&) = 0;
+
+protected:
+    // tag views of the current span, reused across batches since handle is only called by the probe thread
+    std::vector<std::pair<StringView, StringView>> mTags;
 };
 
 class OtelSpanHandler : public SpanHandler {
@@ -13,14 +13,19 @@
 // limitations under the License.
 
 #include "ebpf/handler/SecurityHandler.h"
+
+#include <string_view>
+
 #include "logger/Logger.h"
 #include "pipeline/PipelineContext.h"
+#include "common/HashUtil.h"
 #include "common/RuntimeUtil.h"
+#include "common/StringTools.h"
+#include "common/TimeUtil.h"
 #include "ebpf/SourceManager.h"
 #include "models/SpanEvent.h"
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEvent.h"
-#include "logger/Logger.h"
 #include "pipeline/queue/ProcessQueueManager.h"
 #include "pipeline/queue/ProcessQueueItem.h"
 #include "common/MachineInfoUtil.h"
@@ -28,18 +33,172 @@
 namespace logtail {
 namespace ebpf {
 
-SecurityHandler::SecurityHandler(const logtail::PipelineContext* ctx, logtail::QueueKey key, uint32_t idx) 
-    : AbstractHandler(ctx, key, idx) {
+// tags identifying a security event within the aggregation window, the first one is required
+static const std::array<std::string, 4> kAggKeyTags = {"call_name", "binary", "arguments", "container.id"};
+// container metadata repeated by most events of a group, stored once in the group's source buffer
+static const std::array<StringView, 3> kMetaTagPrefixes = {"container.", "k8s.", "workload."};
+
+static const std::string kEventCountKey = "event_count";
+static const std::string kLastTimeKey = "last_time";
+
+struct StringViewHash {
+    size_t operator()(StringView s) const { return std::hash<std::string_view>()(std::string_view(s.data(), s.size())); }
+};
+
+static bool IsMetaTag(const std::string& key) {
+    for (const auto& prefix : kMetaTagPrefixes) {
+        if (StartWith(key, prefix)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SecurityHandler::SecurityHandler(const logtail::PipelineContext* ctx,
+                                 logtail::QueueKey key,
+                                 uint32_t idx,
+                                 const SecurityAggregationConfig& aggConfig)
+    : AbstractHandler(ctx, key, idx), mAggConfig(aggConfig) {
     mHostName = GetHostName();
     mHostIp = GetHostIp();
 }
 
+SecurityHandler::~SecurityHandler() {
+    // the server flushes before the context is reset, anything left here cannot be pushed anymore
+    size_t dropCnt = 0;
+    for (const auto& x : mAggregatedEvents) {
+        dropCnt += x.mCount;
+    }
+    for (const auto& item : mPendingItems) {
+        dropCnt += item->mEventGroup.GetEvents().size();
+    }
+    if (dropCnt > 0) {
+        LOG_WARNING(sLogger, ("pluginIdx", mPluginIdx)("handler destroyed, drop events", dropCnt));
+    }
+}
+
 void SecurityHandler::handle(std::vector<std::unique_ptr<AbstractSecurityEvent>>&& events) {
     if (events.empty()) {
         return ;
     }
 
-    std::shared_ptr<SourceBuffer> source_buffer = std::make_shared<SourceBuffer>();;
+    std::lock_guard<std::mutex> lock(mMux);
+    mProcessTotalCnt+= events.size();
+    PushPendingItems();
+
+    std::vector<AggregatedEvent> output;
+    if (mAggConfig.mAggWindowMs <= 0) {
+        output.reserve(events.size());
+        for (auto& x : events) {
+            uint64_t ts = x->GetTimestamp();
+            output.push_back(AggregatedEvent{std::move(x), AggKey(), ts, 1});
+        }
+    } else {
+        uint64_t nowMs = GetCurrentTimeInMilliSeconds();
+        if (mAggregatedEvents.empty()) {
+            mWindowStartMs = nowMs;
+        }
+        for (auto& x : events) {
+            if (!Aggregate(x)) {
+                uint64_t ts = x->GetTimestamp();
+                output.push_back(AggregatedEvent{std::move(x), AggKey(), ts, 1});
+            }
+        }
+        TakeAggregatedEvents(nowMs, false, output);
+    }
+    if (output.empty()) {
+        return;
+    }
+    PushEventGroup(BuildEventGroup(output));
+}
+
+void SecurityHandler::Flush(bool force) {
+    std::lock_guard<std::mutex> lock(mMux);
+    PushPendingItems();
+    std::vector<AggregatedEvent> output;
+    TakeAggregatedEvents(GetCurrentTimeInMilliSeconds(), force, output);
+    if (output.empty()) {
+        return;
+    }
+    PushEventGroup(BuildEventGroup(output));
+}
+
+void SecurityHandler::UpdateContext(const logtail::PipelineContext* ctx, logtail::QueueKey key, uint32_t index) {
+    std::lock_guard<std::mutex> lock(mMux);
+    if (ctx == mCtx && key == mQueueKey && index == mPluginIdx) {
+        return;
+    }
+    std::vector<AggregatedEvent> output;
+    TakeAggregatedEvents(GetCurrentTimeInMilliSeconds(), true, output);
+    if (!output.empty()) {
+        PushEventGroup(BuildEventGroup(output));
+    }
+    PushPendingItems();
+    if (!mPendingItems.empty()) {
+        size_t dropCnt = 0;
+        for (const auto& item : mPendingItems) {
+            dropCnt += item->mEventGroup.GetEvents().size();
+        }
+        mPendingItems.clear();
+        mDropEventCnt += dropCnt;
+        LOG_WARNING(sLogger,
+                    ("configName", mCtx ? mCtx->GetConfigName() : "")("pluginIdx", mPluginIdx)(
+                        "context changed, drop events", dropCnt)("total dropped", mDropEventCnt));
+    }
+    AbstractHandler::UpdateContext(ctx, key, index);
+}
+
+void SecurityHandler::TakeAggregatedEvents(uint64_t nowMs, bool force, std::vector<AggregatedEvent>& output) {
+    if (mAggregatedEvents.empty()) {
+        return;
+    }
+    if (!force && nowMs - mWindowStartMs < static_cast<uint64_t>(mAggConfig.mAggWindowMs)
+        && mAggregatedEvents.size() < static_cast<size_t>(mAggConfig.mMaxAggKeys)) {
+        return;
+    }
+    for (auto& x : mAggregatedEvents) {
+        output.emplace_back(std::move(x));
+    }
+    mAggregatedEvents.clear();
+    mAggregatedIndex.clear();
+}
+
+bool SecurityHandler::Aggregate(std::unique_ptr<AbstractSecurityEvent>& event) {
+    AggKey key;
+    for (const auto& tag : event->GetAllTags()) {
+        for (size_t i = 0; i < kAggKeyTagCount; ++i) {
+            if (tag.first == kAggKeyTags[i]) {
+                key[i] = tag.second;
+                break;
+            }
+        }
+    }
+    if (key[0].empty()) {
+        return false;
+    }
+    size_t hash = static_cast<size_t>(event->GetEventType());
+    for (const auto& value : key) {
+        HashCombine(hash, StringViewHash()(value));
+    }
+
+    auto it = mAggregatedIndex.find(hash);
+    if (it == mAggregatedIndex.end()) {
+        mAggregatedIndex.emplace(hash, mAggregatedEvents.size());
+        uint64_t ts = event->GetTimestamp();
+        mAggregatedEvents.push_back(AggregatedEvent{std::move(event), key, ts, 1});
+        return true;
+    }
+    auto& item = mAggregatedEvents[it->second];
+    if (item.mFirst->GetEventType() != event->GetEventType() || item.mKey != key) {
+        return false;
+    }
+    ++item.mCount;
+    item.mLastTimestamp = std::max(item.mLastTimestamp, event->GetTimestamp());
+    return true;
+}
+
+PipelineEventGroup SecurityHandler::BuildEventGroup(std::vector<AggregatedEvent>& events) {
+    std::shared_ptr<SourceBuffer> source_buffer = std::make_shared<SourceBuffer>();
     PipelineEventGroup event_group(source_buffer);
     // aggregate to pipeline event group
     // set host ips
@@ -48,23 +207,70 @@ void SecurityHandler::handle(std::vector<std::unique_ptr<AbstractSecurityEvent>>
     const static std::string host_name_key = "host.name";
     event_group.SetTag(host_ip_key, mHostIp);
     event_group.SetTag(host_name_key, mHostName);
+
+    // tag keys and container metadata are copied into the source buffer once per group
+    std::unordered_map<StringView, StringView, StringViewHash> interned;
+    auto intern = [&](const std::string& s) {
+        auto it = interned.find(StringView(s));
+        if (it != interned.end()) {
+            return it->second;
+        }
+        StringBuffer sb = source_buffer->CopyString(s);
+        StringView view(sb.data, sb.size);
+        interned.emplace(view, view);
+        return view;
+    };
     for (auto& x : events) {
         auto event = event_group.AddLogEvent();
-        for (auto& tag : x->GetAllTags()) {
-            event->SetContent(tag.first, tag.second);
+        for (const auto& tag : x.mFirst->GetAllTags()) {
+            StringView key = intern(tag.first);
+            if (IsMetaTag(tag.first)) {
+                event->SetContentNoCopy(key, intern(tag.second));
+            } else {
+                StringBuffer value = source_buffer->CopyString(tag.second);
+                event->SetContentNoCopy(key, StringView(value.data, value.size));
+            }
         }
-        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::nanoseconds(x->GetTimestamp()));
-        event->SetTimestamp(seconds.count(), x->GetTimestamp());
+        if (x.mCount > 1) {
+            event->SetContent(kEventCountKey, ToString(x.mCount));
+            event->SetContent(kLastTimeKey, ToString(x.mLastTimestamp));
+        }
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::nanoseconds(x.mFirst->GetTimestamp()));
+        event->SetTimestamp(seconds.count(), x.mFirst->GetTimestamp());
     }
-    mProcessTotalCnt+= events.size();
-#ifdef APSARA_UNIT_TEST_MAIN
-    return;
-#endif
-    std::unique_ptr<ProcessQueueItem> item = 
-            std::unique_ptr<ProcessQueueItem>(new ProcessQueueItem(std::move(event_group), mPluginIdx));
-    
-    if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
-        LOG_WARNING(sLogger, ("configName", mCtx->GetConfigName())("pluginIdx",mPluginIdx)("Push queue failed!", events.size()));
+    return event_group;
+}
+
+void SecurityHandler::PushEventGroup(PipelineEventGroup&& group) {
+    std::unique_ptr<ProcessQueueItem> item
+        = std::unique_ptr<ProcessQueueItem>(new ProcessQueueItem(std::move(group), mPluginIdx));
+    // keep the order of groups, new ones wait behind the pending ones
+    if (mPendingItems.empty() && ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item)) == 0) {
+        return;
+    }
+    if (!item) {
+        return;
+    }
+    mPendingItems.emplace_back(std::move(item));
+    if (mPendingItems.size() > static_cast<size_t>(mAggConfig.mMaxPendingGroups)) {
+        size_t dropCnt = mPendingItems.front()->mEventGroup.GetEvents().size();
+        mPendingItems.pop_front();
+        mDropEventCnt += dropCnt;
+        LOG_WARNING(sLogger,
+                    ("configName", mCtx ? mCtx->GetConfigName() : "")("pluginIdx", mPluginIdx)(
+                        "Push queue failed, drop events", dropCnt)("total dropped", mDropEventCnt));
+    }
+}
+
+void SecurityHandler::PushPendingItems() {
+    while (!mPendingItems.empty()) {
+        if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(mPendingItems.front())) != 0) {
+            if (!mPendingItems.front()) {
+                mPendingItems.pop_front();
+            }
+            return;
+        }
+        mPendingItems.pop_front();
     }
 }
 
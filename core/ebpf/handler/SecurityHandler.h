@@ -14,23 +14,76 @@
 
 #pragma once
 
-#include <vector>
+#include <array>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "ebpf/config.h"
 #include "ebpf/handler/AbstractHandler.h"
 #include "ebpf/include/export.h"
+#include "models/PipelineEventGroup.h"
+#include "models/StringView.h"
+#include "pipeline/queue/ProcessQueueItem.h"
 
 namespace logtail {
 namespace ebpf {
 
 class SecurityHandler : public AbstractHandler {
 public:
-    SecurityHandler(const logtail::PipelineContext* ctx, logtail::QueueKey key, uint32_t idx);
+    SecurityHandler(const logtail::PipelineContext* ctx,
+                    logtail::QueueKey key,
+                    uint32_t idx,
+                    const SecurityAggregationConfig& aggConfig = SecurityAggregationConfig());
+    ~SecurityHandler();
     void handle(std::vector<std::unique_ptr<AbstractSecurityEvent>>&& events);
+    // handle is only called when events come, so the server calls Flush periodically to push the refused groups again
+    // and the merged events whose window has expired. All merged events are pushed if force is true.
+    void Flush(bool force = false);
+    // Hides AbstractHandler::UpdateContext. Groups built for the old context carry its plugin index, so they are
+    // pushed to the old queue (or dropped and counted) before the context is switched, under the same lock as Flush.
+    void UpdateContext(const logtail::PipelineContext* ctx, logtail::QueueKey key, uint32_t index);
+
 private:
+    // call name, binary, arguments, container id
+    static constexpr size_t kAggKeyTagCount = 4;
+    using AggKey = std::array<StringView, kAggKeyTagCount>;
+
+    // one output event: the first sample of its key, with the count and the time of the last one
+    struct AggregatedEvent {
+        std::unique_ptr<AbstractSecurityEvent> mFirst;
+        // views into the tags of mFirst
+        AggKey mKey;
+        uint64_t mLastTimestamp = 0;
+        uint32_t mCount = 1;
+    };
+
+    // return false if the event has no call name, or its key collides with another one in the window
+    bool Aggregate(std::unique_ptr<AbstractSecurityEvent>& event);
+    void TakeAggregatedEvents(uint64_t nowMs, bool force, std::vector<AggregatedEvent>& output);
+    PipelineEventGroup BuildEventGroup(std::vector<AggregatedEvent>& events);
+    void PushEventGroup(PipelineEventGroup&& group);
+    void PushPendingItems();
+
     // TODO 后续这两个 key 需要移到 group 的 metadata 里，在 processortagnative 中转成tag
     std::string mHostIp;
     std::string mHostName;
+
+    SecurityAggregationConfig mAggConfig;
+    // handle is called by the probe thread, while contexts are updated by the server
+    std::mutex mMux;
+    uint64_t mWindowStartMs = 0;
+    std::vector<AggregatedEvent> mAggregatedEvents;
+    std::unordered_map<size_t, size_t> mAggregatedIndex;
+    // groups that the process queue refused, pushed again before new ones
+    std::deque<std::unique_ptr<ProcessQueueItem>> mPendingItems;
+    uint64_t mDropEventCnt = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class eBPFServerUnittest;
+#endif
 };
 
 }
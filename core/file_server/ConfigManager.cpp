@@ -27,7 +27,9 @@
 #include <limits.h>
 #include <re2/re2.h>
 
+#include <algorithm>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -565,20 +567,16 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             }
         }
     }
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    FindCandidateConfigs(path, candidates);
     FileDiscoveryConfig prevMatch(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
+    for (const auto& candidate : candidates) {
+        const FileDiscoveryOptions* config = candidate.first;
 
         bool match = config->IsMatch(path, name);
         if (match) {
@@ -586,21 +584,21 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             if (!name.empty() && !config->mAllowingIncludedByMultiConfigs) {
                 nameRepeat++;
                 logNameList.append("logstore:");
-                logNameList.append(itr->second.second->GetLogstoreName());
+                logNameList.append(candidate.second->GetLogstoreName());
                 logNameList.append(",config:");
-                logNameList.append(itr->second.second->GetConfigName());
+                logNameList.append(candidate.second->GetConfigName());
                 logNameList.append(" ");
-                multiConfigs.push_back(itr->second);
+                multiConfigs.push_back(candidate);
             }
 
             // note: best config is the one which length is longest and create time is nearest
             curLen = config->GetBasePath().size();
             if (prevLen < curLen) {
-                prevMatch = itr->second;
+                prevMatch = candidate;
                 prevLen = curLen;
             } else if (prevLen == curLen && prevMatch.first) {
-                if (prevMatch.second->GetCreateTime() > itr->second.second->GetCreateTime()) {
-                    prevMatch = itr->second;
+                if (prevMatch.second->GetCreateTime() > candidate.second->GetCreateTime()) {
+                    prevMatch = candidate;
                     prevLen = curLen;
                 }
             }
@@ -654,18 +652,11 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
         }
     }
     bool alarmFlag = false;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
-        bool match = config->IsMatch(path, name);
-        if (match) {
-            allConfig.push_back(itr->second);
+    vector<FileDiscoveryConfig> candidates;
+    FindCandidateConfigs(path, candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, name)) {
+            allConfig.push_back(candidate);
         }
     }
 
@@ -702,21 +693,15 @@ int32_t ConfigManager::FindMatchWithForceFlag(std::vector<FileDiscoveryConfig>&
             }
         }
     }
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    FindCandidateConfigs(path, candidates);
     FileDiscoveryConfig prevMatch = make_pair(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        FileDiscoveryConfig config = itr->second;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
+    for (const auto& config : candidates) {
         bool match = config.first->IsMatch(path, name);
         if (match) {
             // if force multi config, do not send alarm
@@ -1072,6 +1057,65 @@ void ConfigManager::ClearFilePipelineMatchCache() {
     mCacheFileAllConfigMap.clear();
 }
 
+// GetConfigPathIndexKey returns the constant directory part of config's base path, files out of it never match.
+static bool GetConfigPathIndexKey(const FileDiscoveryOptions* config, string& key) {
+    if (config->IsContainerDiscoveryEnabled()) {
+        // base path is mapped to container paths, which are indexed by the config itself
+        return false;
+    }
+    const string& basePath = config->GetBasePath();
+    if (config->GetWildcardPaths().empty()) {
+        key = basePath;
+        return true;
+    }
+    // '[' is special to fnmatch as well, though ParseWildcardPath does not take it as wildcard
+    size_t pos = basePath.find_first_of("*?[");
+    pos = basePath.rfind(PATH_SEPARATOR[0], pos);
+    if (pos == string::npos) {
+        return false;
+    }
+    key = basePath.substr(0, pos);
+    return true;
+}
+
+void ConfigManager::RebuildConfigPathIndex() {
+    mConfigPathIndex.Clear();
+    mIndexedConfigs.clear();
+    mUnindexedConfigs.clear();
+    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
+    string key;
+    for (auto itr = nameConfigMap.begin(); itr != nameConfigMap.end(); ++itr) {
+        const size_t idx = mIndexedConfigs.size();
+        mIndexedConfigs.push_back(itr->second);
+        if (GetConfigPathIndexKey(itr->second.first, key)) {
+            mConfigPathIndex.Insert(key, idx);
+        } else {
+            mUnindexedConfigs.push_back(idx);
+        }
+    }
+    LOG_DEBUG(sLogger,
+              ("rebuild config path index, configs", mIndexedConfigs.size())("unindexed", mUnindexedConfigs.size()));
+}
+
+void ConfigManager::FindCandidateConfigs(const string& path, vector<FileDiscoveryConfig>& configs) {
+    vector<size_t> indexes;
+    lock_guard<mutex> lock(mConfigPathIndexMux);
+    const uint32_t version = FileServer::GetInstance()->GetFileDiscoveryConfigsVersion();
+    if (!mConfigPathIndexBuilt || mConfigPathIndexVersion != version) {
+        RebuildConfigPathIndex();
+        mConfigPathIndexVersion = version;
+        mConfigPathIndexBuilt = true;
+    }
+    indexes = mUnindexedConfigs;
+    mConfigPathIndex.ForEachPrefix(path, [&indexes](size_t idx) { indexes.push_back(idx); });
+    // keep the same order as GetAllFileDiscoveryConfigs, which decides the best match among equals
+    sort(indexes.begin(), indexes.end());
+    configs.reserve(indexes.size());
+    for (size_t idx : indexes) {
+        configs.push_back(mIndexedConfigs[idx]);
+    }
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void ConfigManager::CleanEnviroments() {
     for (std::unordered_map<std::string, EventHandler*>::iterator iter = mDirEventHandlerMap.begin();
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -26,6 +27,7 @@
 #include "container_manager/ConfigContainerInfoUpdateCmd.h"
 #include "file_server/event/Event.h"
 #include "file_server/FileDiscoveryOptions.h"
+#include "file_server/PathTrie.h"
 
 namespace logtail {
 
@@ -156,6 +158,14 @@ protected:
     SpinLock mCacheFileAllConfigMapLock;
     std::unordered_map<std::string, std::pair<std::vector<FileDiscoveryConfig>, int32_t>> mCacheFileAllConfigMap;
 
+    // index of file discovery configs by base path, rebuilt when configs in FileServer change
+    std::mutex mConfigPathIndexMux;
+    bool mConfigPathIndexBuilt = false;
+    uint32_t mConfigPathIndexVersion = 0;
+    PathTrie<size_t> mConfigPathIndex; // value is index in mIndexedConfigs
+    std::vector<FileDiscoveryConfig> mIndexedConfigs; // in the order of FileServer::GetAllFileDiscoveryConfigs
+    std::vector<size_t> mUnindexedConfigs;
+
     PTMutex mContainerInfoCmdLock;
     std::vector<ConfigContainerInfoUpdateCmd*> mContainerInfoCmdVec;
 
@@ -561,6 +571,10 @@ private:
                            const std::string& name,
                            std::vector<FileDiscoveryConfig>& allConfig,
                            int32_t maxMultiConfigSize);
+    // FindCandidateConfigs returns configs that may match @path: configs whose constant base dir is @path or an
+    // ancestor of it, plus configs that can not be indexed (e.g. container discovery). IsMatch is still needed.
+    void FindCandidateConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs);
+    void RebuildConfigPathIndex();
 
     // void MappingPluginConfig(const Json::Value& configValue, Config* config, Json::Value& pluginJson);
 
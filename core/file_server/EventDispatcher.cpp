@@ -886,6 +886,14 @@ bool EventDispatcher::IsRegistered(int wd, string& path) {
     }
 }
 
+std::shared_ptr<const std::string> EventDispatcher::GetRegisteredPath(int wd) {
+    MapType<int, DirInfo*>::Type::iterator itr = mWdDirInfoMap.find(wd);
+    if (itr == mWdDirInfoMap.end()) {
+        return nullptr;
+    }
+    return itr->second->mSharedPath;
+}
+
 void EventDispatcher::HandleTimeout() {
     // increment each watcher's timeout account, if bound meets,
     // call timeout handler
@@ -25,6 +25,7 @@
 #endif
 #include <stddef.h>
 #include <time.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -67,13 +68,24 @@ enum DirRegisterStatus { GET_REGISTER_STATUS_ERROR = 0, PATH_INODE_REGISTERED =
 
 struct DirInfo {
     std::string mPath;
+    // same as mPath, shared with inotify events of this dir to avoid copying
+    std::shared_ptr<const std::string> mSharedPath;
     uint64_t mInode;
     bool mIsSymbolicLink;
     EventHandler* mHandler;
 
-    DirInfo() : mPath(std::string()), mInode(0), mIsSymbolicLink(false), mHandler(NULL) {}
+    DirInfo()
+        : mPath(std::string()),
+          mSharedPath(std::make_shared<const std::string>()),
+          mInode(0),
+          mIsSymbolicLink(false),
+          mHandler(NULL) {}
     DirInfo(const std::string& path, uint64_t inode, bool isSymbolicLink, EventHandler* handler)
-        : mPath(path), mInode(inode), mIsSymbolicLink(isSymbolicLink), mHandler(handler) {}
+        : mPath(path),
+          mSharedPath(std::make_shared<const std::string>(path)),
+          mInode(inode),
+          mIsSymbolicLink(isSymbolicLink),
+          mHandler(handler) {}
 };
 
 class EventDispatcher {
@@ -200,6 +212,8 @@ public:
     std::vector<std::pair<std::string, EventHandler*> > FindAllSubDirAndHandler(const std::string& baseDir);
     void UnregisterAllDir(const std::string& basePath);
     bool IsRegistered(int wd, std::string& path);
+    // GetRegisteredPath returns the shared path of dir registered with @wd, or nullptr if not registered.
+    std::shared_ptr<const std::string> GetRegisteredPath(int wd);
     void CheckSymbolicLink();
 
     void DumpCheckPointPeriod(int32_t curTime);
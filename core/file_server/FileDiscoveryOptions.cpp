@@ -14,6 +14,7 @@
 
 #include "file_server/FileDiscoveryOptions.h"
 
+#include <algorithm>
 #include <filesystem>
 
 #if defined(__linux__)
@@ -511,7 +512,9 @@ bool FileDiscoveryOptions::IsMatch(const string& path, const string& name) const
         }
 
         // Normal base path.
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
+        vector<size_t> candidates;
+        FindContainerCandidates(path, candidates);
+        for (size_t i : candidates) {
             const string& containerBasePath = (*mContainerInfos)[i].mRealBaseDir;
             if (_IsPathMatched(containerBasePath, path, mMaxDirSearchDepth)) {
                 if (!mHasBlacklist) {
@@ -645,7 +648,9 @@ ContainerInfo* FileDiscoveryOptions::GetContainerPathByLogPath(const string& log
     if (!mContainerInfos) {
         return NULL;
     }
-    for (size_t i = 0; i < mContainerInfos->size(); ++i) {
+    vector<size_t> candidates;
+    FindContainerCandidates(logPath, candidates);
+    for (size_t i : candidates) {
         if (_IsSubPath((*mContainerInfos)[i].mRealBaseDir, logPath)) {
             return &(*mContainerInfos)[i];
         }
@@ -653,6 +658,39 @@ ContainerInfo* FileDiscoveryOptions::GetContainerPathByLogPath(const string& log
     return NULL;
 }
 
+void FileDiscoveryOptions::RebuildContainerPathIndex() {
+    mContainerPathIndex.Clear();
+    mContainerPositions.clear();
+    if (!mContainerInfos) {
+        return;
+    }
+    for (size_t i = 0; i < mContainerInfos->size(); ++i) {
+        IndexContainer(i);
+    }
+}
+
+void FileDiscoveryOptions::IndexContainer(size_t pos) {
+    const ContainerInfo& info = (*mContainerInfos)[pos];
+    mContainerPathIndex.Insert(info.mRealBaseDir, info.mID);
+    // the first container with the id wins, as the linear searches of the mutators do
+    mContainerPositions.emplace(info.mID, pos);
+}
+
+void FileDiscoveryOptions::FindContainerCandidates(const string& path, vector<size_t>& res) const {
+    if (!mContainerInfos) {
+        return;
+    }
+    mContainerPathIndex.ForEachPrefix(path, [this, &res](const string& id) {
+        auto iter = mContainerPositions.find(id);
+        if (iter != mContainerPositions.end()) {
+            res.push_back(iter->second);
+        }
+    });
+    // keep the order of mContainerInfos, the first matched container wins
+    sort(res.begin(), res.end());
+    res.erase(unique(res.begin(), res.end()), res.end());
+}
+
 bool FileDiscoveryOptions::IsSameContainerInfo(const Json::Value& paramsJSON, const PipelineContext* ctx) {
     if (!mEnableContainerDiscovery)
         return true;
@@ -725,12 +763,17 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
         for (size_t i = 0; i < mContainerInfos->size(); ++i) {
             if ((*mContainerInfos)[i].mID == containerInfo.mID) {
                 // update
+                if ((*mContainerInfos)[i].mRealBaseDir != containerInfo.mRealBaseDir) {
+                    mContainerPathIndex.Erase((*mContainerInfos)[i].mRealBaseDir, containerInfo.mID);
+                    mContainerPathIndex.Insert(containerInfo.mRealBaseDir, containerInfo.mID);
+                }
                 (*mContainerInfos)[i] = containerInfo;
                 return true;
             }
         }
         // add
         mContainerInfos->push_back(containerInfo);
+        IndexContainer(mContainerInfos->size() - 1);
         return true;
     }
 
@@ -744,11 +787,14 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
     }
     // if update all, clear and reset
     mContainerInfos->clear();
+    mContainerPathIndex.Clear();
+    mContainerPositions.clear();
     for (unordered_map<string, ContainerInfo>::iterator iter = allPathMap.begin(); iter != allPathMap.end(); ++iter) {
         if (!mDeduceAndSetContainerBaseDirFunc(iter->second, ctx, this)) {
             return false;
         }
         mContainerInfos->push_back(iter->second);
+        IndexContainer(mContainerInfos->size() - 1);
     }
     return true;
 }
@@ -763,9 +809,14 @@ bool FileDiscoveryOptions::DeleteContainerInfo(const Json::Value& paramsJSON) {
         LOG_ERROR(sLogger, ("invalid container info update param", errorMsg)("action", "ignore current cmd"));
         return false;
     }
-    for (vector<ContainerInfo>::iterator iter = mContainerInfos->begin(); iter != mContainerInfos->end(); ++iter) {
-        if (iter->mID == containerInfo.mID) {
-            mContainerInfos->erase(iter);
+    for (size_t i = 0; i < mContainerInfos->size(); ++i) {
+        if ((*mContainerInfos)[i].mID == containerInfo.mID) {
+            mContainerPathIndex.Erase((*mContainerInfos)[i].mRealBaseDir, containerInfo.mID);
+            mContainerPositions.erase(containerInfo.mID);
+            mContainerInfos->erase(mContainerInfos->begin() + i);
+            for (size_t j = i; j < mContainerInfos->size(); ++j) {
+                mContainerPositions[(*mContainerInfos)[j].mID] = j;
+            }
             break;
         }
     }
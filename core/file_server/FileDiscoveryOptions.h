@@ -21,10 +21,12 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "file_server/ContainerInfo.h"
+#include "file_server/PathTrie.h"
 #include "pipeline/PipelineContext.h"
 
 namespace logtail {
@@ -44,7 +46,10 @@ public:
     bool IsContainerDiscoveryEnabled() const { return mEnableContainerDiscovery; }
     void SetEnableContainerDiscoveryFlag(bool flag) { mEnableContainerDiscovery = true; }
     const std::shared_ptr<std::vector<ContainerInfo>>& GetContainerInfo() const { return mContainerInfos; }
-    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) { mContainerInfos = info; }
+    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) {
+        mContainerInfos = info;
+        RebuildContainerPathIndex();
+    }
     void SetDeduceAndSetContainerBaseDirFunc(bool (*f)(ContainerInfo&,
                                                        const PipelineContext*,
                                                        const FileDiscoveryOptions*)) {
@@ -78,6 +83,11 @@ private:
     bool IsObjectInBlacklist(const std::string& path, const std::string& name) const;
     bool IsFileNameInBlacklist(const std::string& fileName) const;
     bool IsWildcardPathMatch(const std::string& path, const std::string& name = "") const;
+    void RebuildContainerPathIndex();
+    void IndexContainer(size_t pos);
+    // FindContainerCandidates returns indexes of containers whose mRealBaseDir is path or an ancestor of path,
+    // in ascending order.
+    void FindContainerCandidates(const std::string& path, std::vector<size_t>& res) const;
 
     std::string mBasePath;
     std::string mFilePattern;
@@ -109,6 +119,11 @@ private:
 
     bool mEnableContainerDiscovery = false;
     std::shared_ptr<std::vector<ContainerInfo>> mContainerInfos; // must not be null if container discovery is enabled
+    // mRealBaseDir -> container id, and container id -> index in mContainerInfos. Both are rebuilt when
+    // mContainerInfos is set, and updated in place by the container info mutators. Ids are stable, so only the
+    // positions after a deleted container change.
+    PathTrie<std::string> mContainerPathIndex;
+    std::unordered_map<std::string, size_t> mContainerPositions;
     bool (*mDeduceAndSetContainerBaseDirFunc)(ContainerInfo& containerInfo,
                                               const PipelineContext*,
                                               const FileDiscoveryOptions*)
@@ -121,12 +121,14 @@ FileDiscoveryConfig FileServer::GetFileDiscoveryConfig(const string& name) const
 void FileServer::AddFileDiscoveryConfig(const string& name, FileDiscoveryOptions* opts, const PipelineContext* ctx) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    ++mFileDiscoveryConfigsVersion;
 }
 
 // 移除给定名称的文件发现配置
 void FileServer::RemoveFileDiscoveryConfig(const string& name) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    ++mFileDiscoveryConfigsVersion;
 }
 
 // 获取给定名称的文件读取器配置
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -49,6 +50,8 @@ public:
     }
     void AddFileDiscoveryConfig(const std::string& name, FileDiscoveryOptions* opts, const PipelineContext* ctx);
     void RemoveFileDiscoveryConfig(const std::string& name);
+    // changed whenever a file discovery config is added or removed
+    uint32_t GetFileDiscoveryConfigsVersion() const { return mFileDiscoveryConfigsVersion; }
 
     FileReaderConfig GetFileReaderConfig(const std::string& name) const;
     const std::unordered_map<std::string, FileReaderConfig>& GetAllFileReaderConfigs() const {
@@ -96,6 +99,7 @@ private:
     mutable ReadWriteLock mReadWriteLock;
 
     std::unordered_map<std::string, FileDiscoveryConfig> mPipelineNameFileDiscoveryConfigsMap;
+    std::atomic_uint32_t mFileDiscoveryConfigsVersion{0};
     std::unordered_map<std::string, FileReaderConfig> mPipelineNameFileReaderConfigsMap;
     std::unordered_map<std::string, MultilineConfig> mPipelineNameMultilineConfigsMap;
     std::unordered_map<std::string, std::shared_ptr<std::vector<ContainerInfo>>> mAllContainerInfoMap;
@@ -199,7 +199,7 @@ bool MultilineOptions::Init(const Json::Value& config, const PipelineContext& ct
     return true;
 }
 
-bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex>& reg) {
+bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<RegexMatcher>& reg) {
     string regexPattern = pattern;
     if (!regexPattern.empty() && EndWith(regexPattern, "$")) {
         regexPattern = regexPattern.substr(0, regexPattern.size() - 1);
@@ -211,7 +211,7 @@ bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex
         return true;
     }
     try {
-        reg.reset(new boost::regex(regexPattern));
+        reg.reset(new RegexMatcher(regexPattern));
     } catch (...) {
         return false;
     }
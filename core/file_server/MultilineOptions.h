@@ -21,7 +21,7 @@
 #include <string>
 #include <utility>
 
-#include "boost/regex.hpp"
+#include "common/RegexMatcher.h"
 #include "pipeline/PipelineContext.h"
 
 namespace logtail {
@@ -32,9 +32,9 @@ public:
     enum class UnmatchedContentTreatment { DISCARD, SINGLE_LINE };
 
     bool Init(const Json::Value& config, const PipelineContext& ctx, const std::string& pluginType);
-    const std::shared_ptr<boost::regex>& GetStartPatternReg() const { return mStartPatternRegPtr; }
-    const std::shared_ptr<boost::regex>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
-    const std::shared_ptr<boost::regex>& GetEndPatternReg() const { return mEndPatternRegPtr; }
+    const std::shared_ptr<RegexMatcher>& GetStartPatternReg() const { return mStartPatternRegPtr; }
+    const std::shared_ptr<RegexMatcher>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
+    const std::shared_ptr<RegexMatcher>& GetEndPatternReg() const { return mEndPatternRegPtr; }
     bool IsMultiline() const { return mIsMultiline; }
 
     Mode mMode = Mode::CUSTOM;
@@ -45,11 +45,11 @@ public:
     bool mIgnoringUnmatchWarning = false;
 
 private:
-    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg);
+    bool ParseRegex(const std::string& pattern, std::shared_ptr<RegexMatcher>& reg);
 
-    std::shared_ptr<boost::regex> mStartPatternRegPtr;
-    std::shared_ptr<boost::regex> mContinuePatternRegPtr;
-    std::shared_ptr<boost::regex> mEndPatternRegPtr;
+    std::shared_ptr<RegexMatcher> mStartPatternRegPtr;
+    std::shared_ptr<RegexMatcher> mContinuePatternRegPtr;
+    std::shared_ptr<RegexMatcher> mEndPatternRegPtr;
     bool mIsMultiline = false;
 };
 
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+
+namespace logtail {
+
+// PathTrie indexes values by directory path, split into components by PATH_SEPARATOR. It answers
+// "which values are registered on @path or any ancestor directory of @path" in O(path length),
+// instead of comparing @path with every registered path.
+//
+// Empty components are ignored, so "/a//b/" and "/a/b" are the same key, and the root path "/"
+// is an ancestor of every absolute path. Callers that need exact prefix semantics (e.g. _IsSubPath)
+// should verify the values found.
+//
+// It is NOT thread-safe.
+template <typename T>
+class PathTrie {
+public:
+    void Insert(const std::string& path, const T& value) {
+        Node* node = &mRoot;
+        size_t pos = 0, len = 0;
+        while (nextComponent(path, pos, len)) {
+            node = node->GetOrCreateChild(path.data() + pos, len);
+            pos += len;
+        }
+        node->mValues.push_back(value);
+        ++mSize;
+    }
+
+    // Erase removes one @value registered on @path.
+    // @return false if not found.
+    bool Erase(const std::string& path, const T& value) {
+        std::vector<std::pair<Node*, Node*>> route; // (parent, child)
+        Node* node = &mRoot;
+        size_t pos = 0, len = 0;
+        while (nextComponent(path, pos, len)) {
+            Node* child = node->FindChild(path.data() + pos, len);
+            if (child == nullptr) {
+                return false;
+            }
+            route.emplace_back(node, child);
+            node = child;
+            pos += len;
+        }
+        auto it = std::find(node->mValues.begin(), node->mValues.end(), value);
+        if (it == node->mValues.end()) {
+            return false;
+        }
+        node->mValues.erase(it);
+        --mSize;
+        // prune empty nodes, so that frequently coming and going container paths do not pile up
+        for (auto r = route.rbegin(); r != route.rend(); ++r) {
+            if (!r->second->mValues.empty() || !r->second->mChildren.empty()) {
+                break;
+            }
+            r->first->RemoveChild(r->second);
+        }
+        return true;
+    }
+
+    // ForEachPrefix calls @func with every value registered on @path or its ancestors, from the root
+    // down to @path. Values registered on the same path are visited in insertion order.
+    template <typename Func>
+    void ForEachPrefix(const std::string& path, Func&& func) const {
+        const Node* node = &mRoot;
+        size_t pos = 0, len = 0;
+        while (true) {
+            for (const auto& value : node->mValues) {
+                func(value);
+            }
+            if (!nextComponent(path, pos, len)) {
+                return;
+            }
+            node = node->FindChild(path.data() + pos, len);
+            if (node == nullptr) {
+                return;
+            }
+            pos += len;
+        }
+    }
+
+    void Clear() {
+        mRoot.mChildren.clear();
+        mRoot.mValues.clear();
+        mSize = 0;
+    }
+
+    size_t Size() const { return mSize; }
+
+private:
+    struct Node {
+        // sorted by component name, fanout is small except for container roots like overlay2/<id>
+        std::vector<std::pair<std::string, std::unique_ptr<Node>>> mChildren;
+        std::vector<T> mValues;
+
+        typename std::vector<std::pair<std::string, std::unique_ptr<Node>>>::const_iterator
+        LowerBound(const char* name, size_t len) const {
+            return std::lower_bound(mChildren.begin(),
+                                    mChildren.end(),
+                                    std::make_pair(name, len),
+                                    [](const std::pair<std::string, std::unique_ptr<Node>>& child,
+                                       const std::pair<const char*, size_t>& key) {
+                                        return child.first.compare(0, std::string::npos, key.first, key.second) < 0;
+                                    });
+        }
+
+        Node* FindChild(const char* name, size_t len) const {
+            auto it = LowerBound(name, len);
+            if (it != mChildren.end() && it->first.size() == len && memcmp(it->first.data(), name, len) == 0) {
+                return it->second.get();
+            }
+            return nullptr;
+        }
+
+        Node* GetOrCreateChild(const char* name, size_t len) {
+            auto it = LowerBound(name, len);
+            if (it != mChildren.end() && it->first.size() == len && memcmp(it->first.data(), name, len) == 0) {
+                return it->second.get();
+            }
+            it = mChildren.emplace(it, std::string(name, len), std::unique_ptr<Node>(new Node()));
+            return it->second.get();
+        }
+
+        void RemoveChild(const Node* child) {
+            for (auto it = mChildren.begin(); it != mChildren.end(); ++it) {
+                if (it->second.get() == child) {
+                    mChildren.erase(it);
+                    return;
+                }
+            }
+        }
+    };
+
+    // nextComponent moves @pos to the beginning of next non-empty component and sets @len to its length.
+    static bool nextComponent(const std::string& path, size_t& pos, size_t& len) {
+        while (pos < path.size() && path[pos] == PATH_SEPARATOR[0]) {
+            ++pos;
+        }
+        if (pos >= path.size()) {
+            return false;
+        }
+        size_t end = path.find(PATH_SEPARATOR[0], pos);
+        len = (end == std::string::npos ? path.size() : end) - pos;
+        return true;
+    }
+
+    Node mRoot;
+    size_t mSize = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class PathTrieUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,85 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event/Event.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace logtail {
+
+namespace {
+
+// Events are usually created by polling or inotify threads and deleted by LogInput thread, which
+// defeats thread local caches of malloc. Freed events are kept for reuse, up to kMaxPooledEvents.
+const size_t kMaxPooledEvents = 16384;
+
+class EventPool {
+public:
+    void* Allocate() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mFreeList.empty()) {
+                void* ptr = mFreeList.back();
+                mFreeList.pop_back();
+                return ptr;
+            }
+        }
+        return ::operator new(sizeof(Event));
+    }
+
+    void Free(void* ptr) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mFreeList.size() < kMaxPooledEvents) {
+                mFreeList.push_back(ptr);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+private:
+    std::mutex mMutex;
+    std::vector<void*> mFreeList;
+};
+
+EventPool* GetEventPool() {
+    // never destructed, events may be deleted during exit
+    static EventPool* sPool = new EventPool();
+    return sPool;
+}
+
+} // namespace
+
+void* Event::operator new(size_t size) {
+    if (size != sizeof(Event)) {
+        return ::operator new(size);
+    }
+    return GetEventPool()->Allocate();
+}
+
+void Event::operator delete(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (size != sizeof(Event)) {
+        ::operator delete(ptr);
+        return;
+    }
+    GetEventPool()->Free(ptr);
+}
+
+} // namespace logtail
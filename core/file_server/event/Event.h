@@ -16,6 +16,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <memory>
 #include <string>
 #include "common/DevInode.h"
 
@@ -34,9 +35,12 @@ typedef uint32_t EventType;
 #define EVENT_CONTAINER_STOPPED (256)
 #define EVENT_READER_FLUSH_TIMEOUT (512)
 
+// Events are created and deleted frequently (especially under log rotation storms), so they are
+// allocated from a pool (see Event.cpp), and source paths of inotify events are shared with the
+// registered directory instead of being copied.
 class Event {
 private:
-    std::string mSource; // path of file or dir
+    std::shared_ptr<const std::string> mSource; // path of file or dir
     std::string mObject; // the object who has changed
     EventType mType;
     int mWd;
@@ -52,6 +56,19 @@ private:
 
 public:
     Event(const std::string& source, const std::string& object, EventType type, int wd, uint32_t cookie = 0)
+        : mSource(std::make_shared<const std::string>(source)),
+          mObject(object),
+          mType(type),
+          mWd(wd),
+          mCookie(cookie),
+          mDev(NO_BLOCK_DEV),
+          mInode(NO_BLOCK_INODE) {}
+    // @source is shared rather than copied, it must not be modified afterwards.
+    Event(const std::shared_ptr<const std::string>& source,
+          const char* object,
+          EventType type,
+          int wd,
+          uint32_t cookie = 0)
         : mSource(source),
           mObject(object),
           mType(type),
@@ -66,12 +83,21 @@ public:
           uint32_t cookie,
           uint64_t dev,
           uint64_t inode)
-        : mSource(source), mObject(object), mType(type), mWd(wd), mCookie(cookie), mDev(dev), mInode(inode) {}
+        : mSource(std::make_shared<const std::string>(source)),
+          mObject(object),
+          mType(type),
+          mWd(wd),
+          mCookie(cookie),
+          mDev(dev),
+          mInode(inode) {}
+
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
 
     static bool CompareByFullPath(const Event* lhs, const Event* rhs) {
-        std::string lhsPath(lhs->mSource);
+        std::string lhsPath(*lhs->mSource);
         lhsPath.append("/").append(lhs->mObject);
-        std::string rhsPath(rhs->mSource);
+        std::string rhsPath(*rhs->mSource);
         rhsPath.append("/").append(rhs->mObject);
 
         size_t lhsLen = lhsPath.length();
@@ -85,7 +111,7 @@ public:
         return lhsPath > rhsPath;
     }
 
-    const std::string& GetSource() const { return mSource; }
+    const std::string& GetSource() const { return *mSource; }
 
     const std::string& GetObject() const { return mObject; }
 
@@ -110,7 +136,7 @@ public:
 
     int64_t GetLastFilePos() const { return mLastFilePos; }
 
-    void SetSource(const std::string& source) { mSource = source; }  
+    void SetSource(const std::string& source) { mSource = std::make_shared<const std::string>(source); }
 
     void SetDev(uint64_t dev) { mDev = dev; }
 
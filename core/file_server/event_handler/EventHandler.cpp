@@ -750,6 +750,14 @@ void ModifyHandler::Handle(const Event& event) {
             }
         }
 
+        // the next chunk is still being read asynchronously, read other files first
+        if (reader->ShouldDeferRead()) {
+            Event* ev = new Event(event);
+            ev->SetConfigName(mConfigName);
+            LogInput::GetInstance()->PushEventQueue(ev);
+            return;
+        }
+
         bool hasMoreData;
         do {
             if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
@@ -805,6 +813,7 @@ void ModifyHandler::Handle(const Event& event) {
                     sLogger,
                     ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
                         "begin time", beginTime)("path", event.GetSource())("file", event.GetObject()));
+                reader->PrefetchNextRead();
                 Event* ev = new Event(event);
                 ev->SetConfigName(mConfigName);
                 LogInput::GetInstance()->PushEventQueue(ev);
@@ -37,6 +37,7 @@
 #include "file_server/polling/PollingDirFile.h"
 #include "file_server/polling/PollingEventQueue.h"
 #include "file_server/polling/PollingModify.h"
+#include "file_server/reader/AsyncReadEngine.h"
 #include "file_server/reader/GloablFileDescriptorManager.h"
 #include "file_server/reader/LogFileReader.h"
 #ifdef __ENTERPRISE__
@@ -387,6 +388,8 @@ void* LogInput::ProcessLoop() {
                 delete ev;
             else
                 ProcessEvent(dispatcher, ev);
+            // reads prefetched when handling the event are submitted together
+            AsyncReadEngine::GetInstance()->Submit();
         } else
             usleep(INT32_FLAG(log_input_thread_wait_interval));
         if (mIdleFlag)
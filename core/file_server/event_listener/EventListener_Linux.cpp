@@ -16,6 +16,7 @@
 #include <sys/inotify.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <cstring>
 #include "logger/Logger.h"
 #include "monitor/LogtailAlarm.h"
 #include "common/ErrorUtil.h"
@@ -57,25 +58,23 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
     ioctl(mInotifyFd, FIONREAD, &len);
     if (len < 1)
         return 0;
-    static char* s_lastHalfEventBuf = new char[65536];
-    static int32_t s_lastHalfEventSize = 0;
 
-    char* buffer = new char[len + s_lastHalfEventSize];
-    if (s_lastHalfEventSize > 0) {
-        memcpy(buffer, s_lastHalfEventBuf, s_lastHalfEventSize);
+    if (mReadBuffer.size() < mHalfEventSize + len) {
+        mReadBuffer.resize(mHalfEventSize + len);
     }
-    size_t readLen = read(mInotifyFd, buffer + s_lastHalfEventSize, len);
-    if (readLen == 0) {
+    char* buffer = mReadBuffer.data();
+    ssize_t readLen = read(mInotifyFd, buffer + mHalfEventSize, len);
+    if (readLen <= 0) {
         LOG_ERROR(sLogger, ("read inotify fd error", ErrnoToString(GetErrno()))("read len", len));
-        delete[] buffer;
         return 0;
     }
     // update len
-    len = readLen + s_lastHalfEventSize;
-    // when read success, set lastHalfSize 0
-    s_lastHalfEventSize = 0;
+    len = readLen + mHalfEventSize;
+    // when read success, set half size 0
+    mHalfEventSize = 0;
     if (BOOL_FLAG(fs_events_inotify_enable)) {
         static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        mModifiedFiles.clear();
         int n = 0;
         struct inotify_event* event;
         while (n < len) {
@@ -85,10 +84,10 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
             int tailSize = len - n;
             if ((size_t)tailSize < sizeof(struct inotify_event)
                 || (size_t)tailSize < event->len + sizeof(struct inotify_event)) {
-                s_lastHalfEventSize = tailSize;
+                mHalfEventSize = tailSize;
                 LOG_WARNING(sLogger,
                             ("read notify event abnormal, half packet is readed, proccess size", n)("read len", len));
-                memcpy(s_lastHalfEventBuf, buffer + n, tailSize);
+                memmove(buffer, buffer + n, tailSize);
                 break;
             }
 
@@ -110,15 +109,29 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
                 etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
                 etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
                 etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
-                std::string path;
-                if (etype != 0 && dispatcher->IsRegistered(event->wd, path))
-                    eventVec.push_back(
-                        new Event(path, event->len > 0 ? event->name : "", etype, event->wd, event->cookie));
+                if (etype != 0) {
+                    const char* name = event->len > 0 ? event->name : "";
+                    // A file is written many times between two reads, while ModifyHandler reads to the end of
+                    // file on one MODIFY event, so only the first MODIFY of a file is kept until the file is
+                    // created, moved or deleted.
+                    ModifyKey key{event->wd, std::string_view(name)};
+                    bool merged = false;
+                    if (etype == EVENT_MODIFY) {
+                        merged = !mModifiedFiles.insert(key).second;
+                    } else {
+                        mModifiedFiles.erase(key);
+                    }
+                    if (!merged) {
+                        std::shared_ptr<const std::string> path = dispatcher->GetRegisteredPath(event->wd);
+                        if (path) {
+                            eventVec.push_back(new Event(path, name, etype, event->wd, event->cookie));
+                        }
+                    }
+                }
             }
             n += sizeof(struct inotify_event) + event->len;
         }
     }
-    delete[] buffer;
     return (int32_t)eventVec.size();
 }
 
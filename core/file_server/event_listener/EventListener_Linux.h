@@ -18,6 +18,8 @@
 #define LOGTAIL_EVENTLISTENER_H
 
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 #include "file_server/event/Event.h"
 
@@ -46,8 +48,26 @@ public:
     int32_t ReadEvents(std::vector<Event*>& eventVec);
 
 private:
+    // ModifyKey identifies a file by watch descriptor of its dir and its name, @name refers to mReadBuffer.
+    struct ModifyKey {
+        int wd;
+        std::string_view name;
+
+        bool operator==(const ModifyKey& rhs) const { return wd == rhs.wd && name == rhs.name; }
+    };
+    struct ModifyKeyHash {
+        size_t operator()(const ModifyKey& key) const {
+            return std::hash<std::string_view>()(key.name) ^ (static_cast<size_t>(key.wd) * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
     EventListener() = default;
     int32_t mInotifyFd = -1;
+    // Reused across reads, an incomplete event at the end of last read is kept at the beginning.
+    std::vector<char> mReadBuffer;
+    size_t mHalfEventSize = 0;
+    // Files with a MODIFY event in current read, later MODIFY events of them are merged.
+    std::unordered_set<ModifyKey, ModifyKeyHash> mModifiedFiles;
 };
 
 } // namespace logtail
@@ -0,0 +1,248 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/polling/BatchStat.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#include "common/Flags.h"
+#include "common/ThreadPool.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(polling_stat_batch_size, "max stat requests in flight when polling, <= 1 to disable batch", 256);
+DEFINE_FLAG_BOOL(enable_polling_stat_io_uring, "use io_uring statx to stat polling files if available", true);
+DEFINE_FLAG_INT32(polling_stat_thread_count, "thread count to stat polling files when io_uring is unavailable", 4);
+
+namespace logtail {
+
+namespace {
+
+// Tasks smaller than this are not worth to be dispatched to worker threads.
+const size_t kMinThreadPoolTaskSize = 16;
+
+ThreadPool* GetStatThreadPool() {
+    static ThreadPool* sPool = []() {
+        auto* pool = new ThreadPool(static_cast<size_t>(std::max(INT32_FLAG(polling_stat_thread_count), 1)));
+        pool->Start();
+        return pool;
+    }();
+    return sPool;
+}
+
+void StatOne(const std::string& path, BatchStat::Result& result) {
+    result.err = fsutil::PathStat::stat(path, result.stat) ? 0 : errno;
+}
+
+#ifdef LOGTAIL_HAS_IO_URING_STATX
+void StatxToStat(const struct statx& stx, fsutil::PathStat& ps) {
+    auto* raw = ps.GetRawStat();
+    memset(raw, 0, sizeof(*raw));
+    raw->st_dev = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    raw->st_ino = stx.stx_ino;
+    raw->st_mode = stx.stx_mode;
+    raw->st_nlink = stx.stx_nlink;
+    raw->st_uid = stx.stx_uid;
+    raw->st_gid = stx.stx_gid;
+    raw->st_rdev = makedev(stx.stx_rdev_major, stx.stx_rdev_minor);
+    raw->st_size = stx.stx_size;
+    raw->st_blksize = stx.stx_blksize;
+    raw->st_blocks = stx.stx_blocks;
+    raw->st_atim.tv_sec = stx.stx_atime.tv_sec;
+    raw->st_atim.tv_nsec = stx.stx_atime.tv_nsec;
+    raw->st_mtim.tv_sec = stx.stx_mtime.tv_sec;
+    raw->st_mtim.tv_nsec = stx.stx_mtime.tv_nsec;
+    raw->st_ctim.tv_sec = stx.stx_ctime.tv_sec;
+    raw->st_ctim.tv_nsec = stx.stx_ctime.tv_nsec;
+}
+#endif
+
+} // namespace
+
+BatchStat::BatchStat() {
+}
+
+BatchStat::~BatchStat() {
+}
+
+size_t BatchStat::GetBatchSize() {
+    return static_cast<size_t>(std::max(INT32_FLAG(polling_stat_batch_size), 1));
+}
+
+void BatchStat::initBackend() {
+    mBackendInited = true;
+    mBackend = Backend::SEQUENTIAL;
+    if (GetBatchSize() <= 1) {
+        return;
+    }
+#ifdef LOGTAIL_HAS_IO_URING_STATX
+    if (BOOL_FLAG(enable_polling_stat_io_uring) && IoUring::IsSupported(IORING_OP_STATX)) {
+        std::unique_ptr<IoUring> ring(new IoUring());
+        if (ring->Init(static_cast<uint32_t>(std::min(GetBatchSize(), static_cast<size_t>(4096))))) {
+            mRing = std::move(ring);
+            mStatxBufs.reset(new struct statx[mRing->GetSqEntries()]);
+            mBackend = Backend::IO_URING;
+            LOG_INFO(sLogger, ("batch stat backend", "io_uring")("entries", mRing->GetSqEntries()));
+            return;
+        }
+    }
+#endif
+    if (INT32_FLAG(polling_stat_thread_count) > 1) {
+        mBackend = Backend::THREAD_POOL;
+        LOG_INFO(sLogger, ("batch stat backend", "thread pool")("threads", INT32_FLAG(polling_stat_thread_count)));
+    }
+}
+
+void BatchStat::Stat(const std::vector<std::string>& paths, std::vector<Result>& results) {
+    if (!mBackendInited) {
+        initBackend();
+    }
+    results.clear();
+    results.resize(paths.size());
+    if (paths.size() < 2) {
+        statSequentially(paths, results);
+        return;
+    }
+
+    switch (mBackend) {
+#ifdef LOGTAIL_HAS_IO_URING_STATX
+        case Backend::IO_URING: {
+            if (statWithIoUring(paths, results)) {
+                return;
+            }
+            // The ring is broken, never use it again.
+            LOG_WARNING(sLogger, ("io_uring batch stat failed", "fallback to thread pool"));
+            mBackend = Backend::THREAD_POOL;
+            statWithThreadPool(paths, results);
+            return;
+        }
+#endif
+        case Backend::THREAD_POOL:
+            statWithThreadPool(paths, results);
+            return;
+        default:
+            statSequentially(paths, results);
+            return;
+    }
+}
+
+void BatchStat::statSequentially(const std::vector<std::string>& paths, std::vector<Result>& results) {
+    for (size_t i = 0; i < paths.size(); ++i) {
+        StatOne(paths[i], results[i]);
+    }
+}
+
+void BatchStat::statWithThreadPool(const std::vector<std::string>& paths, std::vector<Result>& results) {
+    const size_t threadCount = static_cast<size_t>(std::max(INT32_FLAG(polling_stat_thread_count), 1));
+    const size_t inflight = std::min(GetBatchSize(), paths.size());
+    // Split into more tasks than threads, so that a slow path only blocks a small part.
+    size_t taskSize = std::max((inflight + threadCount * 4 - 1) / (threadCount * 4), kMinThreadPoolTaskSize);
+
+    struct Latch {
+        std::mutex mMutex;
+        std::condition_variable mCond;
+        size_t mRemaining = 0;
+    };
+    auto latch = std::make_shared<Latch>();
+    const size_t taskCount = (paths.size() + taskSize - 1) / taskSize;
+    latch->mRemaining = taskCount;
+
+    ThreadPool* pool = GetStatThreadPool();
+    for (size_t begin = 0; begin < paths.size(); begin += taskSize) {
+        size_t end = std::min(begin + taskSize, paths.size());
+        pool->Add([&paths, &results, begin, end, latch]() {
+            for (size_t i = begin; i < end; ++i) {
+                StatOne(paths[i], results[i]);
+            }
+            std::lock_guard<std::mutex> lock(latch->mMutex);
+            if (--latch->mRemaining == 0) {
+                latch->mCond.notify_one();
+            }
+        });
+    }
+    std::unique_lock<std::mutex> lock(latch->mMutex);
+    latch->mCond.wait(lock, [&latch]() { return latch->mRemaining == 0; });
+}
+
+#ifdef LOGTAIL_HAS_IO_URING_STATX
+bool BatchStat::statWithIoUring(const std::vector<std::string>& paths, std::vector<Result>& results) {
+    const uint32_t slotCount = mRing->GetSqEntries();
+    std::vector<uint32_t> freeSlots(slotCount);
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        freeSlots[i] = slotCount - 1 - i;
+    }
+    std::vector<size_t> slotToPath(slotCount);
+
+    size_t next = 0, completed = 0, inflight = 0;
+    while (completed < paths.size()) {
+        while (next < paths.size() && !freeSlots.empty()) {
+            io_uring_sqe* sqe = mRing->GetSqe();
+            if (sqe == nullptr) {
+                break;
+            }
+            uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            slotToPath[slot] = next;
+            sqe->opcode = IORING_OP_STATX;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<uint64_t>(paths[next].c_str());
+            sqe->len = STATX_BASIC_STATS;
+            sqe->off = reinterpret_cast<uint64_t>(&mStatxBufs[slot]);
+            sqe->statx_flags = 0;
+            sqe->user_data = slot;
+            ++next;
+            ++inflight;
+        }
+
+        // -EAGAIN and -EBUSY mean kernel is short of resources or completion queue is full,
+        // reap completions and retry.
+        int ret = mRing->Submit(1);
+        if (ret < 0 && ret != -EAGAIN && ret != -EBUSY) {
+            LOG_WARNING(sLogger, ("submit io_uring statx failed", ret)("inflight", inflight));
+            // Kernel may still write to buffers of requests in flight, so the ring and buffers
+            // are leaked on purpose. Paths are copied by kernel when submitting, no need to keep.
+            mRing.release();
+            mStatxBufs.release();
+            return false;
+        }
+
+        uint64_t userData = 0;
+        int32_t res = 0;
+        while (mRing->PeekCqe(userData, res)) {
+            uint32_t slot = static_cast<uint32_t>(userData);
+            Result& result = results[slotToPath[slot]];
+            if (res < 0) {
+                result.err = -res;
+            } else {
+                result.err = 0;
+                StatxToStat(mStatxBufs[slot], result.stat);
+            }
+            freeSlots.push_back(slot);
+            --inflight;
+            ++completed;
+        }
+    }
+    return true;
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/stat.h>
+#endif
+
+#include "common/FileSystemUtil.h"
+#include "common/IoUring.h"
+
+#if defined(LOGTAIL_HAS_IO_URING) && defined(STATX_BASIC_STATS)
+#define LOGTAIL_HAS_IO_URING_STATX 1
+#endif
+
+namespace logtail {
+
+// BatchStat stats a batch of paths with many requests in flight, so that the latency of
+// slow filesystems (NFS, overlay, etc.) is overlapped instead of accumulated.
+// Backends, in order of preference:
+// - io_uring IORING_OP_STATX (Linux >= 5.6 and not blocked by seccomp).
+// - A shared worker pool calling ::stat concurrently.
+// - Sequential fsutil::PathStat::stat (batch disabled or non-Linux).
+//
+// It is not thread-safe, each polling thread should own an instance.
+class BatchStat {
+public:
+    enum class Backend { SEQUENTIAL, THREAD_POOL, IO_URING };
+
+    struct Result {
+        fsutil::PathStat stat;
+        // 0 if stat succeeded, otherwise errno.
+        int err = 0;
+    };
+
+    BatchStat();
+    ~BatchStat();
+
+    // Stat stats all @paths (following symbolic links like ::stat) and stores results in
+    // @results, results[i] is corresponding to paths[i].
+    void Stat(const std::vector<std::string>& paths, std::vector<Result>& results);
+
+    Backend GetBackend() const { return mBackend; }
+
+    // GetBatchSize returns max number of stats in flight, <= 1 means batch is disabled.
+    static size_t GetBatchSize();
+
+private:
+    // initBackend selects backend on first use, flags are not ready when constructing.
+    void initBackend();
+    void statSequentially(const std::vector<std::string>& paths, std::vector<Result>& results);
+    void statWithThreadPool(const std::vector<std::string>& paths, std::vector<Result>& results);
+#ifdef LOGTAIL_HAS_IO_URING_STATX
+    // @return false if the ring fails, all @results should be redone by other backends.
+    bool statWithIoUring(const std::vector<std::string>& paths, std::vector<Result>& results);
+
+    std::unique_ptr<IoUring> mRing;
+    // One buffer per submission entry.
+    std::unique_ptr<struct statx[]> mStatxBufs;
+#endif
+    bool mBackendInited = false;
+    Backend mBackend = Backend::SEQUENTIAL;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class BatchStatUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -391,13 +391,24 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         }
         return true;
     }
+    // Entries are collected first and then stat in a batch, so that latency of slow filesystems
+    // is overlapped. Directories are polled recursively after the batch.
+    struct PendingEntry {
+        std::string name;
+        bool needCheckDirMatch;
+        bool needFindBestMatch;
+    };
+    const int32_t sleepStatCount
+        = max(INT32_FLAG(dirfile_stat_count), static_cast<int32_t>(BatchStat::GetBatchSize()));
+    vector<PendingEntry> pendingEntries;
+    vector<string> pendingPaths;
     int32_t nowStatCount = 0;
     fsutil::Entry ent;
     while ((ent = dir.ReadNext(false))) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
+        if (++mStatCount % sleepStatCount == 0) {
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
         }
 
@@ -455,23 +466,35 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
                 continue;
             }
         }
+        pendingEntries.push_back(PendingEntry{entName, needCheckDirMatch, needFindBestMatch});
+        pendingPaths.push_back(std::move(item));
+    }
+
+    // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
+    vector<BatchStat::Result> statResults;
+    mBatchStat.Stat(pendingPaths, statResults);
+    for (size_t i = 0; i < pendingEntries.size(); ++i) {
+        if (!mRuningFlag || mHoldOnFlag)
+            break;
 
-        // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
-        fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
-            LOG_DEBUG(sLogger, ("get file info error", item.c_str())("errno", errno));
+        const string& entName = pendingEntries[i].name;
+        const string& item = pendingPaths[i];
+        if (statResults[i].err != 0) {
+            LOG_DEBUG(sLogger, ("get file info error", item.c_str())("errno", statResults[i].err));
             continue;
         }
+        const fsutil::PathStat& buf = statResults[i].stat;
 
         // For directory, poll recursively; for file, update cache and add to mNewFileVec so that
         // it can be pushed to PollingModify at the end of polling.
         // If needCheckDirMatch or needFindBestMatch is true, that means the item is a symbolic link.
         // We should check file type again to make sure that the original file which linked by
         // a symbolic file is DIR or REG.
-        if (buf.IsDir() && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(item))) {
+        if (buf.IsDir()
+            && (!pendingEntries[i].needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(item))) {
             PollingNormalConfigPath(pConfig, dirPath, entName, buf, depth + 1);
         } else if (buf.IsRegFile()) {
-            if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch)) {
+            if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, pendingEntries[i].needFindBestMatch)) {
                 LOG_DEBUG(sLogger, ("add to modify event", entName)("round", mCurrentRound));
                 mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
             }
@@ -556,27 +579,91 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
         }
         return true;
     }
-    fsutil::Entry ent;
+    const int32_t sleepStatCount
+        = max(INT32_FLAG(dirfile_stat_count), static_cast<int32_t>(BatchStat::GetBatchSize()));
+    // entries are statted chunk by chunk, so that no more entries are collected once the sub dir limit is reached
+    const size_t chunkSize = max(BatchStat::GetBatchSize(), static_cast<size_t>(1));
+    vector<string> entNames;
+    vector<string> entPaths;
+    vector<BatchStat::Result> statResults;
     int32_t dirCount = 0;
+    bool reachLimit = false;
+    auto checkDirCount = [&]() {
+        if (dirCount < INT32_FLAG(wildcard_max_sub_dir_count)) {
+            return true;
+        }
+        LOG_WARNING(sLogger,
+                    ("too many sub directoried for path",
+                     dirPath)("dirCount", dirCount)("basePath", pConfig.first->GetBasePath()));
+        LogtailAlarm::GetInstance()->SendAlarm(STAT_LIMIT_ALARM,
+                                               string("too many sub directoried for path:" + dirPath
+                                                      + " dirCount: " + ToString(dirCount) + " basePath"
+                                                      + pConfig.first->GetBasePath()),
+                                               pConfig.second->GetProjectName(),
+                                               pConfig.second->GetLogstoreName(),
+                                               pConfig.second->GetRegion());
+        reachLimit = true;
+        return false;
+    };
+    auto processEntries = [&]() {
+        mBatchStat.Stat(entPaths, statResults);
+        for (size_t i = 0; i < entNames.size(); ++i) {
+            if (!mRuningFlag || mHoldOnFlag)
+                break;
+
+            if (!checkDirCount())
+                break;
+
+            const string& entName = entNames[i];
+            const string& item = entPaths[i];
+            if (statResults[i].err != 0) {
+                LOG_WARNING(sLogger, ("get file info fail", item.c_str())("errno", statResults[i].err));
+                continue;
+            }
+            const fsutil::PathStat& buf = statResults[i].stat;
+            if (buf.IsDir()) {
+                ++dirCount;
+
+                // Use the next part to match the entry name.
+                size_t dirIndex = 0;
+                if (!BOOL_FLAG(enable_root_path_collection)) {
+                    // Handle special path /.
+                    dirIndex = pConfig.first->GetWildcardPaths()[depth].size() + 1;
+                    if (dirIndex == (size_t)2) {
+                        dirIndex = 1;
+                    }
+                } else {
+                    // A better logic, but only enabled when flag enable_root_path_collection
+                    //   is set for backward compatibility.
+                    dirIndex = pConfig.first->GetWildcardPaths()[depth].size();
+                    if (PATH_SEPARATOR[0] == pConfig.first->GetWildcardPaths()[depth + 1][dirIndex]) {
+                        ++dirIndex;
+                    }
+                }
+                if (fnmatch(
+                        &(pConfig.first->GetWildcardPaths()[depth + 1].at(dirIndex)), entName.c_str(), FNM_PATHNAME)
+                    == 0) {
+                    if (finish) {
+                        hasMatchFlag = true;
+                        PollingNormalConfigPath(pConfig, item, string(), buf, 0);
+                    } else {
+                        hasMatchFlag |= PollingWildcardConfigPath(pConfig, item, depth + 1);
+                    }
+                }
+            }
+        }
+        entNames.clear();
+        entPaths.clear();
+    };
+    fsutil::Entry ent;
     while ((ent = dir.ReadNext(false))) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        if (dirCount >= INT32_FLAG(wildcard_max_sub_dir_count)) {
-            LOG_WARNING(sLogger,
-                        ("too many sub directoried for path",
-                         dirPath)("dirCount", dirCount)("basePath", pConfig.first->GetBasePath()));
-            LogtailAlarm::GetInstance()->SendAlarm(STAT_LIMIT_ALARM,
-                                                   string("too many sub directoried for path:" + dirPath
-                                                          + " dirCount: " + ToString(dirCount) + " basePath"
-                                                          + pConfig.first->GetBasePath()),
-                                                   pConfig.second->GetProjectName(),
-                                                   pConfig.second->GetLogstoreName(),
-                                                   pConfig.second->GetRegion());
+        if (entPaths.empty() && !checkDirCount())
             break;
-        }
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0)
+        if (++mStatCount % sleepStatCount == 0)
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
 
         if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
@@ -592,42 +679,18 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
         }
 
         auto entName = ent.Name();
-        string item = PathJoin(dirPath, entName);
-        fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
-            LOG_WARNING(sLogger, ("get file info fail", item.c_str())("errno", GetErrno()));
-            continue;
-        }
-        if (buf.IsDir()) {
-            ++dirCount;
-
-            // Use the next part to match the entry name.
-            size_t dirIndex = 0;
-            if (!BOOL_FLAG(enable_root_path_collection)) {
-                // Handle special path /.
-                dirIndex = pConfig.first->GetWildcardPaths()[depth].size() + 1;
-                if (dirIndex == (size_t)2) {
-                    dirIndex = 1;
-                }
-            } else {
-                // A better logic, but only enabled when flag enable_root_path_collection
-                //   is set for backward compatibility.
-                dirIndex = pConfig.first->GetWildcardPaths()[depth].size();
-                if (PATH_SEPARATOR[0] == pConfig.first->GetWildcardPaths()[depth + 1][dirIndex]) {
-                    ++dirIndex;
-                }
-            }
-            if (fnmatch(&(pConfig.first->GetWildcardPaths()[depth + 1].at(dirIndex)), entName.c_str(), FNM_PATHNAME)
-                == 0) {
-                if (finish) {
-                    hasMatchFlag = true;
-                    PollingNormalConfigPath(pConfig, item, string(), buf, 0);
-                } else {
-                    hasMatchFlag |= PollingWildcardConfigPath(pConfig, item, depth + 1);
-                }
+        entPaths.push_back(PathJoin(dirPath, entName));
+        entNames.push_back(std::move(entName));
+        if (entPaths.size() >= chunkSize) {
+            processEntries();
+            if (reachLimit) {
+                break;
             }
         }
     }
+    if (!reachLimit && !entPaths.empty()) {
+        processEntries();
+    }
     return hasMatchFlag;
 }
 
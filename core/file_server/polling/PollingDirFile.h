@@ -17,6 +17,7 @@
 #pragma once
 #include <map>
 
+#include "file_server/polling/BatchStat.h"
 #include "file_server/polling/PollingCache.h"
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
@@ -135,6 +136,7 @@ private:
     std::vector<SplitedFilePath> mNewFileVec;
     // The sequence number of current round, uint64_t is used to avoid overflow.
     uint64_t mCurrentRound;
+    BatchStat mBatchStat;
 
     IntGaugePtr mGlobalConfigTotal;
     IntGaugePtr mGlobalPollingDirCacheSizeTotal;
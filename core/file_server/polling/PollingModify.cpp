@@ -252,41 +252,65 @@ void PollingModify::Polling() {
             size_t pollingModifySizeTotal = mModifyCacheMap.size();
             LogtailMonitor::GetInstance()->UpdateMetric("polling_modify_size", pollingModifySizeTotal);
             mGlobalPollingModifySizeTotal->Set(pollingModifySizeTotal);
-            for (auto iter = mModifyCacheMap.begin(); iter != mModifyCacheMap.end(); ++iter) {
+            // Files are stat in batches, each batch has many stats in flight, and the sleep is
+            // done once per batch at most, so that slow filesystems will not delay the round.
+            const size_t batchSize = BatchStat::GetBatchSize();
+            const int32_t sleepStatCount = max(INT32_FLAG(modify_stat_count), static_cast<int32_t>(batchSize));
+            uint64_t roundStartTime = GetCurrentTimeInMilliSeconds();
+            vector<ModifyCheckCacheMap::iterator> batchIters;
+            vector<string> batchPaths;
+            vector<BatchStat::Result> batchResults;
+            batchIters.reserve(batchSize);
+            batchPaths.reserve(batchSize);
+            auto iter = mModifyCacheMap.begin();
+            while (iter != mModifyCacheMap.end()) {
                 if (!mRuningFlag || mHoldOnFlag)
                     break;
 
-                const SplitedFilePath& filePath = iter->first;
-                ModifyCheckCache& modifyCache = iter->second;
-                fsutil::PathStat logFileStat;
-                if (!fsutil::PathStat::stat(PathJoin(filePath.mFileDir, filePath.mFileName), logFileStat)) {
-                    if (errno == ENOENT) {
-                        LOG_DEBUG(sLogger, ("file deleted", PathJoin(filePath.mFileDir, filePath.mFileName)));
-                        if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
-                            deletedFileVec.push_back(filePath);
+                batchIters.clear();
+                batchPaths.clear();
+                for (; iter != mModifyCacheMap.end() && batchIters.size() < batchSize; ++iter) {
+                    batchIters.push_back(iter);
+                    batchPaths.push_back(PathJoin(iter->first.mFileDir, iter->first.mFileName));
+                }
+                mBatchStat.Stat(batchPaths, batchResults);
+
+                for (size_t i = 0; i < batchIters.size(); ++i) {
+                    const SplitedFilePath& filePath = batchIters[i]->first;
+                    ModifyCheckCache& modifyCache = batchIters[i]->second;
+                    const BatchStat::Result& result = batchResults[i];
+                    if (result.err != 0) {
+                        if (result.err == ENOENT) {
+                            LOG_DEBUG(sLogger, ("file deleted", batchPaths[i]));
+                            if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
+                                deletedFileVec.push_back(filePath);
+                            }
+                        } else {
+                            LOG_DEBUG(sLogger, ("get file info error", batchPaths[i])("errno", result.err));
                         }
                     } else {
-                        LOG_DEBUG(sLogger, ("get file info error", PathJoin(filePath.mFileDir, filePath.mFileName)));
+                        const fsutil::PathStat& logFileStat = result.stat;
+                        int64_t sec, nsec;
+                        logFileStat.GetLastWriteTime(sec, nsec);
+                        timespec mtim{sec, nsec};
+                        auto devInode = logFileStat.GetDevInode();
+                        UpdateFile(filePath,
+                                   modifyCache,
+                                   devInode.dev,
+                                   devInode.inode,
+                                   logFileStat.GetFileSize(),
+                                   mtim,
+                                   pollingEventVec);
                     }
-                } else {
-                    int64_t sec, nsec;
-                    logFileStat.GetLastWriteTime(sec, nsec);
-                    timespec mtim{sec, nsec};
-                    auto devInode = logFileStat.GetDevInode();
-                    UpdateFile(filePath,
-                               modifyCache,
-                               devInode.dev,
-                               devInode.inode,
-                               logFileStat.GetFileSize(),
-                               mtim,
-                               pollingEventVec);
-                }
 
-                ++statCount;
-                if (statCount % INT32_FLAG(modify_stat_count) == 0) {
-                    usleep(1000 * INT32_FLAG(modify_stat_sleepMs));
+                    if (++statCount % sleepStatCount == 0) {
+                        usleep(1000 * INT32_FLAG(modify_stat_sleepMs));
+                    }
                 }
             }
+            LOG_DEBUG(sLogger,
+                      ("polling modify round", "done")("stat count", statCount)(
+                          "time cost ms", GetCurrentTimeInMilliSeconds() - roundStartTime));
 
             if (pollingEventVec.size() > 0) {
                 PollingEventQueue::GetInstance()->PushEvent(pollingEventVec);
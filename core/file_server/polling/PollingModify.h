@@ -19,6 +19,7 @@
 #include <map>
 #include <vector>
 
+#include "file_server/polling/BatchStat.h"
 #include "file_server/polling/PollingCache.h"
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
@@ -100,6 +101,7 @@ private:
     std::deque<SplitedFilePath> mDeletedFileNameQueue;
 
     ModifyCheckCacheMap mModifyCacheMap;
+    BatchStat mBatchStat;
 
     IntGaugePtr mGlobalPollingModifySizeTotal;
 
@@ -0,0 +1,256 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/reader/AsyncReadEngine.h"
+
+#include <errno.h>
+
+#include <algorithm>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_BOOL(enable_reader_io_uring_read, "prefetch log files through io_uring if available", false);
+DEFINE_FLAG_INT32(reader_io_uring_max_inflight,
+                  "max log file reads in flight through io_uring, each one takes a read buffer (512KB)",
+                  64);
+
+namespace logtail {
+
+AsyncReadEngine::~AsyncReadEngine() {
+    disable();
+}
+
+bool AsyncReadEngine::IsEnabled() {
+    if (mInited) {
+        return mEnabled;
+    }
+    mInited = true;
+#ifdef LOGTAIL_HAS_IO_URING
+    if (BOOL_FLAG(enable_reader_io_uring_read) && IoUring::IsSupported(IORING_OP_READ)) {
+        std::unique_ptr<IoUring> ring(new IoUring());
+        if (ring->Init(static_cast<uint32_t>(std::max(INT32_FLAG(reader_io_uring_max_inflight), 1)))) {
+            mRing = std::move(ring);
+            mEnabled = true;
+            LOG_INFO(sLogger, ("async read engine", "io_uring")("entries", mRing->GetSqEntries()));
+        }
+    }
+#endif
+    return mEnabled;
+}
+
+bool AsyncReadEngine::Prefetch(const void* owner, int fd, int64_t offset, size_t reserved, size_t size) {
+    if (!IsEnabled() || fd < 0 || size == 0) {
+        return false;
+    }
+#ifdef LOGTAIL_HAS_IO_URING
+    Cancel(owner);
+    if (mRequests.size() >= static_cast<size_t>(std::max(INT32_FLAG(reader_io_uring_max_inflight), 1))) {
+        reap();
+        if (mRequests.size() >= static_cast<size_t>(std::max(INT32_FLAG(reader_io_uring_max_inflight), 1))) {
+            return false;
+        }
+    }
+    io_uring_sqe* sqe = mRing->GetSqe();
+    if (sqe == nullptr) {
+        Submit();
+        if (!mEnabled) {
+            return false;
+        }
+        sqe = mRing->GetSqe();
+        if (sqe == nullptr) {
+            return false;
+        }
+    }
+
+    const uint64_t id = mNextId++;
+    std::unique_ptr<Request> req(new Request());
+    req->owner = owner;
+    req->fd = fd;
+    req->offset = offset;
+    req->reserved = reserved;
+    req->sourceBuffer.reset(new SourceBuffer());
+    req->data = req->sourceBuffer->AllocateStringBuffer(reserved + size).data;
+
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(req->data + reserved);
+    sqe->len = static_cast<uint32_t>(size);
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->user_data = id;
+
+    mRequests[id] = std::move(req);
+    mOwnerIndex[owner] = id;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AsyncReadEngine::Submit() {
+    if (!mEnabled) {
+        return;
+    }
+#ifdef LOGTAIL_HAS_IO_URING
+    int ret = mRing->Submit(0);
+    // -EAGAIN and -EBUSY mean kernel is short of resources or completion queue is full, retry next time.
+    if (ret < 0 && ret != -EAGAIN && ret != -EBUSY) {
+        LOG_WARNING(sLogger, ("submit io_uring read failed", ret)("action", "fallback to pread"));
+        disable();
+    }
+#endif
+}
+
+bool AsyncReadEngine::ShouldDefer(const void* owner) {
+    if (!mEnabled) {
+        return false;
+    }
+    auto it = mOwnerIndex.find(owner);
+    if (it == mOwnerIndex.end()) {
+        return false;
+    }
+    const uint64_t id = it->second;
+    Submit();
+    reap();
+    auto reqIt = mRequests.find(id);
+    if (reqIt == mRequests.end()) {
+        return false;
+    }
+    Request& req = *reqIt->second;
+    if (req.state == State::DONE || req.deferred) {
+        return false;
+    }
+    req.deferred = true;
+    return true;
+}
+
+bool AsyncReadEngine::Take(
+    const void* owner, int fd, int64_t offset, size_t reserved, size_t minSize, Completion& completion) {
+    if (!mEnabled) {
+        return false;
+    }
+    auto it = mOwnerIndex.find(owner);
+    if (it == mOwnerIndex.end()) {
+        return false;
+    }
+    const uint64_t id = it->second;
+    mOwnerIndex.erase(it);
+    if (!waitFor(id)) {
+        return false;
+    }
+    auto reqIt = mRequests.find(id);
+    std::unique_ptr<Request> req = std::move(reqIt->second);
+    mRequests.erase(reqIt);
+
+    if (req->res < 0) {
+        LOG_DEBUG(sLogger, ("io_uring read failed", req->res)("fd", fd)("offset", offset));
+        return false;
+    }
+    // The file may be reopened, truncated or partially read since the read is prefetched.
+    if (req->fd != fd || req->offset != offset || req->reserved != reserved
+        || static_cast<size_t>(req->res) < minSize) {
+        return false;
+    }
+    completion.sourceBuffer = std::move(req->sourceBuffer);
+    completion.data = req->data;
+    completion.size = static_cast<size_t>(req->res);
+    return true;
+}
+
+void AsyncReadEngine::Cancel(const void* owner) {
+    auto it = mOwnerIndex.find(owner);
+    if (it == mOwnerIndex.end()) {
+        return;
+    }
+    const uint64_t id = it->second;
+    mOwnerIndex.erase(it);
+    // Make sure the read is in kernel before the caller closes fd, so fd can not be reused by another file.
+    Submit();
+    auto reqIt = mRequests.find(id);
+    if (reqIt == mRequests.end()) {
+        return;
+    }
+    if (reqIt->second->state == State::DONE) {
+        mRequests.erase(reqIt);
+    } else {
+        // Kernel may still write to the buffer, release it when completed.
+        reqIt->second->owner = nullptr;
+    }
+}
+
+void AsyncReadEngine::reap() {
+#ifdef LOGTAIL_HAS_IO_URING
+    if (!mEnabled) {
+        return;
+    }
+    uint64_t userData = 0;
+    int32_t res = 0;
+    while (mRing->PeekCqe(userData, res)) {
+        auto it = mRequests.find(userData);
+        if (it == mRequests.end()) {
+            continue;
+        }
+        if (it->second->owner == nullptr) {
+            mRequests.erase(it);
+            continue;
+        }
+        it->second->state = State::DONE;
+        it->second->res = res;
+    }
+#endif
+}
+
+bool AsyncReadEngine::waitFor(uint64_t id) {
+#ifdef LOGTAIL_HAS_IO_URING
+    while (mEnabled) {
+        reap();
+        auto it = mRequests.find(id);
+        if (it == mRequests.end()) {
+            return false;
+        }
+        if (it->second->state == State::DONE) {
+            return true;
+        }
+        int ret = mRing->Submit(1);
+        if (ret < 0 && ret != -EAGAIN && ret != -EBUSY) {
+            LOG_WARNING(sLogger, ("wait io_uring read failed", ret)("action", "fallback to pread"));
+            disable();
+        }
+    }
+#endif
+    return false;
+}
+
+void AsyncReadEngine::disable() {
+#ifdef LOGTAIL_HAS_IO_URING
+    bool hasInflight = false;
+    for (auto& item : mRequests) {
+        if (item.second->state != State::DONE) {
+            // Kernel may still write to the buffer, so the buffer and the ring are leaked on purpose.
+            item.second->sourceBuffer.release();
+            hasInflight = true;
+        }
+    }
+    if (hasInflight) {
+        mRing.release();
+    } else {
+        mRing.reset();
+    }
+#endif
+    mEnabled = false;
+    mRequests.clear();
+    mOwnerIndex.clear();
+}
+
+} // namespace logtail
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/IoUring.h"
+#include "common/memory/SourceBuffer.h"
+
+namespace logtail {
+
+// AsyncReadEngine reads the next chunk of many log files ahead of time through io_uring, so that
+// a slow disk or a cold page cache on one file does not stall reading of other files.
+//
+// Reads are prefetched when a reader still has data but has to give up its time slice, submitted
+// together by the LogInput loop, and consumed by the reader on its next turn (LogFileReader::ReadUTF8),
+// which then does RemoveLastIncompleteLog and event group creation as usual. Data is read into a
+// SourceBuffer which is handed over to the LogBuffer without copy.
+//
+// If io_uring is not available, or the prefetched read does not match the reader state any more,
+// the reader falls back to pread.
+//
+// It is NOT thread-safe, only LogInput thread should use it.
+class AsyncReadEngine {
+public:
+    struct Completion {
+        std::unique_ptr<SourceBuffer> sourceBuffer;
+        // Beginning of the buffer, the first @reserved bytes are reserved for reader cache.
+        char* data = nullptr;
+        // Bytes read from file.
+        size_t size = 0;
+    };
+
+    AsyncReadEngine() = default;
+    ~AsyncReadEngine();
+    AsyncReadEngine(const AsyncReadEngine&) = delete;
+    AsyncReadEngine& operator=(const AsyncReadEngine&) = delete;
+
+    static AsyncReadEngine* GetInstance() {
+        static AsyncReadEngine* sPtr = new AsyncReadEngine();
+        return sPtr;
+    }
+
+    // IsEnabled returns true if flag is on and io_uring read is available, the ring is set up on first call.
+    bool IsEnabled();
+
+    // Prefetch queues a read of @size bytes at @offset of @fd for @owner, data is stored after
+    // @reserved bytes of the buffer. Only one read is kept for each owner, the older one is canceled.
+    // @return false if the read can not be queued, caller should read synchronously later.
+    bool Prefetch(const void* owner, int fd, int64_t offset, size_t reserved, size_t size);
+
+    // Submit hands over all queued reads to kernel without waiting.
+    void Submit();
+
+    // ShouldDefer returns true if the read of @owner is still in flight and has never been deferred,
+    // so the caller can handle other files first. A read is deferred once at most.
+    bool ShouldDefer(const void* owner);
+
+    // Take waits for the read of @owner and moves out its result if it matches @fd, @offset and @reserved,
+    // and at least @minSize bytes are read.
+    // @return false if there is no usable read, the read is dropped anyway.
+    bool Take(const void* owner, int fd, int64_t offset, size_t reserved, size_t minSize, Completion& completion);
+
+    // Cancel drops the read of @owner, e.g. the file is being closed or the reader is destructed.
+    void Cancel(const void* owner);
+
+    size_t GetInflightCount() const { return mRequests.size(); }
+
+private:
+    enum class State { QUEUED, SUBMITTED, DONE };
+
+    struct Request {
+        // nullptr if canceled, the request is kept until kernel completes it.
+        const void* owner = nullptr;
+        int fd = -1;
+        int64_t offset = 0;
+        size_t reserved = 0;
+        std::unique_ptr<SourceBuffer> sourceBuffer;
+        char* data = nullptr;
+        State state = State::QUEUED;
+        int32_t res = 0;
+        bool deferred = false;
+    };
+
+    void reap();
+    // @return false if the ring is broken.
+    bool waitFor(uint64_t id);
+    void dropRequest(uint64_t id);
+    void disable();
+
+#ifdef LOGTAIL_HAS_IO_URING
+    std::unique_ptr<IoUring> mRing;
+#endif
+    bool mInited = false;
+    bool mEnabled = false;
+    uint64_t mNextId = 1;
+    std::unordered_map<uint64_t, std::unique_ptr<Request>> mRequests;
+    std::unordered_map<const void*, uint64_t> mOwnerIndex;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class AsyncReadEngineUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -39,10 +39,12 @@
 #include "common/RandomUtil.h"
 #include "common/TimeUtil.h"
 #include "common/UUIDUtil.h"
+#include "common/Utf8Util.h"
 #include "file_server/ConfigManager.h"
 #include "file_server/FileServer.h"
 #include "file_server/event/BlockEventManager.h"
 #include "file_server/event_handler/LogInput.h"
+#include "file_server/reader/AsyncReadEngine.h"
 #include "file_server/reader/GloablFileDescriptorManager.h"
 #include "file_server/reader/JsonLogFileReader.h"
 #include "logger/Logger.h"
@@ -73,6 +75,20 @@ DEFINE_FLAG_INT32(max_fix_pos_bytes, "", 128 * 1024);
 DEFINE_FLAG_INT32(force_release_deleted_file_fd_timeout,
                   "force release fd if file is deleted after specified seconds, no matter read to end or not",
                   -1);
+DEFINE_FLAG_BOOL(enable_reader_catch_up_mode, "advise kernel to read ahead when reader has a large backlog", true);
+DEFINE_FLAG_INT32(reader_catch_up_min_backlog_bytes,
+                  "enter catch-up mode when unread bytes of file exceed this",
+                  256 * 1024 * 1024);
+DEFINE_FLAG_INT32(reader_catch_up_readahead_bytes,
+                  "bytes to read ahead in catch-up mode, also leave catch-up mode when unread bytes are less",
+                  16 * 1024 * 1024);
+DEFINE_FLAG_BOOL(reader_catch_up_drop_cache,
+                 "drop consumed pages from page cache in catch-up mode, do not enable if the file is read by others",
+                 false);
+DEFINE_FLAG_BOOL(enable_reader_line_index,
+                 "index line positions when generating event groups, so that split processors need not rescan. It "
+                 "moves the scan from processor threads to the reader thread, see split_log_string_benchmark",
+                 false);
 DECLARE_FLAG_INT32(reader_close_unused_file_time);
 DECLARE_FLAG_INT32(logtail_alarm_interval);
 
@@ -730,8 +746,8 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
         for (size_t endPs = 0; endPs < readSizeReal - 1; ++endPs) {
             if (readBuf[endPs] == '\n') {
                 LineInfo line = GetLastLine(StringView(readBuf, readSizeReal - 1), endPs, true);
-                if (BoostRegexSearch(
-                        line.data.data(), line.data.size(), *mMultilineConfig.first->GetStartPatternReg(), exception)) {
+                if (mMultilineConfig.first->GetStartPatternReg()->Search(
+                        line.data.data(), line.data.size(), exception)) {
                     mLastFilePos += line.lineBegin;
                     mCache.clear();
                     free(readBuf);
@@ -1156,6 +1172,10 @@ bool LogFileReader::CloseTimeoutFilePtr(int32_t curTime) {
 }
 
 void LogFileReader::CloseFilePtr() {
+    if (mAsyncReadPending) {
+        AsyncReadEngine::GetInstance()->Cancel(this);
+        mAsyncReadPending = false;
+    }
     if (mLogFileOp.IsOpen()) {
         mCache.shrink_to_fit();
         LOG_DEBUG(sLogger, ("start close LogFileReader", mHostLogPath));
@@ -1459,6 +1479,8 @@ bool LogFileReader::GetRawData(LogBuffer& logBuffer, int64_t fileSize, bool tryR
         return false;
     }
 
+    updateCatchUpMode(fileSize);
+
     bool moreData = false;
     if (mReaderConfig.first->mFileEncoding == FileReaderOptions::Encoding::GBK)
         ReadGBK(logBuffer, fileSize, moreData, tryRollback);
@@ -1568,6 +1590,63 @@ void LogFileReader::setExactlyOnceCheckpointAfterRead(size_t readSize) {
     cpt.set_read_length(readSize);
 }
 
+void LogFileReader::updateCatchUpMode(int64_t fileSize) {
+#if defined(__linux__)
+    if (!BOOL_FLAG(enable_reader_catch_up_mode) || !mLogFileOp.IsOpen()) {
+        return;
+    }
+    const int fd = mLogFileOp.GetFd();
+    // advice is bound to the opened file, reset if file is reopened or truncated
+    const bool truncated = fileSize < mCatchUpFileSize || mLastFilePos < mCatchUpFilePos;
+    mCatchUpFileSize = fileSize;
+    mCatchUpFilePos = mLastFilePos;
+    if (mCatchUpMode && (fd != mCatchUpFd || truncated)) {
+        mCatchUpMode = false;
+    }
+    const int64_t backlog = fileSize - mLastFilePos;
+    const int64_t readahead = std::max(INT32_FLAG(reader_catch_up_readahead_bytes), 1);
+    if (!mCatchUpMode) {
+        if (backlog < INT32_FLAG(reader_catch_up_min_backlog_bytes) || backlog <= readahead) {
+            return;
+        }
+        mCatchUpMode = true;
+        mCatchUpFd = fd;
+        mReadaheadEnd = mLastFilePos;
+        mDropCacheEnd = mLastFilePos & ~static_cast<int64_t>(4095);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        LOG_INFO(sLogger,
+                 ("enter catch-up mode, backlog", backlog)("project", GetProject())("logstore", GetLogstore())(
+                     "config", GetConfigName())("log reader queue name", mHostLogPath)(
+                     "file device", mDevInode.dev)("file inode", mDevInode.inode)("file size", fileSize)(
+                     "last file position", mLastFilePos));
+    } else if (backlog <= readahead) {
+        mCatchUpMode = false;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_NORMAL);
+        LOG_INFO(sLogger,
+                 ("leave catch-up mode, backlog", backlog)("project", GetProject())("logstore", GetLogstore())(
+                     "config", GetConfigName())("log reader queue name", mHostLogPath)(
+                     "file device", mDevInode.dev)("file inode", mDevInode.inode)("file size", fileSize)(
+                     "last file position", mLastFilePos));
+        return;
+    }
+
+    // keep a window read ahead, advise every half window to save syscalls
+    if (mReadaheadEnd - mLastFilePos < readahead / 2) {
+        const int64_t begin = std::max(mReadaheadEnd, mLastFilePos);
+        const int64_t end = std::min(mLastFilePos + readahead, fileSize);
+        if (end > begin) {
+            posix_fadvise(fd, begin, end - begin, POSIX_FADV_WILLNEED);
+            mReadaheadEnd = end;
+        }
+    }
+    if (BOOL_FLAG(reader_catch_up_drop_cache) && mLastFilePos - mDropCacheEnd >= readahead) {
+        const int64_t end = mLastFilePos & ~static_cast<int64_t>(4095);
+        posix_fadvise(fd, mDropCacheEnd, end - mDropCacheEnd, POSIX_FADV_DONTNEED);
+        mDropCacheEnd = end;
+    }
+#endif
+}
+
 void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback) {
     char* stringBuffer = nullptr;
     size_t nbytes = 0;
@@ -1603,17 +1682,29 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        StringBuffer stringMemory
-            = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
+        AsyncReadEngine::Completion prefetched;
+        if (mAsyncReadPending) {
+            mAsyncReadPending = false;
+            AsyncReadEngine::GetInstance()->Take(
+                this, mLogFileOp.GetFd(), GetLastReadPos(), lastCacheSize, READ_BYTE - lastCacheSize, prefetched);
+        }
+        // allocate modifiable buffer, or use the prefetched one
+        stringBuffer = prefetched.sourceBuffer ? prefetched.data
+                                               : logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE).data;
         if (lastCacheSize) {
             READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
         }
         TruncateInfo* truncateInfo = nullptr;
         int64_t lastReadPos = GetLastReadPos();
-        nbytes = READ_BYTE
-            ? ReadFile(mLogFileOp, stringMemory.data + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
-            : 0UL;
-        stringBuffer = stringMemory.data;
+        if (prefetched.sourceBuffer) {
+            // file may grow after prefetching, drop the part beyond file size got last time
+            nbytes = std::min(prefetched.size, READ_BYTE);
+            stringBuffer[lastCacheSize + nbytes] = '\0';
+            logBuffer.sourcebuffer = std::move(prefetched.sourceBuffer);
+        } else {
+            nbytes = READ_BYTE ? ReadFile(mLogFileOp, stringBuffer + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
+                               : 0UL;
+        }
         bool allowRollback = true;
         // Only when there is no new log and not try rollback, then force read
         if (!tryRollback && nbytes == 0) {
@@ -2009,20 +2100,16 @@ LogFileReader::RemoveLastIncompleteLog(char* buffer, int32_t size, int32_t& roll
             LineInfo content = GetLastLine(StringView(buffer, size), endPs, false);
             if (mMultilineConfig.first->GetEndPatternReg()) {
                 // start + end, continue + end, end
-                if (BoostRegexSearch(content.data.data(),
-                                     content.data.size(),
-                                     *mMultilineConfig.first->GetEndPatternReg(),
-                                     exception)) {
+                if (mMultilineConfig.first->GetEndPatternReg()->Search(
+                        content.data.data(), content.data.size(), exception)) {
                     // Ensure the end line is complete
                     if (buffer[content.lineEnd] == '\n') {
                         return content.lineEnd + 1;
                     }
                 }
             } else if (mMultilineConfig.first->GetStartPatternReg()
-                       && BoostRegexSearch(content.data.data(),
-                                           content.data.size(),
-                                           *mMultilineConfig.first->GetStartPatternReg(),
-                                           exception)) {
+                       && mMultilineConfig.first->GetStartPatternReg()->Search(
+                              content.data.data(), content.data.size(), exception)) {
                 // start + continue, start
                 rollbackLineFeedCount += content.rollbackLineFeedCount;
                 // Keep all the buffer if rollback all
@@ -2056,7 +2143,6 @@ LineInfo LogFileReader::GetLastLine(StringView buffer, int32_t end, bool needSin
 }
 
 size_t LogFileReader::AlignLastCharacter(char* buffer, size_t size) {
-    int n = 0;
     int endPs = size - 1;
     if (buffer[endPs] == '\n') {
         return size;
@@ -2082,40 +2168,8 @@ size_t LogFileReader::AlignLastCharacter(char* buffer, size_t size) {
         }
         return size - 1;
     } else {
-        // UTF8 encoding rules:
-        // 1. For single byte character, the top bit is 0.
-        // 2. For N (N > 1) bytes character, the top N bit of the first byte is 1. The first and second bits of the
-        // following bytes are 10.
-        while (endPs >= 0) {
-            char ch = buffer[endPs];
-            if ((ch & 0x80) == 0) { // 1 bytes character, 0x80 -> 10000000
-                n = 1;
-                break;
-            } else if ((ch & 0xE0) == 0xC0) { // 2 bytes character, 0xE0 -> 11100000, 0xC0 -> 11000000
-                n = 2;
-                break;
-            } else if ((ch & 0xF0) == 0xE0) { // 3 bytes character, 0xF0 -> 11110000, 0xE0 -> 11100000
-                n = 3;
-                break;
-            } else if ((ch & 0xF8) == 0xF0) { // 4 bytes character, 0xF8 -> 11111000, 0xF0 -> 11110000
-                n = 4;
-                break;
-            } else if ((ch & 0xFC) == 0xF8) { // 5 bytes character, 0xFC -> 11111100, 0xF8 -> 11111000
-                n = 5;
-                break;
-            } else if ((ch & 0xFE) == 0xFC) { // 6 bytes character, 0xFE -> 11111110, 0xFC -> 11111100
-                n = 6;
-                break;
-            }
-            endPs--;
-        }
-        if (endPs - 1 + n >= (int)size) {
-            return endPs;
-        } else {
-            return size;
-        }
+        return AlignUtf8Tail(buffer, size);
     }
-    return 0;
 }
 
 std::unique_ptr<Event> LogFileReader::CreateFlushTimeoutEvent() {
@@ -2140,8 +2194,35 @@ void LogFileReader::ReportMetrics(uint64_t readSize) {
     }
 }
 
+void LogFileReader::PrefetchNextRead() {
+    // exactly once replays checkpoints with specified length, GBK is converted after read, and container
+    // stdio reads BOM first, they all read synchronously.
+    if (!mLogFileOp.IsOpen() || mEOOption || mReaderConfig.first->mFileEncoding == FileReaderOptions::Encoding::GBK
+        || (mReaderConfig.first->mInputType == FileReaderOptions::InputType::InputContainerStdio
+            && !mHasReadContainerBom)) {
+        return;
+    }
+    AsyncReadEngine* engine = AsyncReadEngine::GetInstance();
+    if (!engine->IsEnabled()) {
+        return;
+    }
+    const size_t cacheSize = mCache.size();
+    const int64_t offset = GetLastReadPos();
+    if (cacheSize >= BUFFER_SIZE || offset >= mLastFileSize) {
+        return;
+    }
+    mAsyncReadPending = engine->Prefetch(this, mLogFileOp.GetFd(), offset, cacheSize, BUFFER_SIZE - cacheSize);
+}
+
+bool LogFileReader::ShouldDeferRead() {
+    return mAsyncReadPending && AsyncReadEngine::GetInstance()->ShouldDefer(this);
+}
+
 
 LogFileReader::~LogFileReader() {
+    if (mAsyncReadPending) {
+        AsyncReadEngine::GetInstance()->Cancel(this);
+    }
     // if (mLogBeginRegPtr != NULL) {
     //     delete mLogBeginRegPtr;
     //     mLogBeginRegPtr = NULL;
@@ -2475,9 +2556,37 @@ PipelineEventGroup LogFileReader::GenerateEventGroup(LogFileReaderPtr reader, Lo
     event->SetContentNoCopy(DEFAULT_CONTENT_KEY, logBuffer->rawBuffer);
     event->SetPosition(logBuffer->readOffset, logBuffer->readLength);
 
+    if (BOOL_FLAG(enable_reader_line_index)) {
+        // only ProcessorSplitLogStringNative uses the index. It is the first inner processor of container stdio, which
+        // splits by \n first, and of file input unless logs are split by multiline patterns.
+        bool isContainerStdio
+            = reader->mReaderConfig.first->mInputType == FileReaderOptions::InputType::InputContainerStdio;
+        bool isJson = reader->mReaderConfig.second->RequiringJsonReader();
+        if (isContainerStdio || isJson || !reader->mMultilineConfig.first->IsMultiline()) {
+            char splitChar = isJson && !isContainerStdio ? '\0' : '\n';
+            group.SetLineIndex(BuildLineIndex(logBuffer->rawBuffer, splitChar));
+        }
+    }
     return group;
 }
 
+std::unique_ptr<LineIndex> LogFileReader::BuildLineIndex(StringView buffer, char splitChar) {
+    if (buffer.size() > std::numeric_limits<uint32_t>::max()) {
+        return nullptr;
+    }
+    std::unique_ptr<LineIndex> index(new LineIndex);
+    index->mBuffer = buffer;
+    index->mSplitChar = splitChar;
+    const char* begin = buffer.data();
+    const char* end = begin + buffer.size();
+    const char* pos = begin;
+    while ((pos = static_cast<const char*>(memchr(pos, splitChar, end - pos))) != nullptr) {
+        index->mSplitPositions.push_back(static_cast<uint32_t>(pos - begin));
+        ++pos;
+    }
+    return index;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void LogFileReader::UpdateReaderManual() {
     if (mLogFileOp.IsOpen()) {
@@ -180,6 +180,8 @@ public:
                                               bool forceFromBeginning);
 
     static PipelineEventGroup GenerateEventGroup(LogFileReaderPtr reader, LogBuffer* logBuffer);
+    // BuildLineIndex returns positions of @splitChar in @buffer, or nullptr if @buffer is too large to be indexed.
+    static std::unique_ptr<LineIndex> BuildLineIndex(StringView buffer, char splitChar);
 
     LogFileReader(const std::string& hostLogPathDir,
                   const std::string& hostLogPathFile,
@@ -444,6 +446,13 @@ public:
     void SetMetrics();
     void ReportMetrics(uint64_t readSize);
 
+    // PrefetchNextRead reads the next chunk asynchronously if async read engine is enabled, the chunk
+    // will be consumed by next ReadLog.
+    void PrefetchNextRead();
+    // ShouldDeferRead returns true if the prefetched chunk is not ready yet, and reading of this file
+    // should be put off once to read other files.
+    bool ShouldDeferRead();
+
 protected:
     bool GetRawData(LogBuffer& logBuffer, int64_t fileSize, bool tryRollback = true);
     void ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback = true);
@@ -508,6 +517,8 @@ protected:
     // bool mMarkOffsetFlag = false;
     // std::string mTimeFormat; // for backward reading
     LogFileOperator mLogFileOp; // encapsulate fuse & non-fuse mode
+    // true if the next chunk is being read by AsyncReadEngine
+    bool mAsyncReadPending = false;
     // std::string mFuseTrimedFilename;
     LogFileReaderPtrArray* mReaderArray = nullptr;
     // uint64_t mLogstoreKey;
@@ -601,6 +612,22 @@ private:
     // Update current checkpoint's read offset and length after success read.
     void setExactlyOnceCheckpointAfterRead(size_t readSize);
 
+    // Catch-up mode is entered when the backlog of the file is large (new config on an existing big file,
+    // or recovering after downtime). In this mode, kernel is told to read the file sequentially and the
+    // next window is read ahead, so that reading does not wait for disk chunk by chunk. Consumed pages can
+    // optionally be dropped from page cache. It is left when the reader is near EOF.
+    void updateCatchUpMode(int64_t fileSize);
+
+    bool mCatchUpMode = false;
+    int mCatchUpFd = -1;
+    // [mLastFilePos, mReadaheadEnd) has been advised to read ahead.
+    int64_t mReadaheadEnd = 0;
+    // Pages before mDropCacheEnd have been dropped from page cache.
+    int64_t mDropCacheEnd = 0;
+    // File size and position seen by the last update, to detect truncation.
+    int64_t mCatchUpFileSize = 0;
+    int64_t mCatchUpFilePos = 0;
+
     // Return primary key of current reader by combining meta.
     //
     // Conflict resolve: file signature will be stored in primary checkpoint.
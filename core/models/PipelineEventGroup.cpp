@@ -18,7 +18,7 @@
 
 #include <sstream>
 
-#include "common/HashUtil.h"
+#include "common/xxhash/xxhash.h"
 #include "logger/Logger.h"
 #include "plugin/processor/inner/ProcessorParseContainerLogNative.h"
 
@@ -30,7 +30,11 @@ PipelineEventGroup::PipelineEventGroup(PipelineEventGroup&& rhs) noexcept
     : mMetadata(std::move(rhs.mMetadata)),
       mTags(std::move(rhs.mTags)),
       mEvents(std::move(rhs.mEvents)),
-      mSourceBuffer(std::move(rhs.mSourceBuffer)) {
+      mSourceBuffer(std::move(rhs.mSourceBuffer)),
+      mLineIndex(std::move(rhs.mLineIndex)),
+      mTagsHash(rhs.mTagsHash),
+      mTagsHashValid(rhs.mTagsHashValid) {
+    rhs.mTagsHashValid = false;
     for (auto& item : mEvents) {
         item->ResetPipelineEventGroup(this);
     }
@@ -42,6 +46,10 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
         mTags = std::move(rhs.mTags);
         mEvents = std::move(rhs.mEvents);
         mSourceBuffer = std::move(rhs.mSourceBuffer);
+        mLineIndex = std::move(rhs.mLineIndex);
+        mTagsHash = rhs.mTagsHash;
+        mTagsHashValid = rhs.mTagsHashValid;
+        rhs.mTagsHashValid = false;
         for (auto& item : mEvents) {
             item->ResetPipelineEventGroup(this);
         }
@@ -54,6 +62,8 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     res.mMetadata = mMetadata;
     res.mTags = mTags;
     res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
+    res.mTagsHash = mTagsHash;
+    res.mTagsHashValid = mTagsHashValid;
     for (auto& event : mEvents) {
         res.mEvents.emplace_back(event.Copy());
         res.mEvents.back()->ResetPipelineEventGroup(&res);
@@ -111,6 +121,9 @@ bool PipelineEventGroup::HasMetadata(EventGroupMetaKey key) const {
 }
 void PipelineEventGroup::SetMetadataNoCopy(EventGroupMetaKey key, StringView val) {
     mMetadata[key] = val;
+    if (key == EventGroupMetaKey::SOURCE_ID) {
+        mTagsHashValid = false;
+    }
 }
 
 StringView PipelineEventGroup::GetMetadata(EventGroupMetaKey key) const {
@@ -123,6 +136,9 @@ StringView PipelineEventGroup::GetMetadata(EventGroupMetaKey key) const {
 
 void PipelineEventGroup::DelMetadata(EventGroupMetaKey key) {
     mMetadata.erase(key);
+    if (key == EventGroupMetaKey::SOURCE_ID) {
+        mTagsHashValid = false;
+    }
 }
 
 void PipelineEventGroup::SetTag(StringView key, StringView val) {
@@ -147,6 +163,7 @@ bool PipelineEventGroup::HasTag(StringView key) const {
 
 void PipelineEventGroup::SetTagNoCopy(StringView key, StringView val) {
     mTags.Insert(key, val);
+    mTagsHashValid = false;
 }
 
 StringView PipelineEventGroup::GetTag(StringView key) const {
@@ -159,16 +176,28 @@ StringView PipelineEventGroup::GetTag(StringView key) const {
 
 void PipelineEventGroup::DelTag(StringView key) {
     mTags.Erase(key);
+    mTagsHashValid = false;
 }
 
 size_t PipelineEventGroup::GetTagsHash() const {
-    size_t seed = 0;
+    if (mTagsHashValid) {
+        return mTagsHash;
+    }
+    // each string is hashed separately with the previous hash as seed, so that boundaries between keys and values
+    // are part of the hash
+    XXH64_hash_t seed = 0;
     for (const auto& item : mTags.mInner) {
-        HashCombine(seed, hash<string>{}(item.first.to_string()));
-        HashCombine(seed, hash<string>{}(item.second.to_string()));
+        seed = XXH3_64bits_withSeed(item.first.data(), item.first.size(), seed);
+        seed = XXH3_64bits_withSeed(item.second.data(), item.second.size(), seed);
+    }
+    StringView sourceId = GetMetadata(EventGroupMetaKey::SOURCE_ID);
+    seed = XXH3_64bits_withSeed(sourceId.data(), sourceId.size(), seed);
+    mTagsHash = static_cast<size_t>(seed);
+    if (mTagsHash == 0) {
+        mTagsHash = 1;
     }
-    HashCombine(seed, hash<string>{}(GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string()));
-    return seed;
+    mTagsHashValid = true;
+    return mTagsHash;
 }
 
 size_t PipelineEventGroup::DataSize() const {
@@ -179,6 +208,14 @@ size_t PipelineEventGroup::DataSize() const {
     return eventsSize + mTags.DataSize();
 }
 
+const LineIndex* PipelineEventGroup::GetLineIndex(StringView buffer, char splitChar) const {
+    if (!mLineIndex || mLineIndex->mSplitChar != splitChar || mLineIndex->mBuffer.data() != buffer.data()
+        || mLineIndex->mBuffer.size() != buffer.size()) {
+        return nullptr;
+    }
+    return mLineIndex.get();
+}
+
 bool PipelineEventGroup::IsReplay() const {
     return mExactlyOnceCheckpoint != nullptr && mExactlyOnceCheckpoint->IsComplete();
 }
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "checkpoint/RangeCheckpoint.h"
 #include "common/Constants.h"
@@ -64,6 +65,15 @@ enum class EventGroupMetaKey {
 using GroupMetadata = std::map<EventGroupMetaKey, StringView>;
 using GroupTags = std::map<StringView, StringView>;
 
+// LineIndex records the positions of split chars in the content of the only event of a group, so that split
+// processors can materialize lines without scanning the content again. It is built by the file reader, dropped once
+// the content is split and not copied with the group.
+struct LineIndex {
+    StringView mBuffer;
+    char mSplitChar = '\n';
+    std::vector<uint32_t> mSplitPositions;
+};
+
 // DeepCopy is required if we want to support no-linear topology
 // We cannot just use default copy constructor as it won't deep copy PipelineEvent pointed in Events vector.
 using EventsContainer = std::vector<PipelineEventPtr>;
@@ -97,7 +107,10 @@ public:
     bool HasMetadata(EventGroupMetaKey key) const;
     void SetMetadataNoCopy(EventGroupMetaKey key, StringView val);
     void DelMetadata(EventGroupMetaKey key);
-    void SetAllMetadata(const GroupMetadata& other) { mMetadata = other; }
+    void SetAllMetadata(const GroupMetadata& other) {
+        mMetadata = other;
+        mTagsHashValid = false;
+    }
 
     void SetTag(StringView key, StringView val);
     void SetTag(const std::string& key, const std::string& val);
@@ -105,11 +118,18 @@ public:
     void SetTagNoCopy(const StringBuffer& key, const StringBuffer& val);
     StringView GetTag(StringView key) const;
     const GroupTags& GetTags() const { return mTags.mInner; };
-    SizedMap& GetSizedTags() { return mTags; };
+    // the caller may modify tags through the returned reference, so the cached tags hash is dropped
+    SizedMap& GetSizedTags() {
+        mTagsHashValid = false;
+        return mTags;
+    };
     bool HasTag(StringView key) const;
     void SetTagNoCopy(StringView key, StringView val);
     void DelTag(StringView key);
 
+    // GetTagsHash returns the hash of all tags and the SOURCE_ID metadata, which is used as the batching key. It is
+    // computed without allocation and cached until tags or metadata are modified. 0 is never returned, since it is
+    // reserved for the group level queue in Batcher.
     size_t GetTagsHash() const;
 
     void SetExactlyOnceCheckpoint(const RangeCheckpointPtr& checkpoint) { mExactlyOnceCheckpoint = checkpoint; }
@@ -118,6 +138,11 @@ public:
 
     size_t DataSize() const;
 
+    void SetLineIndex(std::unique_ptr<LineIndex>&& index) { mLineIndex = std::move(index); }
+    // GetLineIndex returns the line index of @buffer split by @splitChar, or nullptr if there is no such index.
+    const LineIndex* GetLineIndex(StringView buffer, char splitChar) const;
+    void ResetLineIndex() { mLineIndex.reset(); }
+
 #ifdef APSARA_UNIT_TEST_MAIN
     // for debug and test
     Json::Value ToJson(bool enableEventMeta = false) const;
@@ -132,6 +157,9 @@ private:
     EventsContainer mEvents;
     std::shared_ptr<SourceBuffer> mSourceBuffer;
     RangeCheckpointPtr mExactlyOnceCheckpoint;
+    std::unique_ptr<LineIndex> mLineIndex;
+    mutable size_t mTagsHash = 0;
+    mutable bool mTagsHashValid = false;
 };
 
 } // namespace logtail
@@ -28,13 +28,19 @@ namespace logtail {
 class SizedMap {
 public:
     void Insert(StringView key, StringView val) {
-        auto iter = mInner.find(key);
-        if (iter != mInner.end()) {
+        // tags are often set in key order, e.g. when copied from another map, so appending is tried before searching
+        if (mInner.empty() || mInner.rbegin()->first < key) {
+            mAllocatedSize += key.size() + val.size();
+            mInner.emplace_hint(mInner.end(), key, val);
+            return;
+        }
+        auto iter = mInner.lower_bound(key);
+        if (iter != mInner.end() && iter->first == key) {
             mAllocatedSize += val.size() - iter->second.size();
             iter->second = val;
         } else {
             mAllocatedSize += key.size() + val.size();
-            mInner[key] = val;
+            mInner.emplace_hint(iter, key, val);
         }
     }
 
@@ -146,4 +146,8 @@ const std::string METRIC_FLUSHER_QUOTA_ERROR_TOTAL = "flusher_quota_error_total"
 const std::string METRIC_FLUSHER_RETRIES_TOTAL = "flusher_retries_total";
 const std::string METRIC_FLUSHER_RETRIES_ERROR_TOTAL = "flusher_retries_error_total";
 
+// concurrency limiter metrics
+const std::string METRIC_CONCURRENCY_LIMITER_LIMIT = "concurrency_limiter_limit";
+const std::string METRIC_CONCURRENCY_LIMITER_IN_SENDING_TOTAL = "concurrency_limiter_in_sending_total";
+
 } // namespace logtail
@@ -139,4 +139,8 @@ extern const std::string METRIC_FLUSHER_QUOTA_ERROR_TOTAL;
 extern const std::string METRIC_FLUSHER_RETRIES_TOTAL;
 extern const std::string METRIC_FLUSHER_RETRIES_ERROR_TOTAL;
 
+// concurrency limiter metrics
+extern const std::string METRIC_CONCURRENCY_LIMITER_LIMIT;
+extern const std::string METRIC_CONCURRENCY_LIMITER_IN_SENDING_TOTAL;
+
 } // namespace logtail
@@ -56,6 +56,9 @@ namespace observer {
     extern std::string kProtocol;
     extern std::string kVersion;
     extern std::string kTdigestLatency;
+    extern std::string kLatencyP50Ns;
+    extern std::string kLatencyP90Ns;
+    extern std::string kLatencyP99Ns;
 
 } // namespace observer
 } // namespace logtail
@@ -19,6 +19,7 @@
 #include "Monitor.h"
 #include "iostream"
 #include "monitor/LogtailAlarm.h"
+#include <atomic>
 #include <cstdint>
 #include <sstream>
 
@@ -83,9 +84,12 @@ private:
 struct ConnectionMetaStatistic {
     uint16_t mGetSocketInfoCount{0};
     uint16_t mGetSocketInfoFailCount{0};
-    uint16_t mGetNetlinkProberCount{0};
-    uint16_t mGetNetlinkProberFailCount{0};
-    uint16_t mFetchNetlinkCount{0};
+    // updated by the socket scanner thread.
+    std::atomic<uint16_t> mGetNetlinkProberCount{0};
+    std::atomic<uint16_t> mGetNetlinkProberFailCount{0};
+    std::atomic<uint16_t> mFetchNetlinkCount{0};
+    std::atomic<uint32_t> mScanRoundCount{0};
+    std::atomic<uint32_t> mScanFdDirCount{0};
 
     static ConnectionMetaStatistic* GetInstance() {
         static auto ptr = new ConnectionMetaStatistic();
@@ -101,9 +105,12 @@ struct ConnectionMetaStatistic {
         static auto sMonitor = LogtailMonitor::GetInstance();
         sMonitor->UpdateMetric("observer_connmeta_socket_get_count", mGetSocketInfoCount);
         sMonitor->UpdateMetric("observer_connmeta_socket_get_fail_count", mGetSocketInfoFailCount);
-        sMonitor->UpdateMetric("observer_connmeta_socket_create_prober_count", mGetNetlinkProberCount);
-        sMonitor->UpdateMetric("observer_connmeta_socket_create_prober_fail_count", mGetNetlinkProberFailCount);
-        sMonitor->UpdateMetric("observer_connmeta_socket_fetch_netlink_count", mFetchNetlinkCount);
+        sMonitor->UpdateMetric("observer_connmeta_socket_create_prober_count", mGetNetlinkProberCount.load());
+        sMonitor->UpdateMetric("observer_connmeta_socket_create_prober_fail_count",
+                               mGetNetlinkProberFailCount.load());
+        sMonitor->UpdateMetric("observer_connmeta_socket_fetch_netlink_count", mFetchNetlinkCount.load());
+        sMonitor->UpdateMetric("observer_connmeta_socket_scan_round_count", mScanRoundCount.load());
+        sMonitor->UpdateMetric("observer_connmeta_socket_scan_fd_dir_count", mScanFdDirCount.load());
         doClear();
     }
 
@@ -112,7 +119,8 @@ struct ConnectionMetaStatistic {
            << " mGetSocketInfoFailCount: " << statistic.mGetSocketInfoFailCount
            << " mGetNetlinkProberCount: " << statistic.mGetNetlinkProberCount
            << " mGetNetlinkProberFailCount: " << statistic.mGetNetlinkProberFailCount
-           << " mFetchNetlinkCount: " << statistic.mFetchNetlinkCount;
+           << " mFetchNetlinkCount: " << statistic.mFetchNetlinkCount
+           << " mScanRoundCount: " << statistic.mScanRoundCount << " mScanFdDirCount: " << statistic.mScanFdDirCount;
         return os;
     }
 
@@ -131,6 +139,8 @@ private:
         mGetNetlinkProberCount = 0;
         mGetNetlinkProberFailCount = 0;
         mFetchNetlinkCount = 0;
+        mScanRoundCount = 0;
+        mScanFdDirCount = 0;
     }
 };
 
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <dirent.h>
+#include <unistd.h>
 #include <sys/socket.h>
 #include <linux/sock_diag.h>
 #include <linux/unix_diag.h>
@@ -24,12 +26,17 @@
 #include "LogtailAlarm.h"
 #include "MachineInfoUtil.h"
 #include "DynamicLibHelper.h"
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(sls_observer_network_conn_scan_interval_ms,
+                  "SLS Observer NetWork interval of scanning socket fds and connections",
+                  1000);
 
 namespace logtail {
 
-uint32_t ReadInodeNum(const std::string& path, const std::string& prefix, int8_t& errorCode) {
-    size_t pathLen = path.size(), prefixLen = prefix.size();
-    if (pathLen - prefixLen < 3 || path.compare(0, prefixLen, prefix)) {
+static uint32_t
+ReadInodeNum(const char* path, size_t pathLen, const char* prefix, size_t prefixLen, int8_t& errorCode) {
+    if (pathLen < prefixLen + 3 || memcmp(path, prefix, prefixLen) != 0) {
         errorCode = -1;
         return 0;
     }
@@ -38,7 +45,11 @@ uint32_t ReadInodeNum(const std::string& path, const std::string& prefix, int8_t
         return 0;
     }
     errorCode = 0;
-    return (uint32_t)std::strtol(path.c_str() + prefixLen + 1, NULL, 10);
+    return (uint32_t)std::strtol(path + prefixLen + 1, NULL, 10);
+}
+
+uint32_t ReadInodeNum(const std::string& path, const std::string& prefix, int8_t& errorCode) {
+    return ReadInodeNum(path.data(), path.size(), prefix.data(), prefix.size(), errorCode);
 }
 
 uint32_t ReadNetworkNsInodeNum(const std::string& path, int8_t& errorCode) {
@@ -52,6 +63,253 @@ uint32_t ReadSocketInodeNum(const std::string& path, int8_t& errorCode) {
 }
 
 
+// readlink the socket or namespace link, and parse the inode number in it.
+static uint32_t ReadLinkInodeNum(int dirFd, const char* name, const char* prefix, size_t prefixLen, int8_t& errorCode) {
+    char buf[64];
+    ssize_t len = readlinkat(dirFd, name, buf, sizeof(buf) - 1);
+    if (len <= 0) {
+        errorCode = -3;
+        return 0;
+    }
+    buf[len] = '\0';
+    return ReadInodeNum(buf, len, prefix, prefixLen, errorCode);
+}
+
+static bool ParsePid(const char* name, uint32_t& pid) {
+    if (name[0] < '1' || name[0] > '9') {
+        return false;
+    }
+    char* end = nullptr;
+    pid = (uint32_t)std::strtoul(name, &end, 10);
+    return *end == '\0';
+}
+
+static NamespacedProberManger* GetProberManager(const std::string& procPath) {
+    static std::string sProcPath = procPath;
+    return NamespacedProberManger::GetInstance(sProcPath);
+}
+
+SocketInodeScanner::SocketInodeScanner(const std::string& procPath,
+                                       ConnectionFetcher fetcher,
+                                       std::function<void()> invalidateHook)
+    : mProcPath(procPath), mFetcher(std::move(fetcher)), mInvalidateHook(std::move(invalidateHook)) {
+    if (mProcPath.empty() || mProcPath[mProcPath.size() - 1] != '/') {
+        mProcPath.append("/");
+    }
+    mConnMetaStatistic = ConnectionMetaStatistic::GetInstance();
+}
+
+SocketInodeScanner::~SocketInodeScanner() {
+    Stop();
+    delete mPublished.exchange(nullptr);
+}
+
+void SocketInodeScanner::Start(uint32_t intervalMs) {
+    if (!mThread) {
+        mThread = CreateThread([this, intervalMs]() { Run(intervalMs); });
+    }
+}
+
+void SocketInodeScanner::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mRequestMux);
+        mStopped = true;
+    }
+    mRequestCV.notify_all();
+    // the destructor of thread joins it.
+    mThread.reset();
+}
+
+void SocketInodeScanner::RequestPid(uint32_t pid) {
+    std::lock_guard<std::mutex> lock(mRequestMux);
+    mRequestedPids.insert(pid);
+}
+
+bool SocketInodeScanner::IsSocketFdUnchanged(uint32_t pid, uint32_t fd, uint32_t inode) const {
+    std::string fdPath = mProcPath;
+    fdPath.append(std::to_string(pid)).append("/fd/").append(std::to_string(fd));
+    int8_t errorCode;
+    uint32_t current = ReadLinkInodeNum(AT_FDCWD, fdPath.c_str(), "socket:", 7, errorCode);
+    return errorCode == 0 && current == inode;
+}
+
+void SocketInodeScanner::Run(uint32_t intervalMs) {
+    std::unique_lock<std::mutex> lock(mRequestMux);
+    while (!mStopped) {
+        mRequestCV.wait_for(lock, std::chrono::milliseconds(intervalMs));
+        if (mStopped) {
+            break;
+        }
+        // nobody looks up the index, so there is no need to keep it fresh.
+        uint64_t lookupCount = mLookupCount.load(std::memory_order_relaxed);
+        if (lookupCount == mLastLookupCount && mRequestedPids.empty()) {
+            continue;
+        }
+        mLastLookupCount = lookupCount;
+        lock.unlock();
+        ScanOnce();
+        lock.lock();
+    }
+}
+
+bool SocketInodeScanner::ScanPid(uint32_t pid, PidEntry& entry) {
+    ++mConnMetaStatistic->mScanFdDirCount;
+    entry.mSocketFds.clear();
+    std::string pidPath = mProcPath + std::to_string(pid);
+    int pidFd = open(pidPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (pidFd < 0) {
+        return false;
+    }
+    int8_t errorCode;
+    entry.mNetNsInode = ReadLinkInodeNum(pidFd, "ns/net", "net:", 4, errorCode);
+    if (errorCode < 0) {
+        close(pidFd);
+        LOG_DEBUG(sLogger, ("scan socket fds", "fail")("cannot read net ns", pidPath)("error", errorCode));
+        return false;
+    }
+    int fdDirFd = openat(pidFd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    close(pidFd);
+    if (fdDirFd < 0) {
+        return false;
+    }
+    DIR* fdDir = fdopendir(fdDirFd);
+    if (fdDir == nullptr) {
+        close(fdDirFd);
+        return false;
+    }
+    for (dirent* ent = readdir(fdDir); ent != nullptr; ent = readdir(fdDir)) {
+        if (ent->d_name[0] < '0' || ent->d_name[0] > '9') {
+            continue;
+        }
+        uint32_t inode = ReadLinkInodeNum(fdDirFd, ent->d_name, "socket:", 7, errorCode);
+        if (errorCode < 0) {
+            continue;
+        }
+        entry.mSocketFds.emplace_back((uint32_t)std::strtoul(ent->d_name, NULL, 10), inode);
+    }
+    closedir(fdDir);
+    return true;
+}
+
+bool SocketInodeScanner::ScanOnce() {
+    std::unordered_set<uint32_t> requestedPids;
+    {
+        std::lock_guard<std::mutex> lock(mRequestMux);
+        requestedPids.swap(mRequestedPids);
+    }
+    ++mGeneration;
+    ++mConnMetaStatistic->mScanRoundCount;
+    if (mInvalidated.exchange(false, std::memory_order_relaxed)) {
+        for (auto& item : mNetNs) {
+            item.second.mStale = true;
+        }
+        if (mInvalidateHook) {
+            mInvalidateHook();
+        }
+    }
+
+    DIR* procDir = opendir(mProcPath.c_str());
+    if (procDir == nullptr) {
+        LOG_DEBUG(sLogger, ("scan socket fds", "fail")("cannot open proc path", mProcPath));
+        return false;
+    }
+    bool changed = false;
+    std::unordered_set<uint32_t> missedNetNs;
+    for (dirent* ent = readdir(procDir); ent != nullptr; ent = readdir(procDir)) {
+        uint32_t pid;
+        if (!ParsePid(ent->d_name, pid)) {
+            continue;
+        }
+        auto res = mPids.emplace(pid, PidEntry());
+        PidEntry& entry = res.first->second;
+        entry.mSeenGeneration = mGeneration;
+        bool requested = requestedPids.find(pid) != requestedPids.end();
+        if (!res.second && !requested) {
+            continue;
+        }
+        changed = true;
+        if (!ScanPid(pid, entry)) {
+            continue;
+        }
+        // the connection of a missed lookup, or a socket unknown to the last dump, is newer than that dump.
+        bool stale = requested;
+        auto netNs = mNetNs.find(entry.mNetNsInode);
+        if (!stale && netNs != mNetNs.end()) {
+            for (const auto& socketFd : entry.mSocketFds) {
+                if (netNs->second.mConnections.find(socketFd.second) == netNs->second.mConnections.end()) {
+                    stale = true;
+                    break;
+                }
+            }
+        }
+        if (stale) {
+            missedNetNs.insert(entry.mNetNsInode);
+        }
+    }
+    closedir(procDir);
+
+    // network namespace inode -> any pid living in it with sockets.
+    std::unordered_map<uint32_t, uint32_t> liveNetNs;
+    for (auto iter = mPids.begin(); iter != mPids.end();) {
+        if (iter->second.mSeenGeneration != mGeneration) {
+            iter = mPids.erase(iter);
+            changed = true;
+            continue;
+        }
+        if (!iter->second.mSocketFds.empty()) {
+            liveNetNs.emplace(iter->second.mNetNsInode, iter->first);
+        }
+        ++iter;
+    }
+    for (auto iter = mNetNs.begin(); iter != mNetNs.end();) {
+        if (liveNetNs.find(iter->first) == liveNetNs.end()) {
+            iter = mNetNs.erase(iter);
+            changed = true;
+        } else {
+            ++iter;
+        }
+    }
+    for (const auto& item : liveNetNs) {
+        NetNsEntry& netNs = mNetNs[item.first];
+        if (!netNs.mStale && missedNetNs.find(item.first) == missedNetNs.end()) {
+            continue;
+        }
+        // a failed dump is not retried until requested or invalidated again.
+        netNs.mStale = false;
+        netNs.mFetchGeneration = mGeneration;
+        ConnectionMap infos;
+        ++mConnMetaStatistic->mFetchNetlinkCount;
+        if (mFetcher(item.second, item.first, infos)) {
+            netNs.mConnections.swap(infos);
+            changed = true;
+        }
+    }
+    if (changed) {
+        Publish();
+    }
+    return changed;
+}
+
+void SocketInodeScanner::Publish() {
+    auto snapshot = new Snapshot;
+    snapshot->mGeneration = mGeneration;
+    for (const auto& pid : mPids) {
+        auto netNs = mNetNs.find(pid.second.mNetNsInode);
+        if (netNs == mNetNs.end()) {
+            continue;
+        }
+        for (const auto& socketFd : pid.second.mSocketFds) {
+            auto info = netNs->second.mConnections.find(socketFd.second);
+            if (info != netNs->second.mConnections.end()) {
+                snapshot->mConnections.emplace((uint64_t)pid.first << 32 | socketFd.first,
+                                               SocketConnection{socketFd.second, info->second});
+            }
+        }
+    }
+    // the snapshot published before is not taken yet, so nobody else refers to it.
+    delete mPublished.exchange(snapshot, std::memory_order_acq_rel);
+}
+
 bool ConnectionMetaManager::Init(const std::string& procBashPath) {
     if (!this->mBashProcPath.empty()) {
         return true;
@@ -69,73 +327,67 @@ bool ConnectionMetaManager::Init(const std::string& procBashPath) {
         return false;
     }
     this->mBashProcPath = bashPath;
+    auto statistic = this->mConnMetaStatistic;
+    mScanner.reset(new SocketInodeScanner(
+        bashPath,
+        [bashPath, statistic](uint32_t pid, uint32_t netNsInode, SocketInodeScanner::ConnectionMap& infos) {
+            ++statistic->mGetNetlinkProberCount;
+            auto prober = GetProberManager(bashPath)->GetOrCreateProber(pid);
+            if (prober == nullptr) {
+                LOG_DEBUG(sLogger, ("fetch connections", "fail")("prober create fail", pid)("net ns", netNsInode));
+                ++statistic->mGetNetlinkProberFailCount;
+                return false;
+            }
+            prober->FetchInetConnections(infos);
+            prober->FetchUnixConnections(infos);
+            return true;
+        },
+        [bashPath]() { GetProberManager(bashPath)->GarbageCollection(); }));
+    mScanner->Start(INT32_FLAG(sls_observer_network_conn_scan_interval_ms));
     LOG_INFO(sLogger, ("init observer connection manager", "success")("proc path", bashPath));
     return true;
 }
 
 ConnectionInfoPtr ConnectionMetaManager::GetConnectionInfo(uint32_t pid, uint32_t fd) {
     ++mConnMetaStatistic->mGetSocketInfoCount;
-    std::string fdPath = this->mBashProcPath;
-    fdPath.append(std::to_string(pid)).append("/fd/").append(std::to_string(fd));
-    std::string fdLinkPath;
-    ReadFdLink(fdPath, fdLinkPath);
-    if (fdLinkPath.empty()) {
-        LOG_DEBUG(sLogger, ("fetch connection meta", "fail")("path", fdPath));
-        ++mConnMetaStatistic->mGetSocketInfoFailCount;
-        return nullptr;
-    }
-    int8_t errorCode;
-    uint32_t inode = ReadSocketInodeNum(fdLinkPath, errorCode);
-    if (errorCode < 0) {
-        LOG_DEBUG(sLogger, ("fetch connection meta", "fail")("fdLink", fdLinkPath));
+    if (mScanner == nullptr) {
         ++mConnMetaStatistic->mGetSocketInfoFailCount;
         return nullptr;
     }
-    auto meta = mConnectionMeta.find(inode);
-    if (meta != mConnectionMeta.end()) {
-        return meta->second;
+    mScanner->Touch();
+    auto snapshot = mScanner->TakeSnapshot();
+    if (snapshot != nullptr) {
+        mSnapshot = std::move(snapshot);
     }
-    static auto sProberManger = NamespacedProberManger::GetInstance(this->mBashProcPath);
-    auto prober = sProberManger->GetOrCreateProber(pid);
-    ++mConnMetaStatistic->mGetNetlinkProberCount;
-    if (prober == nullptr) {
-        LOG_DEBUG(sLogger, ("fetch connection meta", "fail")("prober create fail", pid));
-        ++mConnMetaStatistic->mGetSocketInfoFailCount;
-        ++mConnMetaStatistic->mGetNetlinkProberFailCount;
-        return nullptr;
-    }
-    if (mProberFetchLog.find(prober->Inode()) != mProberFetchLog.end()) {
-        ++mConnMetaStatistic->mGetSocketInfoFailCount;
-        return nullptr;
-    }
-    mProberFetchLog.insert(prober->Inode());
-    ++mConnMetaStatistic->mFetchNetlinkCount;
-    prober->FetchInetConnections(this->mConnectionMeta);
-    prober->FetchUnixConnections(this->mConnectionMeta);
-
-    meta = mConnectionMeta.find(inode);
-    if (meta != mConnectionMeta.end()) {
-        LOG_DEBUG(
-            sLogger,
-            ("ConnectionManager find info", "success")("pid", pid)("inode", inode)("meta", meta->second->ToString()));
-        return meta->second;
+    if (mSnapshot != nullptr) {
+        auto meta = mSnapshot->mConnections.find((uint64_t)pid << 32 | fd);
+        if (meta != mSnapshot->mConnections.end()
+            && mScanner->IsSocketFdUnchanged(pid, fd, meta->second.mInode)) {
+            return meta->second.mInfo;
+        }
     }
-    LOG_DEBUG(sLogger, ("ConnectionManager find info", "fail")("pid", pid)("inode", inode));
+    LOG_DEBUG(sLogger, ("ConnectionManager find info", "fail")("pid", pid)("fd", fd));
+    mScanner->RequestPid(pid);
     ++mConnMetaStatistic->mGetSocketInfoFailCount;
     return nullptr;
 }
 
+// Connections and probers are owned by the scanning thread, which drops closed connections and closes probers once
+// the invalidation takes effect.
 bool ConnectionMetaManager::GarbageCollection() {
-    mConnectionMeta.erase(this->mConnectionMeta.begin(), this->mConnectionMeta.end());
-    mProberFetchLog.erase(this->mProberFetchLog.begin(), this->mProberFetchLog.end());
-    static auto sProberManger = NamespacedProberManger::GetInstance(this->mBashProcPath);
-    sProberManger->GarbageCollection();
+    if (mScanner != nullptr) {
+        mScanner->Invalidate();
+    }
     return true;
 }
 
 void ConnectionMetaManager::Print() {
-    for (const auto& item : this->mConnectionMeta) {
-        std::cout << "inode:" << item.first << " info: " << item.second->ToString() << std::endl;
+    if (mSnapshot == nullptr) {
+        return;
+    }
+    for (const auto& item : mSnapshot->mConnections) {
+        std::cout << "pid:" << (item.first >> 32) << " fd:" << (item.first & 0xFFFFFFFF)
+                  << " info: " << item.second.mInfo->ToString() << std::endl;
     }
 }
 
@@ -18,7 +18,13 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <fcntl.h>
 #include <sys/socket.h>
 #include <ostream>
@@ -29,6 +35,7 @@
 #include "linux/rtnetlink.h"
 #include "interface/helper.h"
 #include "interface/statistics.h"
+#include "common/Thread.h"
 
 
 namespace logtail {
@@ -166,6 +173,104 @@ private:
 };
 
 
+// SocketInodeScanner keeps an index from (pid, fd) to connection info of all processes under the proc path.
+// Each scan round lists the proc path, reads /proc/<pid>/fd only for new pids and pids requested by lookup misses,
+// and dumps connections with sock_diag in bulk for the network namespaces of those pids. Network namespaces are
+// dumped again once invalidated, which drops closed sockets. After a round changes anything, a new immutable
+// snapshot is published for the single lookup thread to take over.
+class SocketInodeScanner {
+public:
+    typedef std::unordered_map<uint32_t, ConnectionInfoPtr> ConnectionMap;
+    // ConnectionFetcher fetches all connections in the network namespace of pid.
+    typedef std::function<bool(uint32_t pid, uint32_t netNsInode, ConnectionMap& infos)> ConnectionFetcher;
+
+    struct SocketConnection {
+        uint32_t mInode = 0;
+        ConnectionInfoPtr mInfo;
+    };
+
+    struct Snapshot {
+        uint64_t mGeneration = 0;
+        // key is pid << 32 | fd.
+        std::unordered_map<uint64_t, SocketConnection> mConnections;
+    };
+
+    // invalidateHook is called in the scanning thread when an invalidation takes effect.
+    SocketInodeScanner(const std::string& procPath,
+                       ConnectionFetcher fetcher,
+                       std::function<void()> invalidateHook = std::function<void()>());
+
+    ~SocketInodeScanner();
+
+    void Start(uint32_t intervalMs);
+
+    void Stop();
+
+    // ScanOnce runs one scan round in the calling thread, and returns true if a new snapshot is published.
+    bool ScanOnce();
+
+    // RequestPid asks the next round to read the fds of pid again.
+    void RequestPid(uint32_t pid);
+
+    // Invalidate makes the next rounds dump all known network namespaces again.
+    void Invalidate() { mInvalidated.store(true, std::memory_order_relaxed); }
+
+    // Touch marks the index as in use, rounds are skipped when nothing looked up since the last one.
+    void Touch() { mLookupCount.fetch_add(1, std::memory_order_relaxed); }
+
+    // TakeSnapshot returns the snapshot published since the last call, or nullptr if there is none.
+    // Only one thread should take snapshots.
+    std::unique_ptr<Snapshot> TakeSnapshot() {
+        return std::unique_ptr<Snapshot>(mPublished.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    uint64_t Generation() const { return mGeneration; }
+
+    // IsSocketFdUnchanged returns true if fd of pid still refers to the socket inode. A closed fd can be reused by
+    // another socket before the next scan of pid, so a snapshot entry must be checked before use.
+    bool IsSocketFdUnchanged(uint32_t pid, uint32_t fd, uint32_t inode) const;
+
+private:
+    struct PidEntry {
+        uint32_t mNetNsInode = 0;
+        uint64_t mSeenGeneration = 0;
+        // pairs of fd and socket inode.
+        std::vector<std::pair<uint32_t, uint32_t>> mSocketFds;
+    };
+
+    struct NetNsEntry {
+        uint64_t mFetchGeneration = 0;
+        bool mStale = true;
+        ConnectionMap mConnections;
+    };
+
+    void Run(uint32_t intervalMs);
+    bool ScanPid(uint32_t pid, PidEntry& entry);
+    void Publish();
+
+    std::string mProcPath;
+    ConnectionFetcher mFetcher;
+    std::function<void()> mInvalidateHook;
+    ConnectionMetaStatistic* mConnMetaStatistic;
+
+    // following members are only accessed by the scanning thread.
+    uint64_t mGeneration = 0;
+    uint64_t mLastLookupCount = 0;
+    std::unordered_map<uint32_t, PidEntry> mPids;
+    std::unordered_map<uint32_t, NetNsEntry> mNetNs;
+
+    std::mutex mRequestMux;
+    std::condition_variable mRequestCV;
+    std::unordered_set<uint32_t> mRequestedPids;
+    bool mStopped = false;
+
+    std::atomic_bool mInvalidated{false};
+    std::atomic<uint64_t> mLookupCount{0};
+    std::atomic<Snapshot*> mPublished{nullptr};
+    ThreadPtr mThread;
+};
+
+
 class ConnectionMetaManager {
 public:
     static ConnectionMetaManager* GetInstance() {
@@ -174,6 +279,9 @@ public:
     }
     bool Init(const std::string& procBashPath = "/proc/");
 
+    // GetConnectionInfo looks up the latest snapshot of the socket scanner without any lock. A hit costs one
+    // readlink of /proc/<pid>/fd/<fd> to make sure the fd was not reused for another socket.
+    // A miss asks the scanner to read the fds of pid again, so it should be called from one thread.
     ConnectionInfoPtr GetConnectionInfo(uint32_t pid, uint32_t fd);
 
     bool GarbageCollection();
@@ -186,8 +294,8 @@ private:
 private:
     ConnectionMetaStatistic* mConnMetaStatistic;
     std::string mBashProcPath;
-    std::unordered_map<uint32_t, ConnectionInfoPtr> mConnectionMeta{};
-    std::unordered_set<uint32_t> mProberFetchLog{};
+    std::unique_ptr<SocketInodeScanner> mScanner;
+    std::unique_ptr<SocketInodeScanner::Snapshot> mSnapshot;
 };
 
 
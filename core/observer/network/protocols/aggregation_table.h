@@ -0,0 +1,152 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace logtail {
+
+/**
+ * FlatAggregationTable maps hashes to aggregation items for one interval.
+ *
+ * Items are stored inline in a dense array and are reused across intervals, and hashes are indexed by an open
+ * addressing table with linear probing. Each index slot records the generation it is written in, and Reset starts a
+ * new generation, so that all items are invalidated at once without being cleared or erased one by one. Since items
+ * are never removed within a generation, no tombstone is needed. At Reset, the table is shrunk if it is much larger
+ * than what the last interval used.
+ *
+ * @tparam Item aggregation item, which should be default constructible and movable
+ */
+template <typename Item>
+class FlatAggregationTable {
+public:
+    static constexpr size_t kMinCapacity = 16;
+
+    FlatAggregationTable() : mIndex(kMinCapacity) {}
+
+    /**
+     * @return the item of @hash in the current generation, or nullptr if there is none
+     */
+    Item* Find(uint64_t hash) {
+        size_t mask = mIndex.size() - 1;
+        for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+            const IndexSlot& slot = mIndex[pos];
+            if (slot.Generation != mGeneration) {
+                return nullptr;
+            }
+            if (slot.Hash == hash) {
+                return &mItems[slot.ItemIdx];
+            }
+        }
+    }
+
+    /**
+     * Insert adds an item for @hash, which should not be in the table. The returned item may hold the content of an
+     * item of previous intervals, and should be reinitialized by the caller. It is valid until the next Insert.
+     */
+    Item& Insert(uint64_t hash) {
+        if ((mSize + 1) * 2 > mIndex.size()) {
+            Rehash(mIndex.size() * 2);
+        }
+        uint32_t itemIdx = static_cast<uint32_t>(mSize++);
+        if (itemIdx == mItems.size()) {
+            mItems.emplace_back();
+        }
+        Place(hash, itemIdx);
+        return mItems[itemIdx];
+    }
+
+    size_t Size() const { return mSize; }
+
+    /**
+     * Iterate items in the current generation in insertion order.
+     */
+    template <typename Func>
+    void ForEach(Func&& func) {
+        for (size_t i = 0; i < mSize; ++i) {
+            func(mItems[i]);
+        }
+    }
+
+    /**
+     * Reset invalidates all items by starting a new generation.
+     */
+    void Reset() {
+        size_t lastSize = mSize < kMinCapacity ? kMinCapacity : mSize;
+        mSize = 0;
+        if (mItems.size() > lastSize * 4) {
+            mItems.resize(lastSize * 2);
+            mItems.shrink_to_fit();
+        }
+        size_t capacity = kMinCapacity;
+        while (capacity < lastSize * 2) {
+            capacity *= 2;
+        }
+        if (mIndex.size() > capacity * 4) {
+            std::vector<IndexSlot>(capacity).swap(mIndex);
+            mGeneration = 1;
+            return;
+        }
+        if (++mGeneration == 0) {
+            // slots written in the generation before wrapping around could be taken as valid again
+            std::vector<IndexSlot>(mIndex.size()).swap(mIndex);
+            mGeneration = 1;
+        }
+    }
+
+private:
+    struct IndexSlot {
+        uint64_t Hash = 0;
+        uint32_t Generation = 0;
+        uint32_t ItemIdx = 0;
+    };
+
+    void Place(uint64_t hash, uint32_t itemIdx) {
+        size_t mask = mIndex.size() - 1;
+        size_t pos = hash & mask;
+        while (mIndex[pos].Generation == mGeneration) {
+            pos = (pos + 1) & mask;
+        }
+        mIndex[pos].Hash = hash;
+        mIndex[pos].Generation = mGeneration;
+        mIndex[pos].ItemIdx = itemIdx;
+    }
+
+    void Rehash(size_t capacity) {
+        std::vector<IndexSlot> old(capacity);
+        old.swap(mIndex);
+        for (const auto& slot : old) {
+            if (slot.Generation == mGeneration) {
+                Place(slot.Hash, slot.ItemIdx);
+            }
+        }
+    }
+
+    // the capacity is always a power of 2, and at least twice the number of items
+    std::vector<IndexSlot> mIndex;
+    std::vector<Item> mItems;
+    size_t mSize = 0;
+    uint32_t mGeneration = 1;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlatAggregationTableUnittest;
+#endif
+};
+
+} // namespace logtail
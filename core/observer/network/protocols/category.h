@@ -21,6 +21,7 @@
 #include "interface/helper.h"
 #include "common.h"
 #include "Logger.h"
+#include "models/StringView.h"
 #include "xxhash/xxhash.h"
 
 namespace logtail {
@@ -101,6 +102,43 @@ struct CommonAggKey {
     std::string LocalIp;
 };
 
+/**
+ * DBAggKeyView has the same fields and hash as DBAggKey, but refers to the connection key and strings kept by the
+ * parser, which outlive AddEvent. It is materialized into a DBAggKey only when a new key is aggregated.
+ */
+template <ProtocolType PT>
+struct DBAggKeyView {
+    uint64_t Hash() const {
+        uint64_t hashValue = ConnKey->HashVal;
+        hashValue = XXH32(this->QueryCmd.data(), this->QueryCmd.size(), hashValue);
+        hashValue = XXH32(this->Query.data(), this->Query.size(), hashValue);
+        hashValue = XXH32(this->Version.data(), this->Version.size(), hashValue);
+        hashValue = XXH32(&this->Status, sizeof(this->Status), hashValue);
+        return hashValue;
+    }
+
+    PacketRoleType Role() const { return ConnKey->Role; }
+
+    std::string ProtocolType() { return ProtocolTypeToString(PT); }
+
+    friend std::ostream& operator<<(std::ostream& Os, const DBAggKeyView& Key) {
+        Os << "ConnKey: " << *Key.ConnKey << " QueryCmd: " << Key.QueryCmd << " Query: " << Key.Query
+           << " Version: " << Key.Version << " Status: " << Key.Status;
+        return Os;
+    }
+    std::string ToString() const {
+        std::stringstream ss;
+        ss << *this;
+        return ss.str();
+    }
+
+    const CommonAggKey* ConnKey{nullptr};
+    StringView QueryCmd;
+    StringView Query;
+    StringView Version;
+    int8_t Status{-1};
+};
+
 template <ProtocolType PT>
 struct DBAggKey {
     DBAggKey() = default;
@@ -119,7 +157,15 @@ struct DBAggKey {
         this->Version = std::move(other.Version);
         this->Status = other.Status;
         return *this;
-
+    }
+    // copies the strings only here, reusing the capacity of this key.
+    DBAggKey& operator=(const DBAggKeyView<PT>& view) {
+        this->ConnKey = *view.ConnKey;
+        this->QueryCmd.assign(view.QueryCmd.data(), view.QueryCmd.size());
+        this->Query.assign(view.Query.data(), view.Query.size());
+        this->Version.assign(view.Version.data(), view.Version.size());
+        this->Status = view.Status;
+        return *this;
     }
 
     uint64_t Hash() const {
@@ -130,6 +176,9 @@ struct DBAggKey {
         hashValue = XXH32(&this->Status, sizeof(this->Status), hashValue);
         return hashValue;
     }
+
+    PacketRoleType Role() const { return ConnKey.Role; }
+
     void ToPB(sls_logs::Log* log) const {
         AddAnyLogContent(log, observer::kVersion, Version);
         AddAnyLogContent(log, observer::kQueryCmd, QueryCmd);
@@ -160,6 +209,47 @@ struct DBAggKey {
     int8_t Status{-1};
 };
 
+/**
+ * RequestAggKeyView is the view of RequestAggKey, like DBAggKeyView.
+ */
+template <ProtocolType PT>
+struct RequestAggKeyView {
+    uint64_t Hash() const {
+        uint64_t hashValue = ConnKey->HashVal;
+        hashValue = XXH32(this->ReqType.data(), this->ReqType.size(), hashValue);
+        hashValue = XXH32(this->ReqDomain.data(), this->ReqDomain.size(), hashValue);
+        hashValue = XXH32(this->ReqResource.data(), this->ReqResource.size(), hashValue);
+        hashValue = XXH32(this->Version.data(), this->Version.size(), hashValue);
+        hashValue = XXH32(&this->RespCode, sizeof(this->RespCode), hashValue);
+        hashValue = XXH32(&this->RespStatus, sizeof(this->RespStatus), hashValue);
+        return hashValue;
+    }
+
+    PacketRoleType Role() const { return ConnKey->Role; }
+
+    std::string ProtocolType() { return ProtocolTypeToString(PT); }
+
+    friend std::ostream& operator<<(std::ostream& Os, const RequestAggKeyView& Key) {
+        Os << "ConnKey: " << *Key.ConnKey << " ReqType: " << Key.ReqType << " ReqDomain: " << Key.ReqDomain
+           << " ReqResource: " << Key.ReqResource << " Version: " << Key.Version << " RespCode: " << Key.RespCode
+           << " RespStatus: " << Key.RespStatus;
+        return Os;
+    }
+    std::string ToString() const {
+        std::stringstream ss;
+        ss << *this;
+        return ss.str();
+    }
+
+    const CommonAggKey* ConnKey{nullptr};
+    StringView ReqType;
+    StringView ReqDomain;
+    StringView ReqResource;
+    StringView Version;
+    int16_t RespCode{-1};
+    int8_t RespStatus{-1};
+};
+
 template <ProtocolType PT>
 struct RequestAggKey {
     RequestAggKey() = default;
@@ -183,6 +273,17 @@ struct RequestAggKey {
         this->RespStatus = other.RespStatus;
         return *this;
     }
+    // copies the strings only here, reusing the capacity of this key.
+    RequestAggKey& operator=(const RequestAggKeyView<PT>& view) {
+        this->ConnKey = *view.ConnKey;
+        this->ReqType.assign(view.ReqType.data(), view.ReqType.size());
+        this->ReqDomain.assign(view.ReqDomain.data(), view.ReqDomain.size());
+        this->ReqResource.assign(view.ReqResource.data(), view.ReqResource.size());
+        this->Version.assign(view.Version.data(), view.Version.size());
+        this->RespCode = view.RespCode;
+        this->RespStatus = view.RespStatus;
+        return *this;
+    }
 
     uint64_t Hash() const {
         uint64_t hashValue = ConnKey.HashVal;
@@ -194,6 +295,9 @@ struct RequestAggKey {
         hashValue = XXH32(&this->RespStatus, sizeof(this->RespStatus), hashValue);
         return hashValue;
     }
+
+    PacketRoleType Role() const { return ConnKey.Role; }
+
     void ToPB(sls_logs::Log* log) const {
         AddAnyLogContent(log, observer::kReqType, ReqType);
         AddAnyLogContent(log, observer::kReqDomain, ReqDomain);
@@ -17,12 +17,13 @@
 #pragma once
 
 #include "interface/protocol.h"
-#include <deque>
 #include "protobuf/sls/sls_logs.pb.h"
 #include "interface/helper.h"
 #include "LogtailAlarm.h"
 #include "metas/ServiceMetaCache.h"
 #include "Logger.h"
+#include "network/protocols/aggregation_table.h"
+#include "network/protocols/sketch.h"
 #include <unordered_map>
 #include <ostream>
 
@@ -82,6 +83,7 @@ struct CommonProtocolAggResult {
         TotalLatencyNs = 0;
         TotalReqBytes = 0;
         TotalRespBytes = 0;
+        LatencyNsSketch.Clear();
     }
 
     bool IsEmpty() const { return TotalCount == 0; }
@@ -91,6 +93,7 @@ struct CommonProtocolAggResult {
         TotalLatencyNs += info.LatencyNs;
         TotalReqBytes += info.ReqBytes;
         TotalRespBytes += info.RespBytes;
+        LatencyNsSketch.Add(info.LatencyNs);
     }
 
     void Merge(CommonProtocolAggResult& aggResult) {
@@ -98,6 +101,7 @@ struct CommonProtocolAggResult {
         TotalLatencyNs += aggResult.TotalLatencyNs;
         TotalReqBytes += aggResult.TotalReqBytes;
         TotalRespBytes += aggResult.TotalRespBytes;
+        LatencyNsSketch.Merge(aggResult.LatencyNsSketch);
     }
 
     void ToPB(sls_logs::Log* log) const {
@@ -105,13 +109,18 @@ struct CommonProtocolAggResult {
         AddAnyLogContent(log, observer::kLatencyNs, TotalLatencyNs);
         AddAnyLogContent(log, observer::kReqBytes, TotalReqBytes);
         AddAnyLogContent(log, observer::kRespBytes, TotalRespBytes);
-        AddAnyLogContent(log, observer::kTdigestLatency, std::string("xxxxx"));
+        AddAnyLogContent(log, observer::kLatencyP50Ns, LatencyNsSketch.Quantile(0.5));
+        AddAnyLogContent(log, observer::kLatencyP90Ns, LatencyNsSketch.Quantile(0.9));
+        AddAnyLogContent(log, observer::kLatencyP99Ns, LatencyNsSketch.Quantile(0.99));
+        AddAnyLogContent(log, observer::kTdigestLatency, LatencyNsSketch.Serialize());
     }
 
     int64_t TotalCount{0};
     int64_t TotalLatencyNs{0};
     int64_t TotalReqBytes{0};
     int64_t TotalRespBytes{0};
+    // latency distribution, bounded in memory and mergeable
+    LatencySketch LatencyNsSketch;
 };
 
 
@@ -137,88 +146,45 @@ struct CommonProtocolEventAggItem {
     ProtocolEventAggResult AggResult;
 };
 
-/**
- * Cache pool
- * @tparam ProtocolEventAggItem reused object.
- */
-template <typename ProtocolEventAggItem>
-class CommonProtocolEventAggItemManager {
-public:
-    explicit CommonProtocolEventAggItemManager(size_t maxCount = 128) : mMaxCount(maxCount) {}
-
-    ~CommonProtocolEventAggItemManager() {
-        for (auto iter = mUnUsed.begin(); iter != mUnUsed.end(); ++iter) {
-            delete *iter;
-        }
-    }
-
-    /**
-     * Create an new object or reuse the cached object.
-     * @return an protocol metrics event aggregate node.
-     */
-    template <typename ProtocolEventKey>
-    ProtocolEventAggItem* Create(ProtocolEventKey&& event) {
-        ProtocolEventAggItem* item;
-        if (mUnUsed.empty()) {
-            item = new ProtocolEventAggItem();
-            item->Key = std::move(event);
-            return item;
-        }
-        item = mUnUsed.back();
-        item->Clear();
-        item->Key = std::move(event);
-        mUnUsed.pop_back();
-        return item;
-    }
-
-    /**
-     * Delete object when cache is full, or else would cache it.
-     * @param item deleting object.
-     */
-    void Delete(ProtocolEventAggItem* item) {
-        if (mUnUsed.size() < mMaxCount) {
-            mUnUsed.push_back(item);
-            return;
-        }
-        delete item;
-    }
-
-private:
-    size_t mMaxCount;
-    std::deque<ProtocolEventAggItem*> mUnUsed;
-};
-
 // 通用的协议的聚类器实现
-template <typename ProtocolEvent, typename ProtocolEventAggItem, typename ProtocolEventAggItemManager>
+// Events are aggregated by the hash of their keys in a flat table, which is reset after each flush. When the number of
+// keys of a role reaches the limit, events of new keys are aggregated into an "other" item of the role, whose key is
+// empty except the role, instead of being dropped. Event keys may be views into the parser, which are copied into an
+// item only when it is inserted for a new key.
+template <typename ProtocolEvent, typename ProtocolEventAggItem>
 class CommonProtocolEventAggregator {
 public:
     CommonProtocolEventAggregator(uint32_t maxClientAggSize, uint32_t maxServerAggSize)
-        : mClientAggMaxSize(maxClientAggSize), mServerAggMaxSize(maxServerAggSize) {}
-
-    ~CommonProtocolEventAggregator() {
-        for (auto iter = mProtocolEventAggMap.begin(); iter != mProtocolEventAggMap.end(); ++iter) {
-            mAggItemManager.Delete(iter->second);
-        }
+        : mClientAggMaxSize(maxClientAggSize), mServerAggMaxSize(maxServerAggSize) {
+        mClientOtherItem.Key.ConnKey.Role = PacketRoleType::Client;
+        mServerOtherItem.Key.ConnKey.Role = PacketRoleType::Server;
     }
+
     bool AddEvent(ProtocolEvent&& event) {
-        auto key = event.Key;
-        auto hashVal = key.Hash();
-        auto findRst = mProtocolEventAggMap.find(hashVal);
-        if (findRst == mProtocolEventAggMap.end()) {
-            if (isFull(event.Key.ConnKey.Role)) {
-                static uint32_t sLastDropTime{0};
-                auto now = time(nullptr);
-                LOG_DEBUG(sLogger, ("aggregator is full, some events would be dropped", event.Key.ToString()));
-                if (now - sLastDropTime > 60) {
-                    sLastDropTime = now;
-                    LOG_ERROR(sLogger, ("aggregator is full, some events would be dropped", event.Key.ProtocolType()));
+        auto hashVal = event.Key.Hash();
+        ProtocolEventAggItem* item = mProtocolEventAggTable.Find(hashVal);
+        if (item == nullptr) {
+            PacketRoleType role = event.Key.Role();
+            if (isFull(role)) {
+                item = getOtherItem(role);
+                if (item == nullptr) {
+                    static uint32_t sLastDropTime{0};
+                    auto now = time(nullptr);
+                    LOG_DEBUG(sLogger, ("unknown role, some events would be dropped", event.Key.ToString()));
+                    if (now - sLastDropTime > 60) {
+                        sLastDropTime = now;
+                        LOG_ERROR(sLogger, ("unknown role, some events would be dropped", event.Key.ProtocolType()));
+                    }
+                    return false;
                 }
-                return false;
+            } else {
+                item = &mProtocolEventAggTable.Insert(hashVal);
+                item->Clear();
+                item->Key = std::move(event.Key);
+                role == PacketRoleType::Client ? ++mClientAggSize : ++mServerAggSize;
             }
-            auto item = mAggItemManager.Create(std::move(event.Key));
-            findRst = mProtocolEventAggMap.insert(std::make_pair(hashVal, item)).first;
         }
-        findRst->second->AddEventInfo(event.Info);
+        item->AddEventInfo(event.Info);
         return true;
     }
 
@@ -226,36 +192,60 @@ public:
                    const std::string& tags,
                    google::protobuf::RepeatedPtrField<sls_logs::Log_Content>& globalTags,
                    uint64_t interval) {
-        for (auto iter = mProtocolEventAggMap.begin(); iter != mProtocolEventAggMap.end();) {
-            if (iter->second->AggResult.IsEmpty()) {
-                mAggItemManager.Delete(iter->second);
-                iter = mProtocolEventAggMap.erase(iter);
-            } else {
-                sls_logs::Log newLog;
-                newLog.mutable_contents()->CopyFrom(globalTags);
-                AddAnyLogContent(&newLog, observer::kLocalInfo, tags);
-                AddAnyLogContent(&newLog, observer::kInterval, interval);
-                iter->second->ToPB(&newLog);
-                iter->second->Clear(); // wait for next clear
-                allData.push_back(std::move(newLog));
-                ++iter;
+        auto flushItem = [&](ProtocolEventAggItem& item) {
+            sls_logs::Log newLog;
+            newLog.mutable_contents()->CopyFrom(globalTags);
+            AddAnyLogContent(&newLog, observer::kLocalInfo, tags);
+            AddAnyLogContent(&newLog, observer::kInterval, interval);
+            item.ToPB(&newLog);
+            allData.push_back(std::move(newLog));
+        };
+        mProtocolEventAggTable.ForEach(flushItem);
+        for (auto* item : {&mClientOtherItem, &mServerOtherItem}) {
+            if (!item->AggResult.IsEmpty()) {
+                static uint32_t sLastSpillTime{0};
+                auto now = time(nullptr);
+                if (now - sLastSpillTime > 60) {
+                    sLastSpillTime = now;
+                    LOG_WARNING(sLogger,
+                                ("aggregator is full, some events are aggregated without keys",
+                                 item->Key.ProtocolType())("role", PacketRoleTypeToString(item->Key.ConnKey.Role))(
+                                    "count", item->AggResult.TotalCount));
+                }
+                flushItem(*item);
+                item->Clear();
             }
         }
+        mProtocolEventAggTable.Reset();
+        mClientAggSize = 0;
+        mServerAggSize = 0;
     }
 
 
 private:
     bool isFull(PacketRoleType role) {
         if (role == PacketRoleType::Client) {
-            return this->mProtocolEventAggMap.size() >= mClientAggMaxSize;
+            return mClientAggSize >= mClientAggMaxSize;
         }
         if (role == PacketRoleType::Server) {
-            return this->mProtocolEventAggMap.size() >= mServerAggMaxSize;
+            return mServerAggSize >= mServerAggMaxSize;
         }
         return true;
     }
-    ProtocolEventAggItemManager mAggItemManager;
-    std::unordered_map<uint64_t, ProtocolEventAggItem*> mProtocolEventAggMap;
+    ProtocolEventAggItem* getOtherItem(PacketRoleType role) {
+        if (role == PacketRoleType::Client) {
+            return &mClientOtherItem;
+        }
+        if (role == PacketRoleType::Server) {
+            return &mServerOtherItem;
+        }
+        return nullptr;
+    }
+    FlatAggregationTable<ProtocolEventAggItem> mProtocolEventAggTable;
+    ProtocolEventAggItem mClientOtherItem;
+    ProtocolEventAggItem mServerOtherItem;
+    uint32_t mClientAggSize = 0;
+    uint32_t mServerAggSize = 0;
     uint32_t mClientAggMaxSize;
     uint32_t mServerAggMaxSize;
 };
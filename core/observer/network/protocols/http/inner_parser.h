@@ -35,6 +35,8 @@ enum class HTTPBodyPacketCategory {
 struct HTTPRequestPacket {
     SlsStringPiece method;
     SlsStringPiece url;
+    // url without the query string, which is the resource of the aggregation key.
+    SlsStringPiece path;
 };
 
 struct HTTPResponsePacket {
@@ -73,6 +75,11 @@ struct HTTPParser {
                                    packet.common.headers,
                                    &packet.common.headersNum,
                                    /*last_len*/ 0);
+        if (status != -1) {
+            int pos = packet.msg.req.url.Find('?');
+            packet.msg.req.path
+                = SlsStringPiece(packet.msg.req.url.mPtr, pos == -1 ? packet.msg.req.url.mLen : (size_t)pos);
+        }
     }
 
     void ParseResp(const char* buf, size_t size) {
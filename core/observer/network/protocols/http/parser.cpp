@@ -99,22 +99,22 @@ ParseResult HTTPProtocolParser::OnPacket(PacketType pktType,
 
     bool insertSuccess = true;
     if (msgType == MessageType_Request) {
-        std::string host = parser.ReadHeaderVal("Host").ToString();
-        if (host.empty()) {
-            if (pktType == PacketType_Out) {
-                host = SockAddressToString(header->DstAddr);
-            } else {
-                host = SockAddressToString(header->SrcAddr);
-            }
-        }
-        int pos = parser.packet.msg.req.url.Find('?');
-        std::string url = std::string(parser.packet.msg.req.url.mPtr, pos == -1 ? parser.packet.msg.req.url.mLen : pos);
+        // strings are copied into the cached request, reusing its capacity.
         insertSuccess = mCache.InsertReq([&](HTTPRequestInfo* req) {
             req->TimeNano = header->TimeNano;
-            req->Method = parser.packet.msg.req.method.ToString();
-            req->URL = std::move(url);
+            const SlsStringPiece& method = parser.packet.msg.req.method;
+            req->Method.assign(method.mPtr, method.mLen);
+            const SlsStringPiece& path = parser.packet.msg.req.path;
+            req->URL.assign(path.mPtr, path.mLen);
             req->Version = std::to_string(parser.packet.common.version);
-            req->Host = std::move(host);
+            SlsStringPiece host = parser.ReadHeaderVal("Host");
+            if (host.mLen > 0) {
+                req->Host.assign(host.mPtr, host.mLen);
+            } else if (pktType == PacketType_Out) {
+                req->Host = SockAddressToString(header->DstAddr);
+            } else {
+                req->Host = SockAddressToString(header->SrcAddr);
+            }
             req->ReqBytes = pktRealSize;
             LOG_TRACE(sLogger, ("http insert req hash", header->SockHash)("data", req->ToString()));
         });
@@ -76,12 +76,12 @@ public:
                 }
                 event.Info.ReqBytes = requestInfo->ReqBytes;
                 event.Info.RespBytes = responseInfo->RespBytes;
-                event.Key.ReqType = std::move(requestInfo->Method);
-                event.Key.ReqDomain = std::move(requestInfo->Host);
-                event.Key.ReqResource = std::move(requestInfo->URL);
-                event.Key.Version = std::move(requestInfo->Version);
+                event.Key.ReqType = requestInfo->Method;
+                event.Key.ReqDomain = requestInfo->Host;
+                event.Key.ReqResource = requestInfo->URL;
+                event.Key.Version = requestInfo->Version;
                 event.Key.RespCode = responseInfo->RespCode;
-                event.Key.ConnKey = mKey;
+                event.Key.ConnKey = &mKey;
                 return true;
             });
     }
@@ -26,11 +26,8 @@
 namespace logtail {
 
 using HTTPProtocolEventKey = RequestAggKey<ProtocolType_HTTP>;
-using HTTPProtocolEvent = CommonProtocolEvent<HTTPProtocolEventKey>;
+using HTTPProtocolEvent = CommonProtocolEvent<RequestAggKeyView<ProtocolType_HTTP>>;
 using HTTPProtocolEventAggItem = CommonProtocolEventAggItem<HTTPProtocolEventKey, CommonProtocolAggResult>;
-using HTTPProtocolEventAggItemManager = CommonProtocolEventAggItemManager<HTTPProtocolEventAggItem>;
-using HTTPProtocolEventAggregator = CommonProtocolEventAggregator<HTTPProtocolEvent,
-                                                                  HTTPProtocolEventAggItem,
-                                                                  HTTPProtocolEventAggItemManager>;
+using HTTPProtocolEventAggregator = CommonProtocolEventAggregator<HTTPProtocolEvent, HTTPProtocolEventAggItem>;
 
 } // namespace logtail
@@ -68,7 +68,8 @@ ParseResult MySQLProtocolParser::OnPacket(PacketType pktType,
                 insertSuccess = mCache.InsertReq([&](MySQLRequestInfo* info) {
                     info->TimeNano = 0;
                     info->ReqBytes = MYSQL_REQUEST_INFO_IGNORE_FLAG;
-                    info->SQL = "";
+                    info->SQL.clear();
+                    info->QueryCmd.clear();
                 });
                 break;
             }
@@ -76,7 +77,8 @@ ParseResult MySQLProtocolParser::OnPacket(PacketType pktType,
                 insertSuccess = mCache.InsertReq([&](MySQLRequestInfo* info) {
                     info->TimeNano = header->TimeNano;
                     info->ReqBytes = pktRealSize;
-                    info->SQL = mysql.mysqlPacketQuery.sql.ToString();
+                    info->SQL.assign(mysql.mysqlPacketQuery.sql.mPtr, mysql.mysqlPacketQuery.sql.mLen);
+                    AssignQueryCmd(info->QueryCmd, info->SQL);
                 });
                 break;
             }
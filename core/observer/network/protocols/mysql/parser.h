@@ -33,6 +33,7 @@ struct MySQLRequestInfo {
     uint64_t TimeNano{0};
     int32_t ReqBytes{0};
     std::string SQL;
+    std::string QueryCmd;
 };
 
 struct MySQLResponseInfo {
@@ -57,10 +58,10 @@ public:
                 event.Info.LatencyNs = int64_t(responseInfo->TimeNano - requestInfo->TimeNano);
                 event.Info.ReqBytes = requestInfo->ReqBytes;
                 event.Info.RespBytes = responseInfo->RespBytes;
-                event.Key.QueryCmd = ToLowerCaseString(requestInfo->SQL.substr(0, requestInfo->SQL.find_first_of(' ')));
-                event.Key.Query = std::move(requestInfo->SQL);
+                event.Key.QueryCmd = requestInfo->QueryCmd;
+                event.Key.Query = requestInfo->SQL;
                 event.Key.Status = responseInfo->OK;
-                event.Key.ConnKey = mKey;
+                event.Key.ConnKey = &mKey;
                 return true;
             });
     }
@@ -21,10 +21,7 @@
 namespace logtail {
 
 using MySQLProtocolEventKey = DBAggKey<ProtocolType_MySQL>;
-using MySQLProtocolEvent = CommonProtocolEvent<MySQLProtocolEventKey>;
+using MySQLProtocolEvent = CommonProtocolEvent<DBAggKeyView<ProtocolType_MySQL>>;
 using MySQLProtocolEventAggItem = CommonProtocolEventAggItem<MySQLProtocolEventKey, CommonProtocolAggResult>;
-using MySQLProtocolEventAggItemManager = CommonProtocolEventAggItemManager<MySQLProtocolEventAggItem>;
-using MySQLProtocolEventAggregator = CommonProtocolEventAggregator<MySQLProtocolEvent,
-                                                                   MySQLProtocolEventAggItem,
-                                                                   MySQLProtocolEventAggItemManager>;
+using MySQLProtocolEventAggregator = CommonProtocolEventAggregator<MySQLProtocolEvent, MySQLProtocolEventAggItem>;
 } // namespace logtail
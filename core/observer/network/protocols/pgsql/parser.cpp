@@ -55,7 +55,8 @@ ParseResult PgSQLProtocolParser::OnPacket(PacketType pktType,
                 insertSuccess = mCache.InsertReq([&](PgSQLRequestInfo* info) {
                     info->TimeNano = header->TimeNano;
                     info->ReqBytes = pktRealSize;
-                    info->SQL = pgsql.query.sql.ToString();
+                    info->SQL.assign(pgsql.query.sql.mPtr, pgsql.query.sql.mLen);
+                    AssignQueryCmd(info->QueryCmd, info->SQL);
                     LOG_TRACE(sLogger, ("pgsql insert req", info->ToString()));
                 });
                 break;
@@ -64,7 +65,8 @@ ParseResult PgSQLProtocolParser::OnPacket(PacketType pktType,
                 insertSuccess = mCache.InsertReq([&](PgSQLRequestInfo* info) {
                     info->TimeNano = 0;
                     info->ReqBytes = PGSQL_REQUEST_INFO_IGNORE_FLAG;
-                    info->SQL = "";
+                    info->SQL.clear();
+                    info->QueryCmd.clear();
                     LOG_TRACE(sLogger, ("pgsql insert req", info->ToString()));
                 });
                 break;
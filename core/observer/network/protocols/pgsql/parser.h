@@ -32,6 +32,7 @@ namespace logtail {
 struct PgSQLRequestInfo {
     uint64_t TimeNano;
     std::string SQL;
+    std::string QueryCmd;
     int32_t ReqBytes;
 
     friend std::ostream& operator<<(std::ostream& os, const PgSQLRequestInfo& info);
@@ -76,9 +77,9 @@ public:
                 }
                 event.Info.ReqBytes = requestInfo->ReqBytes;
                 event.Info.RespBytes = responseInfo->RespBytes;
-                event.Key.ConnKey = mKey;
-                event.Key.QueryCmd = ToLowerCaseString(requestInfo->SQL.substr(0, requestInfo->SQL.find_first_of(' ')));
-                event.Key.Query = std::move(requestInfo->SQL);
+                event.Key.ConnKey = &mKey;
+                event.Key.QueryCmd = requestInfo->QueryCmd;
+                event.Key.Query = requestInfo->SQL;
                 event.Key.Status = responseInfo->OK;
                 return true;
             });
@@ -21,9 +21,7 @@
 namespace logtail {
 
 using PgSQLProtocolEventKey = DBAggKey<ProtocolType_PgSQL>;
-using PgSQLProtocolEvent = CommonProtocolEvent<PgSQLProtocolEventKey>;
+using PgSQLProtocolEvent = CommonProtocolEvent<DBAggKeyView<ProtocolType_PgSQL>>;
 using PgSQLProtocolEventAggItem = CommonProtocolEventAggItem<PgSQLProtocolEventKey, CommonProtocolAggResult>;
-using PgSQLProtocolEventAggItemManager = CommonProtocolEventAggItemManager<PgSQLProtocolEventAggItem>;
-using PgSQLProtocolEventAggregator
-    = CommonProtocolEventAggregator<PgSQLProtocolEvent, PgSQLProtocolEventAggItem, PgSQLProtocolEventAggItemManager>;
+using PgSQLProtocolEventAggregator = CommonProtocolEventAggregator<PgSQLProtocolEvent, PgSQLProtocolEventAggItem>;
 } // namespace logtail
@@ -29,6 +29,12 @@ struct RedisData {
 
     std::string GetCommands() {
         std::string cmd;
+        GetCommands(cmd);
+        return cmd;
+    }
+
+    void GetCommands(std::string& cmd) {
+        cmd.clear();
         for (auto iter = data.begin(); iter < data.end(); iter++) {
             if ((iter + 1) != data.end()) {
                 cmd.append(iter->mPtr, iter->mLen).append(" ");
@@ -36,7 +42,6 @@ struct RedisData {
                 cmd.append(iter->mPtr, iter->mLen);
             }
         }
-        return cmd;
     }
 };
 
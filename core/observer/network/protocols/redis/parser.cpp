@@ -57,7 +57,8 @@ ParseResult RedisProtocolParser::OnPacket(PacketType pktType,
             insertSuccess = mCache.InsertReq([&](RedisRequestInfo* info) {
                 info->TimeNano = header->TimeNano;
                 info->ReqBytes = pktRealSize;
-                info->CMD = redis.redisData.GetCommands();
+                redis.redisData.GetCommands(info->CMD);
+                AssignQueryCmd(info->QueryCmd, info->CMD);
                 LOG_TRACE(sLogger, ("redis insert req", info->ToString()));
             });
         } else if (msgType == MessageType_Response) {
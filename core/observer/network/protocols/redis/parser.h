@@ -31,6 +31,7 @@ namespace logtail {
 struct RedisRequestInfo {
     uint64_t TimeNano;
     std::string CMD;
+    std::string QueryCmd;
     int32_t ReqBytes;
 
     std::string ToString() const {
@@ -68,9 +69,9 @@ public:
             }
             event.Info.ReqBytes = req->ReqBytes;
             event.Info.RespBytes = resp->RespBytes;
-            event.Key.ConnKey = mKey;
-            event.Key.QueryCmd = ToLowerCaseString(req->CMD.substr(0, req->CMD.find_first_of(' ')));
-            event.Key.Query = std::move(req->CMD);
+            event.Key.ConnKey = &mKey;
+            event.Key.QueryCmd = req->QueryCmd;
+            event.Key.Query = req->CMD;
             event.Key.Status = resp->isOK;
             return true;
         });
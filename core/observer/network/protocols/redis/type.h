@@ -22,9 +22,7 @@
 namespace logtail {
 
 using RedisProtocolEventKey = DBAggKey<ProtocolType_Redis>;
-using RedisProtocolEvent = CommonProtocolEvent<RedisProtocolEventKey>;
+using RedisProtocolEvent = CommonProtocolEvent<DBAggKeyView<ProtocolType_Redis>>;
 using RedisProtocolEventAggItem = CommonProtocolEventAggItem<RedisProtocolEventKey, CommonProtocolAggResult>;
-using RedisProtocolEventAggItemManager = CommonProtocolEventAggItemManager<RedisProtocolEventAggItem>;
-using RedisProtocolEventAggregator
-    = CommonProtocolEventAggregator<RedisProtocolEvent, RedisProtocolEventAggItem, RedisProtocolEventAggItemManager>;
+using RedisProtocolEventAggregator = CommonProtocolEventAggregator<RedisProtocolEvent, RedisProtocolEventAggItem>;
 } // namespace logtail
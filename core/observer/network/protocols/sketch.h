@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace logtail {
+
+/**
+ * LatencySketch is a mergeable quantile sketch for latencies (DDSketch).
+ *
+ * A positive value v is counted in bucket ceil(log(v) / log(gamma)), where gamma = (1 + a) / (1 - a), so that any
+ * quantile is estimated with relative error a. Non-positive values are counted separately. Buckets are kept in a dense
+ * array starting from the lowest used index, and when more than kMaxBucketCount buckets are needed, the lowest ones
+ * are collapsed, so that memory is bounded and high quantiles stay accurate.
+ */
+class LatencySketch {
+public:
+    static constexpr double kRelativeAccuracy = 0.02;
+    static constexpr size_t kMaxBucketCount = 256;
+
+    void Add(int64_t value) {
+        ++mCount;
+        if (value <= 0) {
+            ++mZeroCount;
+            return;
+        }
+        int32_t index = static_cast<int32_t>(std::ceil(std::log(static_cast<double>(value)) * kInvLogGamma));
+        ++mBuckets[ReserveBucket(index)];
+    }
+
+    void Merge(const LatencySketch& other) {
+        if (other.mCount == 0) {
+            return;
+        }
+        mCount += other.mCount;
+        mZeroCount += other.mZeroCount;
+        if (other.mBuckets.empty()) {
+            return;
+        }
+        // reserve the highest index first, so that collapsing happens at most once
+        ReserveBucket(other.mMinIndex + static_cast<int32_t>(other.mBuckets.size()) - 1);
+        for (size_t i = 0; i < other.mBuckets.size(); ++i) {
+            if (other.mBuckets[i] != 0) {
+                mBuckets[ReserveBucket(other.mMinIndex + static_cast<int32_t>(i))] += other.mBuckets[i];
+            }
+        }
+    }
+
+    void Clear() {
+        mCount = 0;
+        mZeroCount = 0;
+        mMinIndex = 0;
+        mBuckets.clear();
+    }
+
+    bool IsEmpty() const { return mCount == 0; }
+    uint64_t GetCount() const { return mCount; }
+
+    /**
+     * @param q quantile in [0, 1]
+     * @return the estimated value of quantile q, or 0 if the sketch is empty
+     */
+    int64_t Quantile(double q) const {
+        if (mCount == 0) {
+            return 0;
+        }
+        q = q < 0 ? 0 : (q > 1 ? 1 : q);
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(mCount - 1));
+        if (rank < mZeroCount) {
+            return 0;
+        }
+        uint64_t seen = mZeroCount;
+        for (size_t i = 0; i < mBuckets.size(); ++i) {
+            seen += mBuckets[i];
+            if (seen > rank) {
+                return BucketValue(mMinIndex + static_cast<int32_t>(i));
+            }
+        }
+        return BucketValue(mMinIndex + static_cast<int32_t>(mBuckets.size()) - 1);
+    }
+
+    /**
+     * Serialize the sketch as "<relative accuracy>;<non-positive count>;<lowest bucket index>;<bucket counts>", where
+     * bucket counts are separated by ',' and empty buckets are written as empty strings, e.g. "0.02;0;512;3,,1".
+     */
+    std::string Serialize() const {
+        static_assert(kRelativeAccuracy == 0.02, "the serialized relative accuracy should be updated");
+        std::string res;
+        res.reserve(16 + mBuckets.size() * 2);
+        res.append("0.02;").append(std::to_string(mZeroCount)).append(";");
+        res.append(std::to_string(mMinIndex)).append(";");
+        for (size_t i = 0; i < mBuckets.size(); ++i) {
+            if (i != 0) {
+                res.push_back(',');
+            }
+            if (mBuckets[i] != 0) {
+                res.append(std::to_string(mBuckets[i]));
+            }
+        }
+        return res;
+    }
+
+private:
+    static constexpr double kGamma = (1 + kRelativeAccuracy) / (1 - kRelativeAccuracy);
+    static inline const double kInvLogGamma = 1 / std::log(kGamma);
+
+    // BucketValue returns the value with the same relative error to both ends of the bucket
+    static int64_t BucketValue(int32_t index) {
+        return static_cast<int64_t>(std::pow(kGamma, index) * 2 / (1 + kGamma));
+    }
+
+    // ReserveBucket extends the buckets to contain @index, and returns the position of the bucket for @index, which
+    // may be the lowest bucket if @index is collapsed.
+    size_t ReserveBucket(int32_t index) {
+        if (mBuckets.empty()) {
+            mMinIndex = index;
+            mBuckets.resize(1);
+            return 0;
+        }
+        int32_t maxIndex = mMinIndex + static_cast<int32_t>(mBuckets.size()) - 1;
+        if (index > maxIndex) {
+            mBuckets.resize(mBuckets.size() + (index - maxIndex));
+            if (mBuckets.size() > kMaxBucketCount) {
+                CollapseLowest(mBuckets.size() - kMaxBucketCount);
+            }
+        } else if (index < mMinIndex) {
+            size_t extra = mMinIndex - index;
+            if (mBuckets.size() + extra > kMaxBucketCount) {
+                extra = mBuckets.size() < kMaxBucketCount ? kMaxBucketCount - mBuckets.size() : 0;
+            }
+            mBuckets.insert(mBuckets.begin(), extra, 0);
+            mMinIndex -= static_cast<int32_t>(extra);
+        }
+        return index < mMinIndex ? 0 : static_cast<size_t>(index - mMinIndex);
+    }
+
+    void CollapseLowest(size_t n) {
+        uint64_t collapsed = 0;
+        for (size_t i = 0; i <= n; ++i) {
+            collapsed += mBuckets[i];
+        }
+        mBuckets.erase(mBuckets.begin(), mBuckets.begin() + n);
+        mBuckets[0] = collapsed;
+        mMinIndex += static_cast<int32_t>(n);
+    }
+
+    uint64_t mCount = 0;
+    uint64_t mZeroCount = 0;
+    int32_t mMinIndex = 0;
+    std::vector<uint64_t> mBuckets;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class LatencySketchUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -24,7 +24,9 @@
 #include <sstream>
 #include <iomanip>
 #include <map>
+#include <cctype>
 #include <cstring>
+#include <string>
 
 namespace logtail {
 struct SlsStringPiece {
@@ -111,6 +113,15 @@ struct SlsStringPiece {
     }
 };
 
+// Assigns the first word of query in lower case to cmd, which is the command of a db aggregation key.
+inline void AssignQueryCmd(std::string& cmd, const std::string& query) {
+    size_t len = query.find(' ');
+    cmd.assign(query, 0, len);
+    for (auto& c : cmd) {
+        c = (char)std::tolower((unsigned char)c);
+    }
+}
+
 inline void hexstring_to_bin(std::string s, std::vector<uint8_t>& dest) {
     auto p = s.data();
     auto end = p + s.length();
@@ -0,0 +1,183 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "parser/DelimiterModeSimdParser.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace logtail {
+
+namespace {
+
+const size_t kBlockSize = 64;
+
+// PrefixXor sets bit i to the xor of bits [0, i], i.e. bytes after an odd number of quotes are inside quotes.
+inline uint64_t PrefixXor(uint64_t x) {
+#if defined(__PCLMUL__)
+    __m128i res = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(x)), _mm_set1_epi8(-1), 0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(res));
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+// x must not be 0.
+inline int CountTrailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return static_cast<int>(idx);
+#else
+    int n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+} // namespace
+
+DelimiterModeSimdParser::DelimiterModeSimdParser(char quote, char separator) : mQuote(quote), mSeparator(separator) {
+    while (mPadding == mQuote || mPadding == mSeparator) {
+        ++mPadding;
+    }
+}
+
+void DelimiterModeSimdParser::buildMasks(const char* block, uint64_t& quoteMask, uint64_t& separatorMask) const {
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8(mQuote);
+    const __m128i separator = _mm_set1_epi8(mSeparator);
+    quoteMask = 0;
+    separatorMask = 0;
+    for (size_t i = 0; i < kBlockSize; i += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        quoteMask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, quote)))) << i;
+        separatorMask
+            |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, separator)))) << i;
+    }
+#else
+    quoteMask = 0;
+    separatorMask = 0;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        quoteMask |= static_cast<uint64_t>(block[i] == mQuote) << i;
+        separatorMask |= static_cast<uint64_t>(block[i] == mSeparator) << i;
+    }
+#endif
+}
+
+bool DelimiterModeSimdParser::ParseDelimiterLine(
+    StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event) const {
+    const char* ch = buffer.data();
+    size_t fieldBegin = begin;
+    bool fieldHasQuote = false;
+    // all ones if the previous block ends inside quotes
+    uint64_t inQuoteCarry = 0;
+    char padded[kBlockSize];
+    for (size_t pos = begin; pos < static_cast<size_t>(end); pos += kBlockSize) {
+        const char* block = ch + pos;
+        size_t len = end - pos;
+        if (len < kBlockSize) {
+            memset(padded, mPadding, kBlockSize);
+            memcpy(padded, block, len);
+            block = padded;
+        }
+        uint64_t quoteMask = 0, separatorMask = 0;
+        buildMasks(block, quoteMask, separatorMask);
+        uint64_t inQuote = PrefixXor(quoteMask) ^ inQuoteCarry;
+        inQuoteCarry = static_cast<uint64_t>(static_cast<int64_t>(inQuote) >> 63);
+
+        uint64_t boundaries = separatorMask & ~inQuote;
+        while (boundaries != 0) {
+            int bit = CountTrailingZeros(boundaries);
+            uint64_t before = bit == 0 ? 0 : (~0ULL >> (64 - bit));
+            if (!addField(ch, fieldBegin, pos + bit, fieldHasQuote || (quoteMask & before) != 0, columnValues, event)) {
+                columnValues.clear();
+                return false;
+            }
+            // quotes before the separator belong to the field just added
+            quoteMask &= ~before;
+            fieldBegin = pos + bit + 1;
+            fieldHasQuote = false;
+            boundaries &= boundaries - 1;
+        }
+        fieldHasQuote = fieldHasQuote || quoteMask != 0;
+    }
+    if (!addField(ch, fieldBegin, end, fieldHasQuote, columnValues, event)) {
+        columnValues.clear();
+        return false;
+    }
+    return true;
+}
+
+bool DelimiterModeSimdParser::addField(const char* buffer,
+                                       size_t fieldBegin,
+                                       size_t fieldEnd,
+                                       bool hasQuote,
+                                       std::vector<StringView>& columnValues,
+                                       LogEvent& event) const {
+    if (!hasQuote) {
+        columnValues.emplace_back(buffer + fieldBegin, fieldEnd - fieldBegin);
+        return true;
+    }
+    // a field with quotes must be a quoted field, in which quotes are escaped by doubling them
+    if (fieldEnd - fieldBegin < 2 || buffer[fieldBegin] != mQuote || buffer[fieldEnd - 1] != mQuote) {
+        return false;
+    }
+    const char* begin = buffer + fieldBegin + 1;
+    const char* end = buffer + fieldEnd - 1;
+    size_t escapedNum = 0;
+    for (const char* p = begin; (p = static_cast<const char*>(memchr(p, mQuote, end - p))) != nullptr; p += 2) {
+        if (p + 1 >= end || p[1] != mQuote) {
+            return false;
+        }
+        ++escapedNum;
+    }
+    if (escapedNum == 0) {
+        columnValues.emplace_back(begin, end - begin);
+        return true;
+    }
+    size_t size = end - begin - escapedNum;
+    StringBuffer sb = event.GetSourceBuffer()->AllocateStringBuffer(size);
+    char* field = sb.data;
+    for (const char* p = begin; p < end; ++p) {
+        *field++ = *p;
+        if (*p == mQuote) {
+            ++p;
+        }
+    }
+    columnValues.emplace_back(sb.data, size);
+    return true;
+}
+
+} // namespace logtail
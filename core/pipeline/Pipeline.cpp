@@ -30,6 +30,7 @@
 #include "pipeline/queue/ProcessQueueManager.h"
 #include "pipeline/queue/QueueKeyManager.h"
 #include "pipeline/queue/SenderQueueManager.h"
+#include "runner/ProcessSliceRunner.h"
 
 DECLARE_FLAG_INT32(default_plugin_log_queue_size);
 
@@ -343,15 +344,35 @@ void Pipeline::Process(vector<PipelineEventGroup>& logGroupList, size_t inputInd
     for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
         p->Process(logGroupList);
     }
+    if (!ProcessSliceRunner::GetInstance()->IsEnabled()) {
+        for (auto& p : mProcessorLine) {
+            p->Process(logGroupList);
+        }
+        return;
+    }
+    // consecutive parallelizable processors run together on slices of a large group
+    vector<ProcessorInstance*> parallelProcessors;
     for (auto& p : mProcessorLine) {
+        if (p->IsParallelizable()) {
+            parallelProcessors.push_back(p.get());
+            continue;
+        }
+        if (!parallelProcessors.empty()) {
+            ProcessSliceRunner::GetInstance()->Process(parallelProcessors, logGroupList);
+            parallelProcessors.clear();
+        }
         p->Process(logGroupList);
     }
+    if (!parallelProcessors.empty()) {
+        ProcessSliceRunner::GetInstance()->Process(parallelProcessors, logGroupList);
+    }
 }
 
 bool Pipeline::Send(vector<PipelineEventGroup>&& groupList) {
     bool allSucceeded = true;
+    vector<size_t> routeBuffer;
     for (auto& group : groupList) {
-        auto flusherIdx = mRouter.Route(group);
+        const auto& flusherIdx = mRouter.Route(group, routeBuffer);
         for (size_t i = 0; i < flusherIdx.size(); ++i) {
             if (flusherIdx[i] >= mFlushers.size()) {
                 LOG_ERROR(
@@ -389,7 +410,7 @@ void Pipeline::Stop(bool isRemoving) {
         // TODO: 卸载该Go流水线
     }
 
-    // TODO: 禁用Process中改流水线对应的输入队列
+    // pop of the process queue is disabled by PipelineManager before the pipeline is stopped
 
     if (!isRemoving) {
         FlushBatch();
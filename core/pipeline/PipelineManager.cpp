@@ -68,6 +68,10 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
                             isInputStreamChanged,
                             isInputContainerStdioChanged);
     }
+    // Go pipelines can only be reloaded all together, so the Go runtime is held on only when Go pipelines are changed.
+    // Process threads hand groups of pipelines flushing through Go to the Go runtime, which must not happen while Go
+    // configs are being reloaded, so process threads are held on as well in this case.
+    bool isGoPipelineChanged = CheckIfGoPipelineUpdated(diff);
 
 #if defined(__ENTERPRISE__) && defined(__linux__) && !defined(__ANDROID__)
     if (AppConfig::GetInstance()->ShennongSocketEnabled()) {
@@ -85,18 +89,14 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
     if (isFileServerStarted && (isInputFileChanged || isInputContainerStdioChanged)) {
         FileServer::GetInstance()->Pause();
     }
-    LogProcess::GetInstance()->HoldOn();
-    LogtailPlugin::GetInstance()->HoldOn(false);
+    if (isGoPipelineChanged) {
+        LogProcess::GetInstance()->HoldOn();
+        LogtailPlugin::GetInstance()->HoldOn(false);
+    }
 #endif
 
-    for (const auto& name : diff.mRemoved) {
-        auto iter = mPipelineNameEntityMap.find(name);
-        iter->second->Stop(true);
-        DecreasePluginUsageCnt(iter->second->GetPluginStatistics());
-        iter->second->RemoveProcessQueue();
-        mPipelineNameEntityMap.erase(iter);
-        ConfigFeedbackReceiver::GetInstance().FeedbackPipelineConfigStatus(name, ConfigFeedbackStatus::DELETED);
-    }
+    // new pipelines are built while the old ones are still running
+    vector<pair<string, shared_ptr<Pipeline>>> modifiedPipelines;
     for (auto& config : diff.mModified) {
         auto p = BuildPipeline(std::move(config));
         if (!p) {
@@ -118,13 +118,46 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
         LOG_INFO(sLogger,
                  ("pipeline building for existing config succeeded",
                   "stop the old pipeline and start the new one")("config", config.mName));
+        modifiedPipelines.emplace_back(config.mName, std::move(p));
+    }
 
-        auto iter = mPipelineNameEntityMap.find(config.mName);
+    // process threads must not use a pipeline being stopped, so pop of its process queue is disabled and the items
+    // already popped are waited for. Other pipelines are not affected except for this short wait.
+    for (const auto& name : diff.mRemoved) {
+        ProcessQueueManager::GetInstance()->InvalidatePop(name);
+    }
+    for (const auto& item : modifiedPipelines) {
+        ProcessQueueManager::GetInstance()->InvalidatePop(item.first);
+    }
+#ifndef APSARA_UNIT_TEST_MAIN
+    // when process threads are held on, no item is being processed
+    if (!isGoPipelineChanged && (!diff.mRemoved.empty() || !modifiedPipelines.empty())) {
+        LogProcess::GetInstance()->WaitForPoppedItems();
+    }
+#endif
+
+    for (const auto& name : diff.mRemoved) {
+        auto iter = mPipelineNameEntityMap.find(name);
+        iter->second->Stop(true);
+        DecreasePluginUsageCnt(iter->second->GetPluginStatistics());
+        iter->second->RemoveProcessQueue();
+        {
+            WriteLock lock(mPipelineNameEntityMapLock);
+            mPipelineNameEntityMap.erase(iter);
+        }
+        ConfigFeedbackReceiver::GetInstance().FeedbackPipelineConfigStatus(name, ConfigFeedbackStatus::DELETED);
+    }
+    for (auto& item : modifiedPipelines) {
+        auto iter = mPipelineNameEntityMap.find(item.first);
         iter->second->Stop(false);
         DecreasePluginUsageCnt(iter->second->GetPluginStatistics());
-        mPipelineNameEntityMap[config.mName] = p;
-        IncreasePluginUsageCnt(p->GetPluginStatistics());
-        p->Start();
+        {
+            WriteLock lock(mPipelineNameEntityMapLock);
+            iter->second = item.second;
+        }
+        IncreasePluginUsageCnt(item.second->GetPluginStatistics());
+        item.second->Start();
+        ProcessQueueManager::GetInstance()->ValidatePop(item.first);
     }
     for (auto& config : diff.mAdded) {
         auto p = BuildPipeline(std::move(config));
@@ -144,22 +177,29 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
         LOG_INFO(sLogger,
                  ("pipeline building for new config succeeded", "begin to start pipeline")("config", config.mName));
         ConfigFeedbackReceiver::GetInstance().FeedbackPipelineConfigStatus(config.mName, ConfigFeedbackStatus::APPLIED);
-        mPipelineNameEntityMap[config.mName] = p;
+        {
+            WriteLock lock(mPipelineNameEntityMapLock);
+            mPipelineNameEntityMap[config.mName] = p;
+        }
         IncreasePluginUsageCnt(p->GetPluginStatistics());
         p->Start();
     }
 
 #ifndef APSARA_UNIT_TEST_MAIN
-    // 过渡使用，有变更的流水线的Go流水线加载在BuildPipeline中完成
-    for (auto& name : diff.mUnchanged) {
-        mPipelineNameEntityMap[name]->LoadGoPipelines();
+    if (isGoPipelineChanged) {
+        // 过渡使用，有变更的流水线的Go流水线加载在BuildPipeline中完成
+        for (auto& name : diff.mUnchanged) {
+            mPipelineNameEntityMap[name]->LoadGoPipelines();
+        }
     }
     // 在Flusher改造完成前，先不执行如下步骤，不会造成太大影响
     // Sender::CleanUnusedAk();
 
     // 过渡使用
-    LogtailPlugin::GetInstance()->Resume();
-    LogProcess::GetInstance()->Resume();
+    if (isGoPipelineChanged) {
+        LogtailPlugin::GetInstance()->Resume();
+        LogProcess::GetInstance()->Resume();
+    }
     if (isInputFileChanged || isInputContainerStdioChanged) {
         if (isFileServerStarted) {
             FileServer::GetInstance()->Resume();
@@ -200,6 +240,7 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
 }
 
 shared_ptr<Pipeline> PipelineManager::FindConfigByName(const string& configName) const {
+    ReadLock lock(mPipelineNameEntityMapLock);
     auto it = mPipelineNameEntityMap.find(configName);
     if (it != mPipelineNameEntityMap.end()) {
         return it->second;
@@ -209,6 +250,7 @@ shared_ptr<Pipeline> PipelineManager::FindConfigByName(const string& configName)
 
 vector<string> PipelineManager::GetAllConfigNames() const {
     vector<string> res;
+    ReadLock lock(mPipelineNameEntityMapLock);
     for (const auto& item : mPipelineNameEntityMap) {
         res.push_back(item.first);
     }
@@ -272,6 +314,7 @@ shared_ptr<Pipeline> PipelineManager::BuildPipeline(PipelineConfig&& config) {
 }
 
 void PipelineManager::FlushAllBatch() {
+    ReadLock lock(mPipelineNameEntityMapLock);
     for (const auto& item : mPipelineNameEntityMap) {
         item.second->FlushBatch();
     }
@@ -293,6 +336,26 @@ void PipelineManager::DecreasePluginUsageCnt(const unordered_map<string, unorder
     }
 }
 
+bool PipelineManager::CheckIfGoPipelineUpdated(const PipelineConfigDiff& diff) const {
+    for (const auto& name : diff.mRemoved) {
+        if (mPipelineNameEntityMap.at(name)->HasGoPipelines()) {
+            return true;
+        }
+    }
+    for (const auto& config : diff.mModified) {
+        if (config.HasGoPlugin() || config.IsFlushingThroughGoPipelineExisted()
+            || mPipelineNameEntityMap.at(config.mName)->HasGoPipelines()) {
+            return true;
+        }
+    }
+    for (const auto& config : diff.mAdded) {
+        if (config.HasGoPlugin() || config.IsFlushingThroughGoPipelineExisted()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void PipelineManager::CheckIfInputUpdated(const Json::Value& config,
                                           bool& isInputObserverChanged,
                                           bool& isInputFileChanged,
@@ -57,6 +57,7 @@ private:
     void DecreasePluginUsageCnt(
         const std::unordered_map<std::string, std::unordered_map<std::string, uint32_t>>& statistics);
     void FlushAllBatch();
+    bool CheckIfGoPipelineUpdated(const PipelineConfigDiff& diff) const;
     // 过渡使用
     void CheckIfInputUpdated(const Json::Value& config,
                              bool& isInputObserverChanged,
@@ -64,6 +65,8 @@ private:
                              bool& isInputStreamChanged,
                              bool& isInputContainerStdioChanged);
 
+    // pipelines are published and unpublished with the write lock, while process threads look them up concurrently
+    mutable ReadWriteLock mPipelineNameEntityMapLock;
     std::unordered_map<std::string, std::shared_ptr<Pipeline>> mPipelineNameEntityMap;
     mutable SpinLock mPluginCntMapLock;
     std::unordered_map<std::string, std::unordered_map<std::string, uint32_t>> mPluginCntMap;
@@ -14,25 +14,86 @@
 
 #include "pipeline/limiter/ConcurrencyLimiter.h"
 
+#include <algorithm>
+
+#include "monitor/MetricConstants.h"
+
 using namespace std;
 
 namespace logtail {
 
+ConcurrencyLimiter::ConcurrencyLimiter(uint32_t maxLimit, uint32_t minLimit, MetricLabels&& labels)
+    : mMaxLimit(max(maxLimit, 1U)), mMinLimit(min(max(minLimit, 1U), mMaxLimit)), mLimit(mMaxLimit) {
+    if (!labels.empty()) {
+        WriteMetrics::GetInstance()->PrepareMetricsRecordRef(mMetricsRecordRef, std::move(labels));
+        mLimitGauge = mMetricsRecordRef.CreateIntGauge(METRIC_CONCURRENCY_LIMITER_LIMIT);
+        mInSendingCntGauge = mMetricsRecordRef.CreateIntGauge(METRIC_CONCURRENCY_LIMITER_IN_SENDING_TOTAL);
+        UpdateMetrics();
+    }
+}
+
 bool ConcurrencyLimiter::IsValidToPop() {
-    return mLimit != 0;
+    return mInSendingCnt < mLimit;
 }
 
 void ConcurrencyLimiter::PostPop() {
-    if (mLimit <= 0) {
-        return;
+    uint32_t cnt = ++mInSendingCnt;
+    if (mInSendingCntGauge) {
+        mInSendingCntGauge->Set(cnt);
     }
-    --mLimit;
 }
 
-void ConcurrencyLimiter::OnSuccess() {
+void ConcurrencyLimiter::OnSendDone() {
+    // items popped without limits, e.g. on exit, are not counted
+    uint32_t cnt = mInSendingCnt;
+    while (cnt > 0 && !mInSendingCnt.compare_exchange_weak(cnt, cnt - 1)) {
+    }
+    if (mInSendingCntGauge && cnt > 0) {
+        mInSendingCntGauge->Set(cnt - 1);
+    }
+}
+
+void ConcurrencyLimiter::OnSuccess(time_t curTime, uint32_t responseTimeMs) {
+    lock_guard<mutex> lock(mMux);
+    if (responseTimeMs > 0) {
+        if (mMinResponseTimeMs == 0 || responseTimeMs < mMinResponseTimeMs) {
+            mMinResponseTimeMs = responseTimeMs;
+        } else if (responseTimeMs > mMinResponseTimeMs * sSlowResponseFactor
+                   && responseTimeMs > mMinResponseTimeMs + sSlowResponseMinGapMs) {
+            Decrease(curTime, sSlowDecreaseRatio);
+            return;
+        }
+    }
+    if (++mSuccessCnt >= mLimit) {
+        mSuccessCnt = 0;
+        if (mLimit < mMaxLimit) {
+            ++mLimit;
+            UpdateMetrics();
+        }
+    }
 }
 
 void ConcurrencyLimiter::OnFail(time_t curTime) {
+    lock_guard<mutex> lock(mMux);
+    Decrease(curTime, sFailDecreaseRatio);
+}
+
+void ConcurrencyLimiter::Decrease(time_t curTime, double ratio) {
+    mSuccessCnt = 0;
+    if (curTime == mLastDecreaseTime) {
+        return;
+    }
+    mLastDecreaseTime = curTime;
+    // the lowest response time may be stale after the backend changes, so it is learned again
+    mMinResponseTimeMs = 0;
+    mLimit = max(mMinLimit, static_cast<uint32_t>(mLimit * ratio));
+    UpdateMetrics();
+}
+
+void ConcurrencyLimiter::UpdateMetrics() {
+    if (mLimitGauge) {
+        mLimitGauge->Set(mLimit);
+    }
 }
 
 } // namespace logtail
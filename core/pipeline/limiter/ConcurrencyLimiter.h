@@ -17,25 +17,81 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <ctime>
+#include <mutex>
+
+#include "monitor/LogtailMetric.h"
 
 namespace logtail {
 
+// ConcurrencyLimiter limits the number of requests being sent, e.g. to one region or one project.
+//
+// The limit is adjusted with additive increase and multiplicative decrease: it grows by 1 after a full window of
+// successful requests, i.e. as many successes as the current limit, and is halved on congestion errors such as quota
+// exceeded or server errors. A response time far above the lowest one observed is considered as early congestion, and
+// the limit is decreased slightly. Decreases are applied at most once per second, since requests of the same window
+// usually fail together.
 class ConcurrencyLimiter {
 public:
+    static constexpr uint32_t sDefaultMaxLimit = 80;
+
+    explicit ConcurrencyLimiter(uint32_t maxLimit = sDefaultMaxLimit,
+                                uint32_t minLimit = 1,
+                                MetricLabels&& labels = MetricLabels());
+
     bool IsValidToPop();
     void PostPop();
-    void OnSuccess();
+    // OnSendDone returns the concurrency taken by PostPop, whatever the result is.
+    void OnSendDone();
+    void OnSuccess(time_t curTime, uint32_t responseTimeMs = 0);
     void OnFail(time_t curTime);
 
+    uint32_t GetCurrentLimit() const { return mLimit; }
+    uint32_t GetInSendingCount() const { return mInSendingCnt; }
+
 #ifdef APSARA_UNIT_TEST_MAIN
-    void Reset() { mLimit = -1; }
-    void SetLimit(int limit) { mLimit = limit; }
-    int GetLimit() const { return mLimit; }
+    void Reset() {
+        mLimit = mMaxLimit;
+        mInSendingCnt = 0;
+        mSuccessCnt = 0;
+        mMinResponseTimeMs = 0;
+        mLastDecreaseTime = 0;
+    }
+    void SetLimit(uint32_t limit) { mLimit = limit; }
+    uint32_t GetLimit() const { return mLimit; }
 #endif
 
 private:
-    std::atomic_int mLimit = -1;
+    // the limit is decreased to this ratio of itself when requests fail
+    static constexpr double sFailDecreaseRatio = 0.5;
+    // the limit is decreased to this ratio of itself when requests are much slower than before
+    static constexpr double sSlowDecreaseRatio = 0.9;
+    // a response is slow if its response time exceeds both the lowest one by this factor and by sSlowResponseMinGapMs
+    static constexpr uint32_t sSlowResponseFactor = 3;
+    static constexpr uint32_t sSlowResponseMinGapMs = 100;
+
+    void Decrease(time_t curTime, double ratio);
+    void UpdateMetrics();
+
+    const uint32_t mMaxLimit;
+    const uint32_t mMinLimit;
+    std::atomic_uint32_t mLimit;
+    std::atomic_uint32_t mInSendingCnt{0};
+
+    // for limit adjustment only, which happens after requests are sent
+    std::mutex mMux;
+    uint32_t mSuccessCnt = 0;
+    uint32_t mMinResponseTimeMs = 0;
+    time_t mLastDecreaseTime = 0;
+
+    MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mLimitGauge;
+    IntGaugePtr mInSendingCntGauge;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ConcurrencyLimiterUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -36,6 +36,7 @@ public:
 
     bool Init(const Json::Value& config, PipelineContext& context);
     void Process(std::vector<PipelineEventGroup>& logGroupList);
+    bool IsParallelizable() const { return mPlugin->IsParallelizable(); }
 
 private:
     std::unique_ptr<Processor> mPlugin;
@@ -84,6 +84,7 @@ bool Flusher::PushToQueue(unique_ptr<SenderQueueItem>&& item, uint32_t retryTime
 }
 
 void Flusher::DealSenderQueueItemAfterSend(SenderQueueItem* item, bool keep) {
+    item->ReleaseConcurrency();
     if (keep) {
         item->mStatus = SendingStatus::IDLE;
         ++item->mTryCnt;
@@ -30,6 +30,9 @@ public:
 
     virtual bool Init(const Json::Value& config) = 0;
     virtual void Process(std::vector<PipelineEventGroup>& logGroupList);
+    // IsParallelizable returns true if a group can be split into slices of events which are processed concurrently,
+    // i.e. each event is processed on its own, the group is only read, and Process is thread safe.
+    virtual bool IsParallelizable() const { return false; }
 
 protected:
     virtual bool IsSupportedEvent(const PipelineEventPtr& e) const = 0;
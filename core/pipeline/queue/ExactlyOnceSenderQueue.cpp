@@ -124,6 +124,7 @@ void ExactlyOnceSenderQueue::GetAllAvailableItems(vector<SenderQueueItem*>& item
             if (withLimits) {
                 for (auto& limiter : mConcurrencyLimiters) {
                     limiter->PostPop();
+                    item->mConcurrencyLimiters.emplace_back(limiter);
                 }
                 if (mRateLimiter) {
                     mRateLimiter->PostPop(item->mRawSize);
@@ -95,6 +95,7 @@ void SenderQueue::GetAllAvailableItems(vector<SenderQueueItem*>& items, bool wit
                 for (auto& limiter : mConcurrencyLimiters) {
                     if (limiter != nullptr) {
                         limiter->PostPop();
+                        item->mConcurrencyLimiters.emplace_back(limiter);
                     }
                 }
                 if (mRateLimiter) {
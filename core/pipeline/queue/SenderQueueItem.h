@@ -20,7 +20,9 @@
 #include <ctime>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "pipeline/limiter/ConcurrencyLimiter.h"
 #include "pipeline/queue/QueueKey.h"
 
 namespace logtail {
@@ -44,6 +46,8 @@ struct SenderQueueItem {
     time_t mEnqueTime = 0;
     time_t mLastSendTime = 0;
     uint32_t mTryCnt = 1;
+    // limiters whose concurrency is taken by the item, which should be released once the item is not being sent
+    std::vector<std::shared_ptr<ConcurrencyLimiter>> mConcurrencyLimiters;
 
     SenderQueueItem(std::string&& data,
                     size_t rawSize,
@@ -60,6 +64,13 @@ struct SenderQueueItem {
     virtual ~SenderQueueItem() = default;
 
     virtual SenderQueueItem* Clone() { return new SenderQueueItem(*this); }
+
+    void ReleaseConcurrency() {
+        for (auto& limiter : mConcurrencyLimiters) {
+            limiter->OnSendDone();
+        }
+        mConcurrencyLimiters.clear();
+    }
 };
 
 } // namespace logtail
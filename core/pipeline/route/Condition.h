@@ -29,6 +29,7 @@ class EventTypeCondition {
 public:
     bool Init(const Json::Value& config, const PipelineContext& ctx);
     bool Check(const PipelineEventGroup& g) const;
+    PipelineEvent::Type GetEventType() const { return mType; }
 
 private:
     PipelineEvent::Type mType;
@@ -42,6 +43,8 @@ class TagCondition {
 public:
     bool Init(const Json::Value& config, const PipelineContext& ctx);
     bool Check(const PipelineEventGroup& g) const;
+    const std::string& GetKey() const { return mKey; }
+    const std::string& GetValue() const { return mValue; }
 
 private:
     std::string mKey;
@@ -57,6 +60,9 @@ class Condition {
 public:
     bool Init(const Json::Value& config, const PipelineContext& ctx);
     bool Check(const PipelineEventGroup& g) const;
+    // return nullptr if the condition is not of the corresponding type
+    const EventTypeCondition* GetEventTypeCondition() const { return std::get_if<EventTypeCondition>(&mDetail); }
+    const TagCondition* GetTagCondition() const { return std::get_if<TagCondition>(&mDetail); }
 
 private:
     enum class Type { EVENT_TYPE, TAG };
@@ -14,6 +14,8 @@
 
 #include "pipeline/route/Router.h"
 
+#include <algorithm>
+
 #include "common/ParamExtractor.h"
 #include "pipeline/Pipeline.h"
 #include "pipeline/plugin/interface/Flusher.h"
@@ -33,17 +35,88 @@ bool Router::Init(std::vector<pair<size_t, const Json::Value*>> configs, const P
             mAlwaysMatchedFlusherIdx.push_back(item.first);
         }
     }
+    Compile();
     return true;
 }
 
-vector<size_t> Router::Route(const PipelineEventGroup& g) const {
-    vector<size_t> res(mAlwaysMatchedFlusherIdx);
-    for (size_t i = 0; i < mConditions.size(); ++i) {
-        if (mConditions[i].second.Check(g)) {
-            res.push_back(i);
+const vector<size_t>& Router::Route(const PipelineEventGroup& g, vector<size_t>& buffer) const {
+    if (mConditions.empty()) {
+        return mAlwaysMatchedFlusherIdx;
+    }
+    if (mIsCompiled) {
+        // empty groups are not matched by any event type condition, the same as events of type NONE
+        size_t typeIdx = g.GetEvents().empty() ? 0 : static_cast<size_t>(g.GetEvents()[0]->GetType());
+        size_t valueIdx = mTagValues.size();
+        if (!mTagValues.empty()) {
+            StringView value = g.GetTag(mTagKey);
+            auto it = lower_bound(mTagValues.begin(), mTagValues.end(), value, [](const string& lhs, StringView rhs) {
+                return StringView(lhs) < rhs;
+            });
+            if (it != mTagValues.end() && StringView(*it) == value) {
+                valueIdx = it - mTagValues.begin();
+            }
+        }
+        return mTable[typeIdx * (mTagValues.size() + 1) + valueIdx];
+    }
+
+    buffer = mAlwaysMatchedFlusherIdx;
+    for (const auto& item : mConditions) {
+        if (item.second.Check(g)) {
+            buffer.push_back(item.first);
+        }
+    }
+    return buffer;
+}
+
+void Router::Compile() {
+    mIsCompiled = false;
+    mTagKey.clear();
+    mTagValues.clear();
+    mTable.clear();
+
+    bool hasTagCondition = false;
+    for (const auto& item : mConditions) {
+        const TagCondition* tagCondition = item.second.GetTagCondition();
+        if (tagCondition == nullptr) {
+            continue;
+        }
+        if (hasTagCondition && tagCondition->GetKey() != mTagKey) {
+            mTagKey.clear();
+            mTagValues.clear();
+            return;
+        }
+        hasTagCondition = true;
+        mTagKey = tagCondition->GetKey();
+        mTagValues.push_back(tagCondition->GetValue());
+    }
+    sort(mTagValues.begin(), mTagValues.end());
+    mTagValues.erase(unique(mTagValues.begin(), mTagValues.end()), mTagValues.end());
+
+    size_t rowSize = mTagValues.size() + 1;
+    mTable.resize(sEventTypeCnt * rowSize);
+    for (size_t typeIdx = 0; typeIdx < sEventTypeCnt; ++typeIdx) {
+        for (size_t valueIdx = 0; valueIdx < rowSize; ++valueIdx) {
+            auto& flusherIdx = mTable[typeIdx * rowSize + valueIdx];
+            flusherIdx = mAlwaysMatchedFlusherIdx;
+            const string* tagValue = valueIdx < mTagValues.size() ? &mTagValues[valueIdx] : nullptr;
+            for (const auto& item : mConditions) {
+                if (IsMatched(item.second, static_cast<PipelineEvent::Type>(typeIdx), tagValue)) {
+                    flusherIdx.push_back(item.first);
+                }
+            }
         }
     }
-    return res;
+    mIsCompiled = true;
+}
+
+bool Router::IsMatched(const Condition& condition, PipelineEvent::Type type, const string* tagValue) const {
+    if (const EventTypeCondition* eventTypeCondition = condition.GetEventTypeCondition()) {
+        return type != PipelineEvent::Type::NONE && eventTypeCondition->GetEventType() == type;
+    }
+    if (const TagCondition* tagCondition = condition.GetTagCondition()) {
+        return tagValue != nullptr && tagCondition->GetValue() == *tagValue;
+    }
+    return false;
 }
 
 } // namespace logtail
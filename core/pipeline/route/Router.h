@@ -18,7 +18,7 @@
 
 #include <json/json.h>
 
-#include <optional>
+#include <string>
 #include <vector>
 
 #include "models/PipelineEventGroup.h"
@@ -28,15 +28,34 @@ namespace logtail {
 
 class Flusher;
 
+// Router decides which flushers an event group is sent to.
+//
+// Conditions are compiled at Init into a decision table keyed on the event type of the group and the value of the tag
+// used by tag conditions, each entry of which is the list of matched flushers, so that routing a group takes no
+// condition evaluation and no allocation. Tag values are interned into a sorted list, and values not in the list share
+// one entry. Conditions on more than one tag key are not compiled and are evaluated one by one instead.
 class Router {
 public:
     bool Init(std::vector<std::pair<size_t, const Json::Value*>> config, const PipelineContext& ctx);
-    std::vector<size_t> Route(const PipelineEventGroup& g) const;
+    // Route returns the indices of flushers matched by @g, with always matched flushers coming first. The result refers
+    // either to the compiled table or to @buffer, which is only used when conditions are not compiled.
+    const std::vector<size_t>& Route(const PipelineEventGroup& g, std::vector<size_t>& buffer) const;
 
 private:
+    static constexpr size_t sEventTypeCnt = static_cast<size_t>(PipelineEvent::Type::SPAN) + 1;
+
+    void Compile();
+    bool IsMatched(const Condition& condition, PipelineEvent::Type type, const std::string* tagValue) const;
+
     std::vector<std::pair<size_t, Condition>> mConditions;
     std::vector<size_t> mAlwaysMatchedFlusherIdx;
 
+    bool mIsCompiled = false;
+    std::string mTagKey;
+    std::vector<std::string> mTagValues;
+    // indexed by event type * (mTagValues.size() + 1) + tag value index, where the last index is for other values
+    std::vector<std::vector<size_t>> mTable;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class RouterUnittest;
     friend class PipelineUnittest;
@@ -24,6 +24,7 @@
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
 #include "common/TimeUtil.h"
+#include "monitor/MetricConstants.h"
 #include "pipeline/compression/CompressorFactory.h"
 #include "plugin/flusher/sls/PackIdManager.h"
 #include "plugin/flusher/sls/SLSClientManager.h"
@@ -107,6 +108,11 @@ void FlusherSLS::RecycleResourceIfNotUsed() {
 #endif
 }
 
+static shared_ptr<ConcurrencyLimiter> CreateConcurrencyLimiter(const string& labelKey, const string& labelValue) {
+    uint32_t maxLimit = static_cast<uint32_t>(max(AppConfig::GetInstance()->GetSendRequestConcurrency(), 1));
+    return make_shared<ConcurrencyLimiter>(maxLimit, 1, MetricLabels{{labelKey, labelValue}});
+}
+
 mutex FlusherSLS::sMux;
 unordered_map<string, weak_ptr<ConcurrencyLimiter>> FlusherSLS::sProjectConcurrencyLimiterMap;
 unordered_map<string, weak_ptr<ConcurrencyLimiter>> FlusherSLS::sRegionConcurrencyLimiterMap;
@@ -115,12 +121,12 @@ shared_ptr<ConcurrencyLimiter> FlusherSLS::GetProjectConcurrencyLimiter(const st
     lock_guard<mutex> lock(sMux);
     auto iter = sProjectConcurrencyLimiterMap.find(project);
     if (iter == sProjectConcurrencyLimiterMap.end()) {
-        auto limiter = make_shared<ConcurrencyLimiter>();
+        auto limiter = CreateConcurrencyLimiter(METRIC_LABEL_PROJECT, project);
         sProjectConcurrencyLimiterMap.try_emplace(project, limiter);
         return limiter;
     }
     if (iter->second.expired()) {
-        auto limiter = make_shared<ConcurrencyLimiter>();
+        auto limiter = CreateConcurrencyLimiter(METRIC_LABEL_PROJECT, project);
         iter->second = limiter;
         return limiter;
     }
@@ -131,12 +137,12 @@ shared_ptr<ConcurrencyLimiter> FlusherSLS::GetRegionConcurrencyLimiter(const str
     lock_guard<mutex> lock(sMux);
     auto iter = sRegionConcurrencyLimiterMap.find(region);
     if (iter == sRegionConcurrencyLimiterMap.end()) {
-        auto limiter = make_shared<ConcurrencyLimiter>();
+        auto limiter = CreateConcurrencyLimiter(METRIC_LABEL_REGION, region);
         sRegionConcurrencyLimiterMap.try_emplace(region, limiter);
         return limiter;
     }
     if (iter->second.expired()) {
-        auto limiter = make_shared<ConcurrencyLimiter>();
+        auto limiter = CreateConcurrencyLimiter(METRIC_LABEL_REGION, region);
         iter->second = limiter;
         return limiter;
     }
@@ -617,7 +623,8 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
             cpt->IncreaseSequenceID();
         }
 
-        GetRegionConcurrencyLimiter(mRegion)->OnSuccess();
+        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curTime, response.mResponseTimeMs);
+        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curTime, response.mResponseTimeMs);
         DealSenderQueueItemAfterSend(item, false);
         LOG_DEBUG(sLogger,
                   ("send data to sls succeeded, item address", item)("request id", slsResponse.mRequestId)(
@@ -652,9 +659,12 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
                     }
                 }
             }
+            // the region is congested or unreachable, so fewer requests should be sent to it
+            GetRegionConcurrencyLimiter(mRegion)->OnFail(curTime);
             operation = data->mBufferOrNot ? OperationOnFail::RETRY_LATER : OperationOnFail::DISCARD;
         } else if (sendResult == SEND_QUOTA_EXCEED) {
             BOOL_FLAG(global_network_success) = true;
+            GetProjectConcurrencyLimiter(mProject)->OnFail(curTime);
             if (slsResponse.mErrorCode == sdk::LOGE_SHARD_WRITE_QUOTA_EXCEED) {
                 failDetail << "shard write quota exceed";
                 suggestion << "Split logstore shards. https://help.aliyun.com/zh/sls/user-guide/expansion-of-resources";
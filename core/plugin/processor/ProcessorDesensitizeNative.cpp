@@ -15,6 +15,10 @@
  */
 #include "plugin/processor/ProcessorDesensitizeNative.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
 #include "common/Constants.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
@@ -24,6 +28,66 @@
 
 namespace logtail {
 
+namespace {
+
+const size_t kMD5HexLength = 32;
+
+// ExtractLiteralPrefix returns the literal every match of RE2 @pattern starts with, e.g. "pwd=" for "pwd=\s*".
+// @isLiteral is set to true if the whole @pattern is the literal.
+std::string ExtractLiteralPrefix(const std::string& pattern, bool& isLiteral) {
+    std::string literal;
+    size_t i = 0;
+    isLiteral = false;
+    while (i < pattern.size()) {
+        char c = pattern[i++];
+        if (c == '\\') {
+            // escaped punctuation is literal, while \d, \b, \x41, \Q etc. are not handled
+            if (i >= pattern.size() || !ispunct(static_cast<unsigned char>(pattern[i]))) {
+                return literal;
+            }
+            c = pattern[i++];
+        } else if (static_cast<unsigned char>(c) >= 0x80 || c == '\0' || strchr(".[](){}*+?^$|", c) != nullptr) {
+            return literal;
+        }
+        if (i < pattern.size() && (pattern[i] == '*' || pattern[i] == '?' || pattern[i] == '{')) {
+            return literal;
+        }
+        literal += c;
+        if (i < pattern.size() && pattern[i] == '+') {
+            return literal;
+        }
+    }
+    isLiteral = !literal.empty();
+    return literal;
+}
+
+// FindLiteral returns the first occurrence of @literal in [@begin, @end), or NULL if not found.
+const char* FindLiteral(const char* begin, const char* end, const std::string& literal) {
+    for (const char* p = begin; static_cast<size_t>(end - p) >= literal.size(); ++p) {
+        p = static_cast<const char*>(memchr(p, literal[0], end - p - literal.size() + 1));
+        if (p == nullptr) {
+            return nullptr;
+        }
+        if (memcmp(p + 1, literal.data() + 1, literal.size() - 1) == 0) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+// WriteMD5 writes the upper case hex md5 of [@data, @data + @size) to @dest, same as sdk::CalcMD5.
+void WriteMD5(const char* data, size_t size, char* dest) {
+    static const char* table = "0123456789ABCDEF";
+    uint8_t md5[sdk::MD5_BYTES];
+    sdk::DoMd5(reinterpret_cast<const uint8_t*>(data), size, md5);
+    for (uint32_t i = 0; i < sdk::MD5_BYTES; ++i) {
+        dest[i * 2] = table[md5[i] >> 4];
+        dest[i * 2 + 1] = table[md5[i] & 0x0F];
+    }
+}
+
+} // namespace
+
 const std::string ProcessorDesensitizeNative::sName = "processor_desensitize_native";
 
 bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
@@ -123,6 +187,41 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
                            mContext->GetRegion());
     }
 
+    // a quantifier at the beginning of ReplacedContentPattern applies to ContentPatternBeforeReplacedString, and an
+    // alternation makes no literal mandatory
+    if (regexStr.find('|') == std::string::npos
+        && (mReplacedContentPattern.empty() || strchr("*?{", mReplacedContentPattern[0]) == nullptr)) {
+        mRequiredLiteral = ExtractLiteralPrefix(mContentPatternBeforeReplacedString, mPrefixIsLiteral);
+        // the first group is the last repetition for "+"
+        mPrefixIsLiteral = mPrefixIsLiteral && (mReplacedContentPattern.empty() || mReplacedContentPattern[0] != '+');
+    }
+
+    // parse ReplacingString once instead of for each replacement, invalid ones are left to RE2::GlobalReplace
+    std::string rewriteError;
+    if (mMethod == DesensitizeMethod::CONST_OPTION && mRegex->CheckRewriteString(mReplacingString, &rewriteError)) {
+        mRewriteCompiled = true;
+        RewritePiece literal;
+        for (size_t i = 0; i < mReplacingString.size(); ++i) {
+            if (mReplacingString[i] != '\\') {
+                literal.mLiteral += mReplacingString[i];
+            } else if (mReplacingString[++i] == '\\') {
+                literal.mLiteral += '\\';
+            } else {
+                if (!literal.mLiteral.empty()) {
+                    mRewritePieces.emplace_back(std::move(literal));
+                    literal = RewritePiece();
+                }
+                RewritePiece group;
+                group.mGroup = mReplacingString[i] - '0';
+                mRewriteMaxGroup = std::max(mRewriteMaxGroup, group.mGroup);
+                mRewritePieces.emplace_back(std::move(group));
+            }
+        }
+        if (!literal.mLiteral.empty()) {
+            mRewritePieces.emplace_back(std::move(literal));
+        }
+    }
+
     // ReplacingAll
     if (!GetOptionalBoolParam(config, "ReplacingAll", mReplacingAll, errorMsg)) {
         PARAM_WARNING_DEFAULT(mContext->GetLogger(),
@@ -171,15 +270,165 @@ void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
         if (item.second.empty()) {
             continue;
         }
-        std::string value = item.second.to_string();
-        CastOneSensitiveWord(&value);
         mProcDesensitizeRecodesTotal->Add(1);
-        StringBuffer valueBuffer = sourceEvent.GetSourceBuffer()->CopyString(value);
-        sourceEvent.SetContentNoCopy(item.first, StringView(valueBuffer.data, valueBuffer.size));
+        StringView result;
+        bool replaced = false;
+        if (mMethod == DesensitizeMethod::MD5_OPTION) {
+            replaced = ReplaceWithMD5(item.second, *sourceEvent.GetSourceBuffer(), result);
+        } else {
+            replaced = ReplaceWithConst(item.second, *sourceEvent.GetSourceBuffer(), result);
+        }
+        if (replaced) {
+            sourceEvent.SetContentNoCopy(item.first, result);
+        }
+    }
+}
+
+bool ProcessorDesensitizeNative::ReplaceWithConst(StringView value,
+                                                  SourceBuffer& sourceBuffer,
+                                                  StringView& result) const {
+    // submatches of all matches, mRewriteMaxGroup + 1 for each match
+    static thread_local std::vector<re2::StringPiece> sMatches;
+    const re2::StringPiece text(value.data(), value.size());
+    const int groupNum = mRewriteMaxGroup + 1;
+    // RE2 is much faster if no submatch is needed
+    const int nvec = mPrefixIsLiteral && mRewriteMaxGroup <= 1 ? 1 : groupNum;
+    bool fallback = !mRewriteCompiled;
+    sMatches.clear();
+    // same as RE2::GlobalReplace or RE2::Replace
+    const char* lastEnd = nullptr;
+    for (size_t pos = 0; !fallback && pos <= text.size();) {
+        if (!mRequiredLiteral.empty()) {
+            // every match starts with mRequiredLiteral, so the regex only runs from its occurrences
+            const char* literal = FindLiteral(text.data() + pos, text.data() + text.size(), mRequiredLiteral);
+            if (literal == nullptr) {
+                break;
+            }
+            pos = literal - text.data();
+        }
+        size_t matchIdx = sMatches.size();
+        sMatches.resize(matchIdx + groupNum);
+        if (!mRegex->Match(text, pos, text.size(), RE2::UNANCHORED, &sMatches[matchIdx], nvec)) {
+            sMatches.resize(matchIdx);
+            break;
+        }
+        const re2::StringPiece& match = sMatches[matchIdx];
+        if (nvec < groupNum) {
+            sMatches[matchIdx + 1] = re2::StringPiece(match.data(), mRequiredLiteral.size());
+        }
+        if (match.empty() && match.data() == lastEnd) {
+            // RE2::GlobalReplace skips one utf8 char for an empty match following the last one, which is rare
+            fallback = match.data() != text.data() + text.size();
+            sMatches.resize(matchIdx);
+            break;
+        }
+        lastEnd = match.data() + match.size();
+        pos = lastEnd - text.data();
+        if (!mReplacingAll) {
+            break;
+        }
+    }
+    if (fallback) {
+        std::string str = value.to_string();
+        CastOneSensitiveWord(&str);
+        StringBuffer sb = sourceBuffer.CopyString(str);
+        result = StringView(sb.data, sb.size);
+        return true;
+    }
+    if (sMatches.empty()) {
+        return false;
+    }
+
+    size_t size = value.size();
+    for (size_t i = 0; i < sMatches.size(); i += groupNum) {
+        size -= sMatches[i].size();
+        for (const auto& piece : mRewritePieces) {
+            size += piece.mGroup < 0 ? piece.mLiteral.size() : sMatches[i + piece.mGroup].size();
+        }
+    }
+    StringBuffer sb = sourceBuffer.AllocateStringBuffer(size);
+    char* dest = sb.data;
+    const char* src = value.data();
+    for (size_t i = 0; i < sMatches.size(); i += groupNum) {
+        const re2::StringPiece& match = sMatches[i];
+        memcpy(dest, src, match.data() - src);
+        dest += match.data() - src;
+        for (const auto& piece : mRewritePieces) {
+            const char* data = piece.mGroup < 0 ? piece.mLiteral.data() : sMatches[i + piece.mGroup].data();
+            size_t len = piece.mGroup < 0 ? piece.mLiteral.size() : sMatches[i + piece.mGroup].size();
+            memcpy(dest, data, len);
+            dest += len;
+        }
+        src = match.data() + match.size();
     }
+    memcpy(dest, src, value.data() + value.size() - src);
+    result = StringView(sb.data, size);
+    return true;
+}
+
+bool ProcessorDesensitizeNative::ReplaceWithMD5(StringView value,
+                                                SourceBuffer& sourceBuffer,
+                                                StringView& result) const {
+    // [begin, end) offsets of the content to be hashed
+    static thread_local std::vector<std::pair<size_t, size_t>> sSpans;
+    sSpans.clear();
+    // same as CastOneSensitiveWord, the whole value is kept if any match is invalid
+    re2::StringPiece srcStr(value.data(), value.size());
+    size_t maxSize = value.size();
+    size_t beginPos = 0;
+    size_t size = maxSize;
+    do {
+        if (!mRequiredLiteral.empty()) {
+            const char* literal = FindLiteral(srcStr.data(), srcStr.data() + srcStr.size(), mRequiredLiteral);
+            if (literal == nullptr) {
+                break;
+            }
+            srcStr.remove_prefix(literal - srcStr.data());
+        }
+        re2::StringPiece findRst;
+        if (mPrefixIsLiteral) {
+            re2::StringPiece match;
+            if (!mRegex->Match(srcStr, 0, srcStr.size(), RE2::UNANCHORED, &match, 1)) {
+                break;
+            }
+            findRst = re2::StringPiece(match.data(), mRequiredLiteral.size());
+            srcStr.remove_prefix(match.data() + match.size() - srcStr.data());
+        } else if (!re2::RE2::FindAndConsume(&srcStr, *mRegex, &findRst)) {
+            break;
+        }
+        size_t beginOffset = findRst.data() + findRst.size() - value.data();
+        size_t endOffset = srcStr.empty() ? maxSize : srcStr.data() - value.data();
+        if (beginOffset < beginPos || endOffset <= beginPos || endOffset > maxSize) {
+            return false;
+        }
+        sSpans.emplace_back(beginOffset, endOffset);
+        size = size - (endOffset - beginOffset) + kMD5HexLength;
+        beginPos = endOffset;
+        if (endOffset >= maxSize) {
+            break;
+        }
+    } while (mReplacingAll);
+    if (sSpans.empty()) {
+        return false;
+    }
+
+    // hash all matches in one pass, directly into the output
+    StringBuffer sb = sourceBuffer.AllocateStringBuffer(size);
+    char* dest = sb.data;
+    size_t pos = 0;
+    for (const auto& span : sSpans) {
+        memcpy(dest, value.data() + pos, span.first - pos);
+        dest += span.first - pos;
+        WriteMD5(value.data() + span.first, span.second - span.first, dest);
+        dest += kMD5HexLength;
+        pos = span.second;
+    }
+    memcpy(dest, value.data() + pos, maxSize - pos);
+    result = StringView(sb.data, size);
+    return true;
 }
 
-void ProcessorDesensitizeNative::CastOneSensitiveWord(std::string* value) {
+void ProcessorDesensitizeNative::CastOneSensitiveWord(std::string* value) const {
     std::string* pVal = value;
     bool rst = false;
 
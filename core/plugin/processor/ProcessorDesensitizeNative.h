@@ -18,6 +18,11 @@
 
 #include <re2/re2.h>
 
+#include <string>
+#include <vector>
+
+#include "common/memory/SourceBuffer.h"
+#include "models/StringView.h"
 #include "pipeline/plugin/interface/Processor.h"
 
 namespace logtail {
@@ -31,6 +36,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -51,15 +57,34 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
+    // a literal or a reference to a capturing group in the rewrite string
+    struct RewritePiece {
+        std::string mLiteral;
+        int mGroup = -1;
+    };
+
     void ProcessEvent(PipelineEventPtr& e);
-    void CastOneSensitiveWord(std::string* value);
+    // ReplaceWithConst and ReplaceWithMD5 write the desensitized @value to a single allocation in @sourceBuffer.
+    // @return false if nothing is replaced.
+    bool ReplaceWithConst(StringView value, SourceBuffer& sourceBuffer, StringView& result) const;
+    bool ReplaceWithMD5(StringView value, SourceBuffer& sourceBuffer, StringView& result) const;
+    void CastOneSensitiveWord(std::string* value) const;
 
     std::shared_ptr<re2::RE2> mRegex;
+    // a literal every match starts with, so that the regex only runs from where it occurs
+    std::string mRequiredLiteral;
+    // ContentPatternBeforeReplacedString is exactly mRequiredLiteral, so the first group needs no submatch extraction
+    bool mPrefixIsLiteral = false;
+    // mReplacingString parsed once, only valid if mRewriteCompiled is true
+    std::vector<RewritePiece> mRewritePieces;
+    int mRewriteMaxGroup = 0;
+    bool mRewriteCompiled = false;
 
     CounterPtr mProcDesensitizeRecodesTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorParseApsaraNativeUnittest;
+    friend class ProcessorDesensitizeNativeUnittest;
 #endif
 };
 
@@ -16,9 +16,11 @@
 
 #include "plugin/processor/ProcessorFilterNative.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "common/ParamExtractor.h"
+#include "common/Utf8Util.h"
 #include "logger/Logger.h"
 #include "models/LogEvent.h"
 #include "monitor/MetricConstants.h"
@@ -53,7 +55,6 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                              mContext->GetRegion());
     } else if (!filterKeys.empty()) {
         bool hasError = false;
-        std::vector<boost::regex> regs;
         for (const auto& reg : filterRegs) {
             if (!IsRegexValid(reg)) {
                 PARAM_WARNING_IGNORE(mContext->GetLogger(),
@@ -67,12 +68,9 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                 hasError = true;
                 break;
             }
-            regs.emplace_back(reg);
         }
         if (!hasError) {
-            mFilterRule = std::make_shared<LogFilterRule>();
-            mFilterRule->FilterKeys = filterKeys;
-            mFilterRule->FilterRegs = regs;
+            mProgram.Compile(filterKeys, filterRegs);
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -90,8 +88,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                  mContext->GetLogstoreName(),
                                  mContext->GetRegion());
         } else if (!mInclude.empty()) {
-            std::vector<std::string> keys;
-            std::vector<boost::regex> regs;
+            std::vector<std::string> keys, exps;
             bool hasError = false;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
@@ -107,12 +104,10 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                     break;
                 }
                 keys.emplace_back(include.first);
-                regs.emplace_back(boost::regex(include.second));
+                exps.emplace_back(include.second);
             }
             if (!hasError) {
-                mFilterRule = std::make_shared<LogFilterRule>();
-                mFilterRule->FilterKeys = keys;
-                mFilterRule->FilterRegs = regs;
+                mProgram.Compile(keys, exps);
                 mFilterMode = Mode::RULE_MODE;
             }
         }
@@ -153,6 +148,16 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         }
+        if (!mProgram.Compile(root)) {
+            PARAM_ERROR_RETURN(mContext->GetLogger(),
+                               mContext->GetAlarm(),
+                               "object param ConditionExp can not be compiled",
+                               sName,
+                               mContext->GetConfigName(),
+                               mContext->GetProjectName(),
+                               mContext->GetLogstoreName(),
+                               mContext->GetRegion());
+        }
         mConditionExp.swap(root);
         mFilterMode = Mode::EXPRESSION_MODE;
     }
@@ -193,10 +198,11 @@ void ProcessorFilterNative::Process(PipelineEventGroup& logGroup) {
     }
 
     EventsContainer& events = logGroup.MutableEvents();
+    FilterProgram::Session session(mProgram);
 
     size_t wIdx = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(events[rIdx])) {
+        if (ProcessEvent(events[rIdx], session)) {
             if (wIdx != rIdx) {
                 events[wIdx] = std::move(events[rIdx]);
             }
@@ -208,7 +214,7 @@ void ProcessorFilterNative::Process(PipelineEventGroup& logGroup) {
     events.resize(wIdx);
 }
 
-bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
+bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e, FilterProgram::Session& session) {
     if (!IsSupportedEvent(e)) {
         return true;
     }
@@ -216,29 +222,24 @@ bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
     auto& sourceEvent = e.Cast<LogEvent>();
     bool res = true;
 
-    if (mFilterMode == Mode::EXPRESSION_MODE) {
-        res = FilterExpressionRoot(sourceEvent, mConditionExp);
-    } else if (mFilterMode == Mode::RULE_MODE) {
-        res = FilterFilterRule(sourceEvent, mFilterRule.get());
+    if (mFilterMode == Mode::EXPRESSION_MODE || mFilterMode == Mode::RULE_MODE) {
+        res = Filter(sourceEvent, session);
     }
     if (res && mDiscardingNonUTF8) {
         std::vector<std::pair<StringView, StringView> > newContents;
-        for (auto &content: sourceEvent) {
-            if (CheckNoneUtf8(content.second)) {
-                auto value = content.second.to_string();
-                FilterNoneUtf8(value);
-                StringBuffer valueBuffer = sourceEvent.GetSourceBuffer()->CopyString(value);
-                content.second = StringView(valueBuffer.data, valueBuffer.size);
+        for (auto& content : sourceEvent) {
+            size_t invalidPos = FindFirstInvalidUtf8(content.second.data(), content.second.size());
+            if (invalidPos != content.second.size()) {
+                FilterNoneUtf8(sourceEvent, content.second, invalidPos);
             }
-            if (CheckNoneUtf8(content.first)) {
+            invalidPos = FindFirstInvalidUtf8(content.first.data(), content.first.size());
+            if (invalidPos != content.first.size()) {
                 // key
-                auto key = content.first.to_string();
-                FilterNoneUtf8(key);
-                StringBuffer keyBuffer = sourceEvent.GetSourceBuffer()->CopyString(key);
-
-                newContents.emplace_back(StringView(keyBuffer.data, keyBuffer.size), content.second);
+                StringView key = content.first;
+                FilterNoneUtf8(sourceEvent, key, invalidPos);
+                newContents.emplace_back(key, content.second);
                 sourceEvent.DelContent(content.first);
-                        }
+            }
         }
         for (auto& newContent : newContents) {
             sourceEvent.SetContentNoCopy(newContent.first, newContent.second);
@@ -252,37 +253,18 @@ bool ProcessorFilterNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
 
-bool ProcessorFilterNative::FilterExpressionRoot(LogEvent& sourceEvent, const BaseFilterNodePtr& node) {
-    if (sourceEvent.Empty()) {
-        return false;
-    }
-
-    // null node, all logs are passed
-    if (node.get() == nullptr) {
-        return true;
-    }
-
-    try {
-        return node->Match(sourceEvent, GetContext());
-    } catch (...) {
-        mProcFilterErrorTotal->Add(1);
-        LOG_ERROR(GetContext().GetLogger(), ("filter error ", ""));
-        return false;
-    }
-}
-
-bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule) {
+bool ProcessorFilterNative::Filter(LogEvent& sourceEvent, FilterProgram::Session& session) {
     if (sourceEvent.Empty()) {
         return false;
     }
 
-    // null filterRule, all logs are passed
-    if (filterRule == NULL) {
+    // no condition, all logs are passed
+    if (mProgram.Empty()) {
         return true;
     }
 
     try {
-        return IsMatched(sourceEvent, *filterRule);
+        return mProgram.Match(sourceEvent, session, GetContext());
     } catch (...) {
         mProcFilterErrorTotal->Add(1);
         LOG_ERROR(GetContext().GetLogger(), ("filter error ", ""));
@@ -290,123 +272,14 @@ bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFil
     }
 }
 
-bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
-    const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
-    std::string exception;
-    for (uint32_t i = 0; i < keys.size(); ++i) {
-        const auto& content = contents.FindContent(keys[i]);
-        if (content == contents.end()) {
-            return false;
-        }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
-            if (!exception.empty()) {
-                LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
-                if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
-                    GetContext().GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
-                                                      "regex_match in Filter fail:" + exception,
-                                                      GetContext().GetProjectName(),
-                                                      GetContext().GetLogstoreName(),
-                                                      GetContext().GetRegion());
-                }
-            }
-            return false;
-        }
-    }
-    return true;
-}
-
-static const char UTF8_BYTE_PREFIX = 0x80;
-static const char UTF8_BYTE_MASK = 0xc0;
-
-bool ProcessorFilterNative::CheckNoneUtf8(const StringView& strSrc) {
-    return noneUtf8(const_cast<StringView&>(strSrc), false);
+void ProcessorFilterNative::FilterNoneUtf8(LogEvent& sourceEvent, StringView& str, size_t invalidPos) {
+    StringBuffer buffer = sourceEvent.GetSourceBuffer()->CopyString(str);
+    ReplaceInvalidUtf8(buffer.data, buffer.size, invalidPos);
+    str = StringView(buffer.data, buffer.size);
 }
 
 void ProcessorFilterNative::FilterNoneUtf8(std::string& strSrc) {
-    StringView strView(strSrc.data(), strSrc.size());
-    noneUtf8(strView, true);
-}
-
-bool ProcessorFilterNative::noneUtf8(StringView& str, bool modify) {
-#define FILL_BLUNK_AND_CONTINUE_IF_TRUE(stat) \
-    if (stat) { \
-        if (!modify) { \
-            return true; \
-        } \
-        const_cast<char&>(*iter) = ' '; \
-        ++iter; \
-        continue; \
-    };
-
-    auto iter = str.begin();
-    while (iter != str.end()) {
-        uint16_t unicode = 0;
-        char c;
-        if ((*iter & 0x80) == 0x00) // one byte
-        {
-            /**
-             * mapping rule: 0000 0000 - 0000 007F | 0xxxxxxx
-             */
-            // nothing to check
-        } else if ((*iter & 0xe0) == 0xc0) // two bytes
-        {
-            /**
-             * mapping rule: 0000 0080 - 0000 07FF | 110xxxxx 10xxxxxx
-             */
-            c = *iter;
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE(iter + 1 == str.end());
-            /* check whether the byte is in format 10xxxxxx */
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((*(iter + 1) & UTF8_BYTE_MASK) != UTF8_BYTE_PREFIX);
-            /* get unicode value */
-            unicode = (((c & 0x1f) << 6) | (*(iter + 1) & 0x3f));
-            /* validate unicode range */
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE(!(unicode >= 0x80 && unicode <= 0x7ff));
-            ++iter;
-        } else if ((*iter & 0xf0) == 0xe0) // three bytes
-        {
-            /**
-             * mapping rule: 0000 0800 - 0000 FFFF | 1110xxxx 10xxxxxx 10xxxxxx
-             */
-            c = *iter;
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((iter + 1 == str.end()) || (iter + 2 == str.end()));
-            /* check whether the byte is in format 10xxxxxx */
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((*(iter + 1) & UTF8_BYTE_MASK) != UTF8_BYTE_PREFIX);
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((*(iter + 2) & UTF8_BYTE_MASK) != UTF8_BYTE_PREFIX);
-            /* get unicode value */
-            unicode = (((c & 0x0f) << 12) | ((*(iter + 1) & 0x3f) << 6) | (*(iter + 2) & 0x3f));
-            /* validate unicode range */
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE(!(unicode >= 0x800 /* && unicode <= 0xffff */));
-            ++iter;
-            ++iter;
-        } else if ((*iter & 0xf8) == 0xf0) // four bytes
-        {
-            /**
-             * mapping rule: 0001 0000 - 0010 FFFF | 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-             */
-            c = *iter;
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((iter + 1 == str.end()) || (iter + 2 == str.end())
-                                            || (iter + 3 == str.end()));
-            /* check whether the byte is in format 10xxxxxx */
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((*(iter + 1) & UTF8_BYTE_MASK) != UTF8_BYTE_PREFIX);
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((*(iter + 2) & UTF8_BYTE_MASK) != UTF8_BYTE_PREFIX);
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE((*(iter + 3) & UTF8_BYTE_MASK) != UTF8_BYTE_PREFIX);
-            /* get unicode value */
-            uint32_t unicode = 0x00000000; // for 4 bytes utf-8 encoding
-            unicode = ((c & 0x07) << 18) | ((*(iter + 1) & 0x3f) << 12) | ((*(iter + 2) & 0x3f) << 6)
-                | ((*(iter + 3) & 0x3f));
-            /* validate unicode range */
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE(!(unicode >= 0x00010000 && unicode <= 0x0010ffff));
-            ++iter;
-            ++iter;
-            ++iter;
-        } else {
-            FILL_BLUNK_AND_CONTINUE_IF_TRUE(true);
-        }
-        ++iter;
-    }
-#undef FILL_BLUNK_AND_CONTINUE_IF_TRUE
-    return false;
+    ReplaceInvalidUtf8(const_cast<char*>(strSrc.data()), strSrc.size());
 }
 
 BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value) {
@@ -518,4 +391,325 @@ bool UnaryFilterOperatorNode::Match(const LogEvent& contents, const PipelineCont
     return false;
 }
 
+static void SendRegexMatchAlarm(const PipelineContext& ctx, const std::string& exception) {
+    if (!AppConfig::GetInstance()->IsLogParseAlarmValid()) {
+        return;
+    }
+    LOG_ERROR(ctx.GetLogger(), ("regex_match in Filter fail", exception));
+    if (ctx.GetAlarm().IsLowLevelAlarmValid()) {
+        ctx.GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
+                                 "regex_match in Filter fail:" + exception,
+                                 ctx.GetProjectName(),
+                                 ctx.GetLogstoreName(),
+                                 ctx.GetRegion());
+    }
+}
+
+static RE2::Options GetFilterRE2Options() {
+    // keep the semantics of boost::regex_match with default perl syntax: match bytes rather than utf8 characters,
+    // '.' matches newline, and '^'/'$' match at line boundaries (set by (?m) in pattern).
+    RE2::Options options;
+    options.set_encoding(RE2::Options::EncodingLatin1);
+    options.set_dot_nl(true);
+    options.set_log_errors(false);
+    options.set_max_mem(64 << 20);
+    return options;
+}
+
+FilterProgram::Session::Session(FilterProgram& program) : mProgram(program) {
+    {
+        std::lock_guard<std::mutex> lock(program.mStatisticsMux);
+        mOrder = program.mOrder;
+    }
+    mEvaluated.resize(program.mClauses.size(), 0);
+    mRejected.resize(program.mClauses.size(), 0);
+    mKeyGeneration.resize(program.mKeys.size(), 0);
+    mKeyValues.resize(program.mKeys.size());
+    mKeyExists.resize(program.mKeys.size(), false);
+    mKeyMatched.resize(program.mKeys.size());
+    for (size_t i = 0; i < program.mKeys.size(); ++i) {
+        mKeyMatched[i].resize(program.mKeys[i].mSetSize, false);
+    }
+}
+
+FilterProgram::Session::~Session() {
+    mProgram.mergeStatistics(*this);
+}
+
+void FilterProgram::clear() {
+    mClauses.clear();
+    mPatterns.clear();
+    mKeys.clear();
+    mOrder.clear();
+    mEvaluated.clear();
+    mRejected.clear();
+    mEvaluatedSinceReorder = 0;
+}
+
+bool FilterProgram::Compile(const std::vector<std::string>& keys, const std::vector<std::string>& regs) {
+    clear();
+    if (keys.size() != regs.size()) {
+        return false;
+    }
+    // one clause for each key, in the order of first occurrence
+    std::vector<std::pair<std::string, std::vector<Instruction>>> clauses;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto it = std::find_if(clauses.begin(), clauses.end(), [&](const auto& c) { return c.first == keys[i]; });
+        if (it == clauses.end()) {
+            clauses.emplace_back(keys[i], std::vector<Instruction>());
+            it = clauses.end() - 1;
+        } else {
+            // previous pattern of the key must be matched
+            it->second.push_back({OpCode::JUMP_IF_FALSE, 0});
+        }
+        it->second.push_back({OpCode::MATCH, addPattern(keys[i], regs[i])});
+    }
+    for (auto& clause : clauses) {
+        // all jumps go to the end of clause
+        for (auto& ins : clause.second) {
+            if (ins.mOp == OpCode::JUMP_IF_FALSE) {
+                ins.mArg = static_cast<uint32_t>(clause.second.size());
+            }
+        }
+        mClauses.emplace_back(std::move(clause.second));
+    }
+    return finalize();
+}
+
+bool FilterProgram::Compile(const BaseFilterNodePtr& root) {
+    clear();
+    if (!root) {
+        return true;
+    }
+    // split top level "and" into clauses, so that they can be reordered
+    std::vector<const BaseFilterNode*> stack{root.get()};
+    while (!stack.empty()) {
+        const BaseFilterNode* node = stack.back();
+        stack.pop_back();
+        const auto* binary = dynamic_cast<const BinaryFilterOperatorNode*>(node);
+        if (binary != nullptr && binary->GetOperator() == AND_OPERATOR && binary->GetLeft() && binary->GetRight()) {
+            stack.push_back(binary->GetRight().get());
+            stack.push_back(binary->GetLeft().get());
+            continue;
+        }
+        std::vector<Instruction> code;
+        if (!compileNode(node, code)) {
+            clear();
+            return false;
+        }
+        mClauses.emplace_back(std::move(code));
+    }
+    return finalize();
+}
+
+uint32_t FilterProgram::addPattern(const std::string& key, const std::string& exp) {
+    uint32_t keyIdx = 0;
+    for (; keyIdx < mKeys.size(); ++keyIdx) {
+        if (mKeys[keyIdx].mKey == key) {
+            break;
+        }
+    }
+    if (keyIdx == mKeys.size()) {
+        mKeys.emplace_back();
+        mKeys.back().mKey = key;
+    }
+    // reuse the same pattern on the same key
+    for (uint32_t i = 0; i < mPatterns.size(); ++i) {
+        if (mPatterns[i].mKeyIndex == keyIdx && mPatterns[i].mExpression == exp) {
+            return i;
+        }
+    }
+    Pattern pattern;
+    pattern.mKeyIndex = keyIdx;
+    pattern.mExpression = exp;
+    mPatterns.emplace_back(std::move(pattern));
+    return static_cast<uint32_t>(mPatterns.size() - 1);
+}
+
+bool FilterProgram::compileNode(const BaseFilterNode* node, std::vector<Instruction>& code) {
+    if (node == nullptr) {
+        return false;
+    }
+    if (const auto* value = dynamic_cast<const RegexFilterValueNode*>(node)) {
+        code.push_back({OpCode::MATCH, addPattern(value->GetKey(), value->GetExpression())});
+        return true;
+    }
+    if (const auto* unary = dynamic_cast<const UnaryFilterOperatorNode*>(node)) {
+        if (!compileNode(unary->GetChild().get(), code)) {
+            return false;
+        }
+        code.push_back({OpCode::NOT, 0});
+        return true;
+    }
+    if (const auto* binary = dynamic_cast<const BinaryFilterOperatorNode*>(node)) {
+        if (binary->GetOperator() != AND_OPERATOR && binary->GetOperator() != OR_OPERATOR) {
+            return false;
+        }
+        if (!compileNode(binary->GetLeft().get(), code)) {
+            return false;
+        }
+        const size_t jump = code.size();
+        code.push_back({binary->GetOperator() == AND_OPERATOR ? OpCode::JUMP_IF_FALSE : OpCode::JUMP_IF_TRUE, 0});
+        if (!compileNode(binary->GetRight().get(), code)) {
+            return false;
+        }
+        code[jump].mArg = static_cast<uint32_t>(code.size());
+        return true;
+    }
+    return false;
+}
+
+bool FilterProgram::finalize() {
+    static const RE2::Options sOptions = GetFilterRE2Options();
+    for (auto& pattern : mPatterns) {
+        // the whole pattern is grouped, so that (?m) and anchoring apply to all alternatives
+        const std::string exp = "(?m:" + pattern.mExpression + ")";
+        RE2 re(exp, sOptions);
+        if (!re.ok()) {
+            continue;
+        }
+        KeyPatterns& key = mKeys[pattern.mKeyIndex];
+        if (!key.mSet) {
+            key.mSet.reset(new RE2::Set(sOptions, RE2::ANCHOR_BOTH));
+        }
+        pattern.mSetIndex = key.mSet->Add(exp, nullptr);
+        if (pattern.mSetIndex >= 0) {
+            key.mSetSize = static_cast<size_t>(pattern.mSetIndex) + 1;
+        }
+    }
+    for (size_t keyIdx = 0; keyIdx < mKeys.size(); ++keyIdx) {
+        KeyPatterns& key = mKeys[keyIdx];
+        if (key.mSet && !key.mSet->Compile()) {
+            LOG_WARNING(sLogger, ("failed to compile regex set for filter key", key.mKey)("action", "use boost regex"));
+            key.mSet.reset();
+            key.mSetSize = 0;
+            for (auto& pattern : mPatterns) {
+                if (pattern.mKeyIndex == keyIdx) {
+                    pattern.mSetIndex = -1;
+                }
+            }
+        }
+    }
+    for (auto& pattern : mPatterns) {
+        if (pattern.mSetIndex < 0) {
+            pattern.mRegex.reset(new boost::regex(pattern.mExpression));
+        }
+    }
+    for (uint32_t i = 0; i < mClauses.size(); ++i) {
+        mOrder.push_back(i);
+    }
+    mEvaluated.resize(mClauses.size(), 0);
+    mRejected.resize(mClauses.size(), 0);
+    return true;
+}
+
+bool FilterProgram::Match(const LogEvent& event, Session& session, const PipelineContext& ctx) const {
+    if (++session.mGeneration == 0) {
+        std::fill(session.mKeyGeneration.begin(), session.mKeyGeneration.end(), 0);
+        session.mGeneration = 1;
+    }
+    for (uint32_t idx : session.mOrder) {
+        ++session.mEvaluated[idx];
+        if (!runClause(mClauses[idx], event, session, ctx)) {
+            ++session.mRejected[idx];
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FilterProgram::runClause(const std::vector<Instruction>& code,
+                              const LogEvent& event,
+                              Session& session,
+                              const PipelineContext& ctx) const {
+    bool res = false;
+    size_t pc = 0;
+    while (pc < code.size()) {
+        const Instruction& ins = code[pc];
+        switch (ins.mOp) {
+            case OpCode::MATCH:
+                res = matchPattern(ins.mArg, event, session, ctx);
+                ++pc;
+                break;
+            case OpCode::NOT:
+                res = !res;
+                ++pc;
+                break;
+            case OpCode::JUMP_IF_FALSE:
+                pc = res ? pc + 1 : ins.mArg;
+                break;
+            case OpCode::JUMP_IF_TRUE:
+                pc = res ? ins.mArg : pc + 1;
+                break;
+        }
+    }
+    return res;
+}
+
+bool FilterProgram::matchPattern(uint32_t patternIdx,
+                                 const LogEvent& event,
+                                 Session& session,
+                                 const PipelineContext& ctx) const {
+    const Pattern& pattern = mPatterns[patternIdx];
+    const uint32_t keyIdx = pattern.mKeyIndex;
+    if (session.mKeyGeneration[keyIdx] != session.mGeneration) {
+        // first pattern of the key in this event, run all set patterns of the key at once
+        session.mKeyGeneration[keyIdx] = session.mGeneration;
+        const auto& content = event.FindContent(mKeys[keyIdx].mKey);
+        session.mKeyExists[keyIdx] = content != event.end();
+        if (session.mKeyExists[keyIdx]) {
+            session.mKeyValues[keyIdx] = content->second;
+            const KeyPatterns& key = mKeys[keyIdx];
+            if (key.mSet) {
+                std::vector<bool>& matched = session.mKeyMatched[keyIdx];
+                std::fill(matched.begin(), matched.end(), false);
+                session.mSetResult.clear();
+                if (key.mSet->Match(re2::StringPiece(content->second.data(), content->second.size()),
+                                    &session.mSetResult)) {
+                    for (int i : session.mSetResult) {
+                        matched[i] = true;
+                    }
+                }
+            }
+        }
+    }
+    if (!session.mKeyExists[keyIdx]) {
+        return false;
+    }
+    if (pattern.mSetIndex >= 0) {
+        return session.mKeyMatched[keyIdx][pattern.mSetIndex];
+    }
+    std::string exception;
+    const StringView& value = session.mKeyValues[keyIdx];
+    bool res = BoostRegexMatch(value.data(), value.size(), *pattern.mRegex, exception);
+    if (!res && !exception.empty()) {
+        SendRegexMatchAlarm(ctx, exception);
+    }
+    return res;
+}
+
+void FilterProgram::mergeStatistics(const Session& session) {
+    std::lock_guard<std::mutex> lock(mStatisticsMux);
+    uint64_t evaluated = 0;
+    for (size_t i = 0; i < mEvaluated.size() && i < session.mEvaluated.size(); ++i) {
+        mEvaluated[i] += session.mEvaluated[i];
+        mRejected[i] += session.mRejected[i];
+        evaluated += session.mEvaluated[i];
+    }
+    mEvaluatedSinceReorder += evaluated;
+    if (mEvaluatedSinceReorder < kReorderInterval) {
+        return;
+    }
+    mEvaluatedSinceReorder = 0;
+    // the clause with higher rejection rate goes first, clauses never evaluated keep their relative position
+    std::stable_sort(mOrder.begin(), mOrder.end(), [this](uint32_t l, uint32_t r) {
+        return mRejected[l] * (mEvaluated[r] + 1) > mRejected[r] * (mEvaluated[l] + 1);
+    });
+    // decay, so that the order follows changes of logs
+    for (size_t i = 0; i < mEvaluated.size(); ++i) {
+        mEvaluated[i] /= 2;
+        mRejected[i] /= 2;
+    }
+}
+
 } // namespace logtail
@@ -16,12 +16,20 @@
 
 #pragma once
 
+#include <re2/re2.h>
+#include <re2/set.h>
+
+#include <boost/regex.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "app_config/AppConfig.h"
 #include "models/LogEvent.h"
 #include "pipeline/plugin/interface/Processor.h"
 
-#include <boost/regex.hpp>
-
 namespace logtail {
 
 // BaseFilterNode
@@ -58,6 +66,10 @@ public:
 public:
     virtual bool Match(const LogEvent& contents, const PipelineContext& mContext);
 
+    FilterOperator GetOperator() const { return op; }
+    const BaseFilterNodePtr& GetLeft() const { return left; }
+    const BaseFilterNodePtr& GetRight() const { return right; }
+
 private:
     FilterOperator op;
     BaseFilterNodePtr left;
@@ -75,6 +87,9 @@ public:
 public:
     virtual bool Match(const LogEvent& contents, const PipelineContext& mContext);
 
+    const std::string& GetKey() const { return key; }
+    std::string GetExpression() const { return reg.str(); }
+
 private:
     std::string key;
     boost::regex reg;
@@ -91,6 +106,8 @@ public:
 public:
     virtual bool Match(const LogEvent& contents, const PipelineContext& mContext);
 
+    const BaseFilterNodePtr& GetChild() const { return child; }
+
 private:
     BaseFilterNodePtr child;
 };
@@ -99,6 +116,101 @@ BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value);
 bool GetOperatorType(const std::string& type, FilterOperator& op);
 bool GetNodeFuncType(const std::string& type, FilterNodeFunctionType& func);
 
+// FilterProgram is the compiled form of FilterKey/FilterRegex rules or a ConditionExp tree.
+//
+// The condition is split into a conjunction of clauses (patterns of one key in rule mode, or top level "and" operands
+// of ConditionExp), and each clause is flattened into a short-circuit instruction list. All patterns applied to the
+// same key are merged into one RE2::Set, so the value of a key is scanned at most once per event no matter how many
+// patterns refer to it. Patterns RE2 does not support (e.g. backreference, lookaround) fall back to boost::regex.
+//
+// Clauses are reordered by observed rejection rate, so the clause most likely to drop an event is checked first.
+class FilterProgram {
+public:
+    // Session holds the clause order and scratch space for a batch of events, so that multiple threads can run the
+    // program at the same time. Statistics are merged back into the program on destruction.
+    class Session {
+    public:
+        explicit Session(FilterProgram& program);
+        ~Session();
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+    private:
+        FilterProgram& mProgram;
+        std::vector<uint32_t> mOrder;
+        std::vector<uint64_t> mEvaluated;
+        std::vector<uint64_t> mRejected;
+        // per key state of current event, valid only if mKeyGeneration[key] == mGeneration
+        uint32_t mGeneration = 0;
+        std::vector<uint32_t> mKeyGeneration;
+        std::vector<StringView> mKeyValues;
+        std::vector<bool> mKeyExists;
+        std::vector<std::vector<bool>> mKeyMatched;
+        std::vector<int> mSetResult;
+
+        friend class FilterProgram;
+#ifdef APSARA_UNIT_TEST_MAIN
+        friend class ProcessorFilterNativeUnittest;
+#endif
+    };
+
+    bool Compile(const std::vector<std::string>& keys, const std::vector<std::string>& regs);
+    bool Compile(const BaseFilterNodePtr& root);
+    bool Empty() const { return mClauses.empty(); }
+
+    bool Match(const LogEvent& event, Session& session, const PipelineContext& ctx) const;
+
+private:
+    enum class OpCode : uint8_t { MATCH, NOT, JUMP_IF_FALSE, JUMP_IF_TRUE };
+
+    struct Instruction {
+        OpCode mOp;
+        // pattern index for MATCH, target for jumps
+        uint32_t mArg;
+    };
+
+    struct Pattern {
+        uint32_t mKeyIndex = 0;
+        // index in RE2::Set of the key, -1 if the pattern is matched by mRegex
+        int mSetIndex = -1;
+        std::string mExpression;
+        std::unique_ptr<boost::regex> mRegex;
+    };
+
+    struct KeyPatterns {
+        std::string mKey;
+        std::unique_ptr<RE2::Set> mSet;
+        size_t mSetSize = 0;
+    };
+
+    static const uint64_t kReorderInterval = 4096;
+
+    void clear();
+    uint32_t addPattern(const std::string& key, const std::string& exp);
+    bool compileNode(const BaseFilterNode* node, std::vector<Instruction>& code);
+    bool finalize();
+    bool runClause(const std::vector<Instruction>& code,
+                   const LogEvent& event,
+                   Session& session,
+                   const PipelineContext& ctx) const;
+    bool matchPattern(uint32_t patternIdx, const LogEvent& event, Session& session, const PipelineContext& ctx) const;
+    void mergeStatistics(const Session& session);
+
+    std::vector<std::vector<Instruction>> mClauses;
+    std::vector<Pattern> mPatterns;
+    std::vector<KeyPatterns> mKeys;
+
+    std::mutex mStatisticsMux;
+    std::vector<uint32_t> mOrder;
+    std::vector<uint64_t> mEvaluated;
+    std::vector<uint64_t> mRejected;
+    uint64_t mEvaluatedSinceReorder = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessorFilterNativeUnittest;
+#endif
+};
+
 class ProcessorFilterNative : public Processor {
 public:
     static const std::string sName;
@@ -106,6 +218,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Log field whitelist. The relationship between multiple conditions is "and". Only when all conditions are met, the
     // log will be collected.
@@ -119,27 +232,18 @@ protected:
 private:
     enum class Mode { BYPASS_MODE, EXPRESSION_MODE, RULE_MODE };
 
-    struct LogFilterRule {
-        std::vector<std::string> FilterKeys;
-        std::vector<boost::regex> FilterRegs;
-    };
-
-    bool ProcessEvent(PipelineEventPtr& e);
-
-    // Filter logs through ConditionExp
-    bool FilterExpressionRoot(LogEvent& sourceEvent, const BaseFilterNodePtr& node);
+    bool ProcessEvent(PipelineEventPtr& e, FilterProgram::Session& session);
 
-    // Filter logs through FilterRule
-    bool FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule);
-    bool IsMatched(const LogEvent& contents, const LogFilterRule& rule);
+    // Filter logs through compiled FilterRule or ConditionExp
+    bool Filter(LogEvent& sourceEvent, FilterProgram::Session& session);
 
-    bool noneUtf8(StringView& strSrc, bool modify);
-    bool CheckNoneUtf8(const StringView& strSrc);
+    // Replace invalid utf8 bytes of @str with a copy in @sourceEvent's buffer
+    void FilterNoneUtf8(LogEvent& sourceEvent, StringView& str, size_t invalidPos);
     void FilterNoneUtf8(std::string& strSrc);
 
     Mode mFilterMode = Mode::BYPASS_MODE;
 
-    std::shared_ptr<LogFilterRule> mFilterRule;
+    FilterProgram mProgram;
 
     CounterPtr mProcFilterErrorTotal;
     CounterPtr mProcFilterRecordsTotal;
@@ -74,6 +74,9 @@ bool ProcessorParseApsaraNative::Init(const Json::Value& config) {
         return false;
     }
 
+    mEpochTimeParser.Init("%s");
+    mSecondTimeParser.Init("%Y-%m-%d %H:%M:%S");
+
     mLogGroupSize = &(GetContext().GetProcessProfile().logGroupSize);
     mParseFailures = &(GetContext().GetProcessProfile().parseFailures);
     mHistoryFailures = &(GetContext().GetProcessProfile().historyFailures);
@@ -264,10 +267,10 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
             return 0;
         }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
-        auto strptimeResult = Strptime(strTime.c_str(), "%s", &logTime, nanosecondLength);
-        if (NULL == strptimeResult || strptimeResult[0] != ']') {
+        // strTime is the content between '[' and ']' and ends with ']'
+        StringView strTime = buffer.substr(1, pos);
+        auto strptimeResult = mEpochTimeParser.Parse(strTime.data(), strTime.size(), logTime, nanosecondLength);
+        if (NULL == strptimeResult || strptimeResult == strTime.end() || strptimeResult[0] != ']') {
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer)("timeformat", "%s"));
             return 0;
         }
@@ -281,13 +284,15 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
             return 0;
         }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
+        // strTime is the content between '[' and ']' and ends with ']'
+        StringView strTime = buffer.substr(1, pos);
         int nanosecondLength = 0;
         if (IsPrefixString(strTime, cachedTimeStr) == true) {
             if (strTime.size() > cachedTimeStr.size()) {
-                auto strptimeResult
-                    = Strptime(strTime.c_str() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
+                auto strptimeResult = ParseNanosecond(strTime.data() + cachedTimeStr.size() + 1,
+                                                      strTime.size() - cachedTimeStr.size() - 1,
+                                                      logTime.tv_nsec,
+                                                      nanosecondLength);
                 if (NULL == strptimeResult) {
                     LOG_WARNING(sLogger,
                                 ("parse apsara log time microsecond",
@@ -298,15 +303,16 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             return cachedLogTime.tv_sec;
         }
         // parse second part
-        auto strptimeResult = Strptime(strTime.c_str(), "%Y-%m-%d %H:%M:%S", &logTime, nanosecondLength);
+        auto strptimeResult = mSecondTimeParser.Parse(strTime.data(), strTime.size(), logTime, nanosecondLength);
         if (NULL == strptimeResult) {
             LOG_WARNING(sLogger,
                         ("parse apsara log time", "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S"));
             return 0;
         }
         // parse nanosecond part (optional)
-        if (*strptimeResult != '\0') {
-            strptimeResult = Strptime(strptimeResult + 1, "%f", &logTime, nanosecondLength);
+        if (strptimeResult != strTime.end()) {
+            strptimeResult = ParseNanosecond(
+                strptimeResult + 1, strTime.end() - strptimeResult - 1, logTime.tv_nsec, nanosecondLength);
             if (NULL == strptimeResult) {
                 LOG_WARNING(sLogger,
                             ("parse apsara log time microsecond", "fail")("string", buffer)("timeformat",
@@ -328,8 +334,8 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
  * @param prefix - 要检查的前缀。
  * @return 如果字符串以指定前缀开头，则返回true；否则返回false。
  */
-bool ProcessorParseApsaraNative::IsPrefixString(const std::string& all, const StringView& prefix) {
-    return !prefix.empty() && std::equal(prefix.begin(), prefix.end(), all.begin());
+bool ProcessorParseApsaraNative::IsPrefixString(const StringView& all, const StringView& prefix) {
+    return !prefix.empty() && all.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), all.begin());
 }
 
 /*
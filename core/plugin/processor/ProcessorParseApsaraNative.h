@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "common/TimeFormatParser.h"
 #include "common/TimeUtil.h"
 #include "models/LogEvent.h"
 #include "pipeline/plugin/interface/Processor.h"
@@ -30,6 +31,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -46,10 +48,14 @@ private:
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
     time_t
     ApsaraEasyReadLogTimeParser(StringView& buffer, StringView& timeStr, LogtailTime& lastLogTime, int64_t& microTime);
-    bool IsPrefixString(const std::string& all, const StringView& prefix);
+    bool IsPrefixString(const StringView& all, const StringView& prefix);
     int32_t ParseApsaraBaseFields(const StringView& buffer, LogEvent& sourceEvent);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    // [1378972170425093]
+    TimeFormatParser mEpochTimeParser;
+    // [2013-09-12 22:18:28.819129]
+    TimeFormatParser mSecondTimeParser;
 
     int* mLogGroupSize = nullptr;
     int* mParseFailures = nullptr;
@@ -106,7 +106,7 @@ bool ProcessorParseDelimiterNative::Init(const Json::Value& config) {
                              mContext->GetRegion());
     }
 
-    mDelimiterModeFsmParserPtr.reset(new DelimiterModeFsmParser(mQuote, mSeparatorChar));
+    mDelimiterModeParserPtr.reset(new DelimiterModeSimdParser(mQuote, mSeparatorChar));
 
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
@@ -247,7 +247,7 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath, Pipe
         if (useQuote) {
             columnValues.reserve(reserveSize);
             parseSuccess
-                = mDelimiterModeFsmParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
+                = mDelimiterModeParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
             // handle auto extend
             if (!(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)
                 && columnValues.size() > mKeys.size()) {
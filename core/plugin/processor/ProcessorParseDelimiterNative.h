@@ -19,7 +19,7 @@
 #include <memory>
 
 #include "models/LogEvent.h"
-#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterModeSimdParser.h"
 #include "pipeline/plugin/interface/Processor.h"
 #include "plugin/processor/CommonParserOptions.h"
 
@@ -34,6 +34,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Required: source field name.
     std::string mSourceKey;
@@ -72,7 +73,7 @@ private:
 
     char mSeparatorChar;
     bool mSourceKeyOverwritten = false;
-    std::unique_ptr<DelimiterModeFsmParser> mDelimiterModeFsmParserPtr;
+    std::unique_ptr<DelimiterModeSimdParser> mDelimiterModeParserPtr;
 
     int* mLogGroupSize = nullptr;
     int* mParseFailures = nullptr;
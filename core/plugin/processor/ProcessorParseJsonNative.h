@@ -30,6 +30,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
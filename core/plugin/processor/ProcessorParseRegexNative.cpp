@@ -59,7 +59,7 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
                            mContext->GetLogstoreName(),
                            mContext->GetRegion());
     }
-    mReg = boost::regex(mRegex);
+    mReg.reset(new RegexMatcher(mRegex));
     mIsWholeLineMode = mRegex == "(.*)";
 
     // Keys
@@ -143,7 +143,7 @@ bool ProcessorParseRegexNative::ProcessEvent(const StringView& logPath, Pipeline
     if (mIsWholeLineMode) {
         parseSuccess = WholeLineModeParser(sourceEvent, mKeys.empty() ? DEFAULT_CONTENT_KEY : mKeys[0]);
     } else {
-        parseSuccess = RegexLogLineParser(sourceEvent, mReg, mKeys, logPath);
+        parseSuccess = RegexLogLineParser(sourceEvent, *mReg, mKeys, logPath);
     }
 
     if (!parseSuccess || !mSourceKeyOverwritten) {
@@ -182,15 +182,15 @@ void ProcessorParseRegexNative::AddLog(const StringView& key,
 }
 
 bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
-                                                   const boost::regex& reg,
+                                                   const RegexMatcher& reg,
                                                    const std::vector<std::string>& keys,
                                                    const StringView& logPath) {
-    boost::match_results<const char*> what;
+    std::vector<StringView> groups;
     std::string exception;
     StringView buffer = sourceEvent.GetContent(mSourceKey);
     bool parseSuccess = true;
     mProcParseInSizeBytes->Add(buffer.size());
-    if (!BoostRegexMatch(buffer.data(), buffer.size(), reg, exception, what, boost::match_default)) {
+    if (!reg.Match(buffer.data(), buffer.size(), groups, exception)) {
         if (!exception.empty()) {
             if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -223,16 +223,16 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
         ++(*mParseFailures);
         mProcParseErrorTotal->Add(1);
         parseSuccess = false;
-    } else if (what.size() <= keys.size()) {
+    } else if (groups.size() < keys.size()) {
         if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
             if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
                 LOG_WARNING(GetContext().GetLogger(),
                             ("parse key count not match",
-                             what.size())("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
+                             groups.size() + 1)("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
                                 "logstore", GetContext().GetLogstoreName())("file", logPath));
             }
             GetContext().GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
-                                              "parse key count not match" + ToString(what.size())
+                                              "parse key count not match" + ToString(groups.size() + 1)
                                                   + "errorlog:" + buffer.to_string(),
                                               GetContext().GetProjectName(),
                                               GetContext().GetLogstoreName(),
@@ -248,7 +248,7 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
     }
 
     for (uint32_t i = 0; i < keys.size(); i++) {
-        AddLog(keys[i], StringView(what[i + 1].begin(), what[i + 1].length()), sourceEvent);
+        AddLog(keys[i], groups[i], sourceEvent);
     }
     return true;
 }
@@ -16,10 +16,10 @@
 
 #pragma once
 
-#include <boost/regex.hpp>
-
+#include <memory>
 #include <vector>
 
+#include "common/RegexMatcher.h"
 #include "models/LogEvent.h"
 #include "pipeline/plugin/interface/Processor.h"
 #include "plugin/processor/CommonParserOptions.h"
@@ -33,6 +33,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -50,14 +51,14 @@ private:
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e);
     bool WholeLineModeParser(LogEvent& sourceEvent, const std::string& key);
     bool RegexLogLineParser(LogEvent& sourceEvent,
-                            const boost::regex& reg,
+                            const RegexMatcher& reg,
                             const std::vector<std::string>& keys,
                             const StringView& logPath);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
 
     bool mSourceKeyOverwritten = false;
     bool mIsWholeLineMode = false;
-    boost::regex mReg;
+    std::shared_ptr<RegexMatcher> mReg;
 
     int* mParseFailures = nullptr;
     int* mRegexMatchFailures = nullptr;
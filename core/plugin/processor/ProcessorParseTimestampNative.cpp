@@ -87,6 +87,8 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    mTimeParser.Init(mSourceFormat, mSourceYear);
+
     mParseTimeFailures = &(GetContext().GetProcessProfile().parseTimeFailures);
     mHistoryFailures = &(GetContext().GetProcessProfile().historyFailures);
 
@@ -186,21 +188,23 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
     // Second-level cache only work when:
     // 1. No %f in the time format
     // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
+    bool endWithNanosecond = mTimeParser.EndsWithNanosecond();
     int nanosecondLength = -1;
     const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
-        bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
+    if ((!mTimeParser.HasNanosecond() || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
+        bool isTimestampNanosecond = mTimeParser.IsEpoch() && (curTimeStr.length() > timeStrCache.length());
         if (endWithNanosecond || isTimestampNanosecond) {
-            strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
+            logTime.tv_nsec = 0;
+            strptimeResult = ParseNanosecond(curTimeStr.data() + timeStrCache.length(),
+                                             curTimeStr.length() - timeStrCache.length(),
+                                             logTime.tv_nsec,
+                                             nanosecondLength);
         } else {
             strptimeResult = curTimeStr.data() + timeStrCache.length();
             logTime.tv_nsec = 0;
         }
     } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        strptimeResult = mTimeParser.Parse(curTimeStr.data(), curTimeStr.size(), logTime, nanosecondLength);
         if (NULL != strptimeResult) {
             timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
             logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "common/TimeFormatParser.h"
 #include "common/TimeUtil.h"
 #include "pipeline/plugin/interface/Processor.h"
 
@@ -27,6 +28,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelizable() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -52,6 +54,8 @@ private:
     bool IsPrefixString(const StringView& all, const StringView& prefix);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    // mSourceFormat compiled at Init.
+    TimeFormatParser mTimeParser;
 
     int* mParseTimeFailures = nullptr;
     int* mHistoryFailures = nullptr;
@@ -20,8 +20,11 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
-#include <codecvt>
-#include <locale>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
 
 #include "common/JsonUtil.h"
 #include "common/ParamExtractor.h"
@@ -180,6 +183,12 @@ bool ProcessorParseContainerLogNative::ProcessEvent(StringView containerType,
     return shouldKeepEvent;
 }
 
+static const char* findDelimiter(const char* begin, const char* end) {
+    const char* pos = static_cast<const char*>(
+        memchr(begin, ProcessorParseContainerLogNative::CONTAINERD_DELIMITER, end - begin));
+    return pos == nullptr ? end : pos;
+}
+
 bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sourceEvent,
                                                                   std::string& errorMsg,
                                                                   PipelineEventGroup& logGroup) {
@@ -187,7 +196,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
 
     // 寻找第一个分隔符位置 时间 _time_
     StringView timeValue;
-    const char* pch1 = std::find(contentValue.begin(), contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch1 = findDelimiter(contentValue.begin(), contentValue.end());
     if (pch1 == contentValue.end()) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "time field cannot be found in log line."
@@ -199,7 +208,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
 
     // 寻找第二个分隔符位置 容器标签 _source_
     StringView sourceValue;
-    const char* pch2 = std::find(pch1 + 1, contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch2 = findDelimiter(pch1 + 1, contentValue.end());
     if (pch2 == contentValue.end()) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "source field cannot be found in log line."
@@ -239,7 +248,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
     }
 
     // 寻找第三个分隔符位置
-    const char* pch3 = std::find(pch2 + 1, contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch3 = findDelimiter(pch2 + 1, contentValue.end());
     if (pch3 == contentValue.end() || pch3 != pch2 + 2) {
         // case: 2021-08-25T07:00:00.000000000Z stdout P
         // case: 2021-08-25T07:00:00.000000000Z stdout PP 1
@@ -271,92 +280,157 @@ static int32_t skipSpaces(char* buffer, int32_t idx, int32_t size) {
 }
 
 static int32_t parseLogType(char* buffer, int32_t idx, int32_t size, DockerLogType& logType) {
-    if (idx + int32_t(ProcessorParseContainerLogNative::DOCKER_JSON_LOG.size()) < size
-        && memcmp(ProcessorParseContainerLogNative::DOCKER_JSON_LOG.data(),
-                  &buffer[idx],
-                  ProcessorParseContainerLogNative::DOCKER_JSON_LOG.size())
-            == 0) {
-        idx += ProcessorParseContainerLogNative::DOCKER_JSON_LOG.size();
-        logType = DockerLogType::Log;
-    } else if (idx + int32_t(ProcessorParseContainerLogNative::DOCKER_JSON_STREAM_TYPE.size()) < size
-               && memcmp(ProcessorParseContainerLogNative::DOCKER_JSON_STREAM_TYPE.data(),
-                         &buffer[idx],
-                         ProcessorParseContainerLogNative::DOCKER_JSON_STREAM_TYPE.size())
-                   == 0) {
-        idx += ProcessorParseContainerLogNative::DOCKER_JSON_STREAM_TYPE.size();
-        logType = DockerLogType::Stream;
-    } else if (idx + int32_t(ProcessorParseContainerLogNative::DOCKER_JSON_TIME.size()) < size
-               && memcmp(ProcessorParseContainerLogNative::DOCKER_JSON_TIME.data(),
-                         &buffer[idx],
-                         ProcessorParseContainerLogNative::DOCKER_JSON_TIME.size())
-                   == 0) {
-        idx += ProcessorParseContainerLogNative::DOCKER_JSON_TIME.size();
-        logType = DockerLogType::Time;
-    } else {
-        return -1;
+    // the keys differ in the first char, so only one of them needs to be compared
+    const std::string* key = nullptr;
+    switch (idx < size ? buffer[idx] : '\0') {
+        case 'l':
+            key = &ProcessorParseContainerLogNative::DOCKER_JSON_LOG;
+            logType = DockerLogType::Log;
+            break;
+        case 's':
+            key = &ProcessorParseContainerLogNative::DOCKER_JSON_STREAM_TYPE;
+            logType = DockerLogType::Stream;
+            break;
+        case 't':
+            key = &ProcessorParseContainerLogNative::DOCKER_JSON_TIME;
+            logType = DockerLogType::Time;
+            break;
+        default:
+            return -1;
+    }
+    if (idx + int32_t(key->size()) < size && memcmp(key->data(), &buffer[idx], key->size()) == 0) {
+        return idx + key->size();
+    }
+    return -1;
+}
+
+// findQuoteOrEscape returns the index of the first '"' or '\\' in [idx, size), or size if there is none.
+static int32_t findQuoteOrEscape(const char* buffer, int32_t idx, int32_t size) {
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i escape = _mm_set1_epi8('\\');
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + idx));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, quote), _mm_cmpeq_epi8(data, escape)));
+        if (mask != 0) {
+            return idx + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (idx < size && buffer[idx] != '\"' && buffer[idx] != '\\') {
+        ++idx;
     }
     return idx;
 }
 
-std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
+static bool parseHex4(const char* buffer, uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = buffer[i];
+        if (c >= '0' && c <= '9') {
+            value = (value << 4) | (c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value = (value << 4) | (c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            value = (value << 4) | (c - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int32_t writeUtf8(uint32_t codePoint, char* dest) {
+    if (codePoint < 0x80) {
+        dest[0] = static_cast<char>(codePoint);
+        return 1;
+    }
+    if (codePoint < 0x800) {
+        dest[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        dest[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000) {
+        dest[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        dest[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        dest[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    dest[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+    dest[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    dest[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    dest[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
 
+// parseValue unescapes the value in place, which is never longer than the escaped one. Bytes are only moved after
+// the first escape, so a value without escapes is just scanned.
 static int32_t parseValue(char* buffer, int32_t idx, int32_t size, DockerLogType logType, int32_t& endIndex) {
-    while (idx < size && buffer[idx] != '\"') {
-        if (buffer[idx] == '\\') {
-            if (logType != DockerLogType::Log) {
-                return -1;
-            }
-            ++idx; // skip escape char
-            if (idx >= size) {
-                return -1;
-            }
-            switch (buffer[idx]) {
-                case '\"':
-                    buffer[endIndex++] = '\"';
-                    break;
-                case '\\':
-                    buffer[endIndex++] = '\\';
-                    break;
-                case '/':
-                    buffer[endIndex++] = '/';
-                    break;
-                case 'b':
-                    buffer[endIndex++] = '\b';
-                    break;
-                case 'f':
-                    buffer[endIndex++] = '\f';
-                    break;
-                case 'n':
-                    buffer[endIndex++] = '\n';
-                    break;
-                case 'r':
-                    buffer[endIndex++] = '\r';
-                    break;
-                case 't':
-                    buffer[endIndex++] = '\t';
-                    break;
-                default:
-                    if (idx + 4 < size && buffer[idx] == 'u') {
-                        std::string unicode_seq;
-                        unicode_seq.append(buffer + idx + 1, 4);
-                        char32_t unicode_char = std::stoul(unicode_seq, nullptr, 16);
-                        std::string res = convert.to_bytes(unicode_char);
-                        for (size_t i = 0; i < res.size(); ++i) {
-                            buffer[endIndex++] = res[i];
-                        }
-                        idx += 4;
-                    } else {
-                        buffer[endIndex++] = '\\';
-                        buffer[endIndex++] = buffer[idx];
+    while (true) {
+        int32_t next = findQuoteOrEscape(buffer, idx, size);
+        if (endIndex != idx) {
+            memmove(buffer + endIndex, buffer + idx, next - idx);
+        }
+        endIndex += next - idx;
+        idx = next;
+        if (idx >= size || buffer[idx] == '\"') {
+            return idx;
+        }
+        if (logType != DockerLogType::Log) {
+            return -1;
+        }
+        ++idx; // skip escape char
+        if (idx >= size) {
+            return -1;
+        }
+        uint32_t codePoint = 0;
+        switch (buffer[idx]) {
+            case '\"':
+                buffer[endIndex++] = '\"';
+                break;
+            case '\\':
+                buffer[endIndex++] = '\\';
+                break;
+            case '/':
+                buffer[endIndex++] = '/';
+                break;
+            case 'b':
+                buffer[endIndex++] = '\b';
+                break;
+            case 'f':
+                buffer[endIndex++] = '\f';
+                break;
+            case 'n':
+                buffer[endIndex++] = '\n';
+                break;
+            case 'r':
+                buffer[endIndex++] = '\r';
+                break;
+            case 't':
+                buffer[endIndex++] = '\t';
+                break;
+            case 'u':
+                if (idx + 4 < size && parseHex4(buffer + idx + 1, codePoint)) {
+                    idx += 4;
+                    // a surrogate pair, e.g. 🌍
+                    uint32_t low = 0;
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && idx + 6 < size && buffer[idx + 1] == '\\'
+                        && buffer[idx + 2] == 'u' && parseHex4(buffer + idx + 3, low) && low >= 0xDC00
+                        && low < 0xE000) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        idx += 6;
                     }
+                    endIndex += writeUtf8(codePoint, buffer + endIndex);
                     break;
-            }
-        } else {
-            buffer[endIndex++] = buffer[idx];
+                }
+                [[fallthrough]];
+            default:
+                buffer[endIndex++] = '\\';
+                buffer[endIndex++] = buffer[idx];
+                break;
         }
         ++idx;
     }
-    return idx;
 }
 
 // buffer: {"log":"Hello, World!","stream":"stdout","time":"2021-12-01T00:00:00.000Z"}
@@ -511,12 +585,12 @@ bool ProcessorParseContainerLogNative::ParseDockerJsonLogLine(LogEvent& sourceEv
         return mKeepingSourceWhenParseFail;
     }
 
-    // time
-    sourceEvent.SetContent(containerTimeKey, timeValue);
+    // time and source point to the source buffer, which is unescaped in place
+    sourceEvent.SetContentNoCopy(containerTimeKey, timeValue);
     mProcParseOutSizeBytes->Add(containerTimeKey.size() + timeValue.size());
 
     // source
-    sourceEvent.SetContent(containerSourceKey, sourceValue);
+    sourceEvent.SetContentNoCopy(containerSourceKey, sourceValue);
     mProcParseOutSizeBytes->Add(containerSourceKey.size() + sourceValue.size());
 
     // content
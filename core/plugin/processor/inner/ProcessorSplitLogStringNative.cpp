@@ -16,6 +16,8 @@
 
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 
+#include <cstring>
+
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 
@@ -83,6 +85,7 @@ void ProcessorSplitLogStringNative::Process(PipelineEventGroup& logGroup) {
     }
     *mSplitLines = newEvents.size();
     logGroup.SwapEvents(newEvents);
+    logGroup.ResetLineIndex();
 }
 
 bool ProcessorSplitLogStringNative::IsSupportedEvent(const PipelineEventPtr& e) const {
@@ -130,11 +133,21 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
 
     StringView sourceVal = sourceEvent.GetContent(mSourceKey);
     StringBuffer sourceKey = logGroup.GetSourceBuffer()->CopyString(mSourceKey);
+    // use split positions found by the reader if any, so that the content is not scanned again
+    const LineIndex* index = logGroup.GetLineIndex(sourceVal, mSplitChar);
+    size_t nextSplit = 0;
 
     size_t begin = 0;
     while (begin < sourceVal.size()) {
         std::unique_ptr<LogEvent> targetEvent = logGroup.CreateLogEvent();
-        StringView content = GetNextLine(sourceVal, begin);
+        StringView content;
+        if (index != nullptr) {
+            size_t end = nextSplit < index->mSplitPositions.size() ? index->mSplitPositions[nextSplit++]
+                                                                    : sourceVal.size();
+            content = StringView(sourceVal.data() + begin, end - begin);
+        } else {
+            content = GetNextLine(sourceVal, begin);
+        }
         targetEvent->SetContentNoCopy(StringView(sourceKey.data, sourceKey.size), content);
         targetEvent->SetTimestamp(
             sourceEvent.GetTimestamp(),
@@ -162,10 +175,9 @@ StringView ProcessorSplitLogStringNative::GetNextLine(StringView log, size_t beg
         return StringView();
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == mSplitChar) {
-            return StringView(log.data() + begin, end - begin);
-        }
+    const char* end = static_cast<const char*>(memchr(log.data() + begin, mSplitChar, log.size() - begin));
+    if (end != nullptr) {
+        return StringView(log.data() + begin, end - log.data() - begin);
     }
     return StringView(log.data() + begin, log.size() - begin);
 }
@@ -40,7 +40,6 @@ static const int SEND_BLOCK_COST_TIME_ALARM_INTERVAL_SECOND = 3;
 namespace logtail {
 
 bool FlusherRunner::Init() {
-    srand(time(nullptr));
     mThreadRes = async(launch::async, &FlusherRunner::Run, this);
     mLastCheckSendClientTime = time(nullptr);
     return true;
@@ -58,34 +57,45 @@ void FlusherRunner::Stop() {
 }
 
 void FlusherRunner::DecreaseHttpSendingCnt() {
-    --mHttpSendingCnt;
+    {
+        lock_guard<mutex> lock(mHttpSendingCntMux);
+        --mHttpSendingCnt;
+    }
+    mHttpSendingCntCond.notify_all();
     SenderQueueManager::GetInstance()->Trigger();
 }
 
 void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
     if (!BOOL_FLAG(enable_full_drain_mode) && item->mFlusher->Name() == "flusher_sls"
         && Application::GetInstance()->IsExiting()) {
+        item->ReleaseConcurrency();
         DiskBufferWriter::GetInstance()->PushToDiskBuffer(item, 3);
         SenderQueueManager::GetInstance()->RemoveItem(item->mFlusher->GetQueueKey(), item);
         return;
     }
 
-    int32_t beforeSleepTime = time(NULL);
-    while (withLimit && !Application::GetInstance()->IsExiting()
-           && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestConcurrency()) {
-        usleep(10 * 1000);
-    }
-    int32_t afterSleepTime = time(NULL);
-    int32_t blockCostTime = afterSleepTime - beforeSleepTime;
-    if (blockCostTime > SEND_BLOCK_COST_TIME_ALARM_INTERVAL_SECOND) {
-        LOG_WARNING(sLogger,
-                    ("sending log group blocked too long because send concurrency reached limit. current "
-                     "concurrency used",
-                     GetSendingBufferCount())("max concurrency", AppConfig::GetInstance()->GetSendRequestConcurrency())(
-                        "blocked time", blockCostTime));
-        LogtailAlarm::GetInstance()->SendAlarm(SENDING_COSTS_TOO_MUCH_TIME_ALARM,
-                                               "sending log group blocked for too much time, cost "
-                                                   + ToString(blockCostTime));
+    if (withLimit && !IsSendingConcurrencyAvailable()) {
+        int32_t beforeSleepTime = time(NULL);
+        {
+            // waked up by DecreaseHttpSendingCnt, and checks exiting periodically
+            unique_lock<mutex> lock(mHttpSendingCntMux);
+            while (!Application::GetInstance()->IsExiting() && !IsSendingConcurrencyAvailable()) {
+                mHttpSendingCntCond.wait_for(lock, chrono::milliseconds(100));
+            }
+        }
+        int32_t afterSleepTime = time(NULL);
+        int32_t blockCostTime = afterSleepTime - beforeSleepTime;
+        if (blockCostTime > SEND_BLOCK_COST_TIME_ALARM_INTERVAL_SECOND) {
+            LOG_WARNING(sLogger,
+                        ("sending log group blocked too long because send concurrency reached limit. current "
+                         "concurrency used",
+                         GetSendingBufferCount())("max concurrency",
+                                                  AppConfig::GetInstance()->GetSendRequestConcurrency())(
+                            "blocked time", blockCostTime));
+            LogtailAlarm::GetInstance()->SendAlarm(SENDING_COSTS_TOO_MUCH_TIME_ALARM,
+                                                   "sending log group blocked for too much time, cost "
+                                                       + ToString(blockCostTime));
+        }
     }
 
     auto req = static_cast<HttpFlusher*>(item->mFlusher)->BuildRequest(item);
@@ -98,40 +108,9 @@ void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
 void FlusherRunner::Run() {
     LOG_INFO(sLogger, ("flusher runner", "started"));
     while (true) {
-        int32_t curTime = time(NULL);
-
-        vector<SenderQueueItem*> items;
-        SenderQueueManager::GetInstance()->GetAllAvailableItems(items, !Application::GetInstance()->IsExiting());
-        if (items.empty()) {
+        if (!TakeAndDispatchItems()) {
+            // waked up when items are pushed to sender queues or sending requests are done
             SenderQueueManager::GetInstance()->Wait(1000);
-        } else {
-            // smoothing send tps, walk around webserver load burst
-            uint32_t bufferPackageCount = items.size();
-            if (!Application::GetInstance()->IsExiting() && AppConfig::GetInstance()->IsSendRandomSleep()) {
-                int64_t sleepMicroseconds = 0;
-                if (bufferPackageCount < 20)
-                    sleepMicroseconds = (rand() % 30) * 10000; // 0ms ~ 300ms
-                else if (bufferPackageCount < 30)
-                    sleepMicroseconds = (rand() % 20) * 10000; // 0ms ~ 200ms
-                else if (bufferPackageCount < 40)
-                    sleepMicroseconds = (rand() % 10) * 10000; // 0ms ~ 100ms
-                if (sleepMicroseconds > 0)
-                    usleep(sleepMicroseconds);
-            }
-        }
-
-        for (auto itr = items.begin(); itr != items.end(); ++itr) {
-            int32_t waitTime = curTime - (*itr)->mEnqueTime;
-            LOG_DEBUG(sLogger,
-                      ("got item from sender queue, item address",
-                       *itr)("config-flusher-dst", QueueKeyManager::GetInstance()->GetName((*itr)->mQueueKey))(
-                          "wait time", ToString(waitTime))("try cnt", ToString((*itr)->mTryCnt)));
-
-            if (!Application::GetInstance()->IsExiting() && AppConfig::GetInstance()->IsSendFlowControl()) {
-                RateLimiter::FlowControl((*itr)->mRawSize, mSendLastTime, mSendLastByte, true);
-            }
-
-            Dispatch(*itr);
         }
 
         // TODO: move the following logic to scheduler
@@ -141,21 +120,55 @@ void FlusherRunner::Run() {
             mLastCheckSendClientTime = time(NULL);
         }
 
-        if (mIsFlush && SenderQueueManager::GetInstance()->IsAllQueueEmpty()) {
+        if (mIsFlush && mPendingItems.empty() && SenderQueueManager::GetInstance()->IsAllQueueEmpty()) {
             break;
         }
     }
 }
 
+bool FlusherRunner::TakeAndDispatchItems() {
+    bool isExiting = Application::GetInstance()->IsExiting();
+    vector<SenderQueueItem*> items;
+    SenderQueueManager::GetInstance()->GetAllAvailableItems(items, !isExiting);
+    for (auto item : items) {
+        mPendingItems.push(PendingItem{item, mPendingItemSeq++});
+    }
+
+    int32_t curTime = time(NULL);
+    bool dispatched = false;
+    // on exit, items are dispatched without limits as they are taken
+    while (!mPendingItems.empty() && (isExiting || IsSendingConcurrencyAvailable())) {
+        SenderQueueItem* item = mPendingItems.top().mItem;
+        mPendingItems.pop();
+        LOG_DEBUG(sLogger,
+                  ("got item from sender queue, item address",
+                   item)("config-flusher-dst", QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
+                      "wait time", ToString(curTime - item->mEnqueTime))("try cnt", ToString(item->mTryCnt)));
+
+        if (!isExiting && AppConfig::GetInstance()->IsSendFlowControl()) {
+            RateLimiter::FlowControl(item->mRawSize, mSendLastTime, mSendLastByte, true);
+        }
+
+        Dispatch(item);
+        dispatched = true;
+    }
+    return dispatched;
+}
+
 void FlusherRunner::Dispatch(SenderQueueItem* item) {
     switch (item->mFlusher->GetSinkType()) {
         case SinkType::HTTP:
             PushToHttpSink(item);
             break;
         default:
+            item->ReleaseConcurrency();
             SenderQueueManager::GetInstance()->RemoveItem(item->mFlusher->GetQueueKey(), item);
             break;
     }
 }
 
+bool FlusherRunner::IsSendingConcurrencyAvailable() const {
+    return mHttpSendingCnt < AppConfig::GetInstance()->GetSendRequestConcurrency();
+}
+
 } // namespace logtail
@@ -17,8 +17,12 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <future>
+#include <mutex>
+#include <queue>
+#include <vector>
 
 #include "pipeline/plugin/interface/Flusher.h"
 #include "pipeline/queue/SenderQueueItem.h"
@@ -47,16 +51,43 @@ public:
     int32_t GetSendingBufferCount() { return mHttpSendingCnt; }
 
 private:
+    // PendingItem is an item taken from sender queues but not dispatched yet, because send concurrency is used up.
+    struct PendingItem {
+        SenderQueueItem* mItem;
+        uint64_t mSeq;
+    };
+    // items enqueued earlier are dispatched first, and items enqueued in the same second are dispatched in order
+    struct PendingItemLater {
+        bool operator()(const PendingItem& lhs, const PendingItem& rhs) const {
+            if (lhs.mItem->mEnqueTime != rhs.mItem->mEnqueTime) {
+                return lhs.mItem->mEnqueTime > rhs.mItem->mEnqueTime;
+            }
+            return lhs.mSeq > rhs.mSeq;
+        }
+    };
+
     FlusherRunner() = default;
     ~FlusherRunner() = default;
 
     void Run();
+    // TakeAndDispatchItems takes available items from sender queues, and dispatches pending items as long as send
+    // concurrency allows.
+    // @return true if any item is dispatched
+    bool TakeAndDispatchItems();
     void Dispatch(SenderQueueItem* item);
+    bool IsSendingConcurrencyAvailable() const;
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
 
     std::atomic_int mHttpSendingCnt{0};
+    // for PushToHttpSink to wait until sending concurrency is available
+    std::mutex mHttpSendingCntMux;
+    std::condition_variable mHttpSendingCntCond;
+
+    // only accessed by the runner thread
+    std::priority_queue<PendingItem, std::vector<PendingItem>, PendingItemLater> mPendingItems;
+    uint64_t mPendingItemSeq = 0;
 
     // TODO: temporarily here
     int32_t mLastCheckSendClientTime = 0;
@@ -112,6 +112,11 @@ void LogProcess::Resume() {
     LOG_INFO(sLogger, ("process daemon resume", "succeeded"));
 }
 
+void LogProcess::WaitForPoppedItems() {
+    // items are popped and processed with the read lock held, so all of them are done once the write lock is got
+    WriteLock lock(mAccessProcessThreadRWL);
+}
+
 bool LogProcess::FlushOut(int32_t waitMs) {
     ProcessQueueManager::GetInstance()->Trigger();
     if (ProcessQueueManager::GetInstance()->IsAllQueueEmpty()) {
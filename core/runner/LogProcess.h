@@ -38,6 +38,9 @@ public:
     void Start();
     void HoldOn();
     void Resume();
+    // WaitForPoppedItems returns after all items popped before the call are processed and sent. Unlike HoldOn, process
+    // threads are only blocked until then.
+    void WaitForPoppedItems();
     bool FlushOut(int32_t waitMs);
 
     void* ProcessLoop(int32_t threadNo);
@@ -0,0 +1,151 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runner/ProcessSliceRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+#include "common/ThreadPool.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(process_slice_thread_count,
+                  "helper threads to process slices of a large event group, -1 for process thread count - 1",
+                  -1);
+DEFINE_FLAG_INT32(process_slice_min_events, "groups with fewer events are processed by one thread", 4096);
+DEFINE_FLAG_INT32(process_slice_events, "events in one slice when a group is processed by several threads", 512);
+
+using namespace std;
+
+namespace logtail {
+
+struct ProcessSliceRunner::Job {
+    const vector<ProcessorInstance*>* mProcessors = nullptr;
+    // each slice is a list of one group, as required by ProcessorInstance::Process
+    vector<vector<PipelineEventGroup>> mSlices;
+    atomic_size_t mNext{0};
+
+    mutex mMux;
+    condition_variable mCond;
+    size_t mDone = 0;
+};
+
+ProcessSliceRunner::ProcessSliceRunner() {
+    int32_t threadCount = INT32_FLAG(process_slice_thread_count);
+    if (threadCount < 0) {
+        threadCount = AppConfig::GetInstance()->GetProcessThreadCount() - 1;
+    }
+    if (threadCount > 0) {
+        mThreadCount = static_cast<size_t>(threadCount);
+        mThreadPool.reset(new ThreadPool(mThreadCount));
+        mThreadPool->Start();
+        LOG_INFO(sLogger, ("process slice runner", "started")("helper threads", mThreadCount));
+    }
+}
+
+ProcessSliceRunner::~ProcessSliceRunner() {
+    if (mThreadPool) {
+        mThreadPool->Stop();
+    }
+}
+
+void ProcessSliceRunner::Process(const vector<ProcessorInstance*>& processors,
+                                 vector<PipelineEventGroup>& logGroupList) {
+    if (logGroupList.size() != 1 || !CanSplit(logGroupList[0])) {
+        for (auto& p : processors) {
+            p->Process(logGroupList);
+        }
+        return;
+    }
+    ProcessInParallel(processors, logGroupList[0]);
+}
+
+bool ProcessSliceRunner::CanSplit(PipelineEventGroup& group) const {
+    if (!IsEnabled() || group.GetExactlyOnceCheckpoint() != nullptr) {
+        return false;
+    }
+    size_t minEvents = max(static_cast<size_t>(max(INT32_FLAG(process_slice_min_events), 0)),
+                           2 * static_cast<size_t>(max(INT32_FLAG(process_slice_events), 1)));
+    return group.GetEvents().size() >= minEvents;
+}
+
+void ProcessSliceRunner::ProcessInParallel(const vector<ProcessorInstance*>& processors, PipelineEventGroup& group) {
+    // helper tasks may start after the job is done, so the job is shared with them
+    auto job = make_shared<Job>();
+    job->mProcessors = &processors;
+
+    EventsContainer& events = group.MutableEvents();
+    const size_t sliceSize = static_cast<size_t>(max(INT32_FLAG(process_slice_events), 1));
+    const size_t sliceCount = (events.size() + sliceSize - 1) / sliceSize;
+    job->mSlices.resize(sliceCount);
+    for (size_t i = 0; i < sliceCount; ++i) {
+        job->mSlices[i].emplace_back(make_shared<SourceBuffer>());
+        PipelineEventGroup& slice = job->mSlices[i].back();
+        slice.SetAllMetadata(group.GetAllMetadata());
+        slice.GetSizedTags() = group.GetSizedTags();
+        size_t begin = i * sliceSize;
+        size_t end = min(begin + sliceSize, events.size());
+        EventsContainer& sliceEvents = slice.MutableEvents();
+        sliceEvents.reserve(end - begin);
+        for (size_t j = begin; j < end; ++j) {
+            events[j]->ResetPipelineEventGroup(&slice);
+            sliceEvents.emplace_back(std::move(events[j]));
+        }
+    }
+    events.clear();
+
+    size_t helperCount = min(mThreadCount, sliceCount - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        mThreadPool->Add([job]() { RunSlices(*job); });
+    }
+    RunSlices(*job);
+    {
+        unique_lock<mutex> lock(job->mMux);
+        job->mCond.wait(lock, [&job]() { return job->mDone == job->mSlices.size(); });
+    }
+
+    // slices are not removed from the job, so that helpers starting late find no slice left
+    for (auto& slices : job->mSlices) {
+        for (auto& slice : slices) {
+            group.GetSourceBuffer()->Absorb(*slice.GetSourceBuffer());
+            for (auto& e : slice.MutableEvents()) {
+                e->ResetPipelineEventGroup(&group);
+                events.emplace_back(std::move(e));
+            }
+            slice.MutableEvents().clear();
+        }
+    }
+}
+
+void ProcessSliceRunner::RunSlices(Job& job) {
+    while (true) {
+        size_t idx = job.mNext.fetch_add(1);
+        if (idx >= job.mSlices.size()) {
+            return;
+        }
+        for (auto& p : *job.mProcessors) {
+            p->Process(job.mSlices[idx]);
+        }
+        lock_guard<mutex> lock(job.mMux);
+        if (++job.mDone == job.mSlices.size()) {
+            job.mCond.notify_one();
+        }
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "models/PipelineEventGroup.h"
+#include "pipeline/plugin/instance/ProcessorInstance.h"
+
+namespace logtail {
+
+class ThreadPool;
+
+// ProcessSliceRunner runs parallelizable processors on a large event group with several threads.
+//
+// The events of the group are moved to slices of contiguous events, each of which is a group sharing the metadata and
+// tags of the original one, but with its own source buffer. Slices are claimed one by one by the calling thread and
+// the helper threads, so that a slow slice does not block others, and are moved back in order after all of them are
+// processed. Strings allocated by processors in slices are kept alive by the source buffer of the original group.
+class ProcessSliceRunner {
+public:
+    static ProcessSliceRunner* GetInstance() {
+        static ProcessSliceRunner* ptr = new ProcessSliceRunner();
+        return ptr;
+    }
+
+    // Process runs @processors in order on each group of @logGroupList, in parallel if the group is large enough.
+    void Process(const std::vector<ProcessorInstance*>& processors, std::vector<PipelineEventGroup>& logGroupList);
+
+    // IsEnabled returns false if there is no helper thread, and Process is the same as running processors serially.
+    bool IsEnabled() const { return mThreadCount > 0; }
+
+private:
+    struct Job;
+
+    ProcessSliceRunner();
+    ~ProcessSliceRunner();
+
+    bool CanSplit(PipelineEventGroup& group) const;
+    void ProcessInParallel(const std::vector<ProcessorInstance*>& processors, PipelineEventGroup& group);
+    static void RunSlices(Job& job);
+
+    size_t mThreadCount = 0;
+    std::unique_ptr<ThreadPool> mThreadPool;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessSliceRunnerUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -89,6 +89,7 @@ bool HttpSink::AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request) {
                                    AppConfig::GetInstance()->IsHostIPReplacePolicyEnabled(),
                                    AppConfig::GetInstance()->GetBindInterface());
     if (curl == nullptr) {
+        request->mItem->ReleaseConcurrency();
         request->mItem->mStatus = SendingStatus::IDLE;
         FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
         LOG_ERROR(sLogger,
@@ -103,6 +104,7 @@ bool HttpSink::AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request) {
     request->mLastSendTime = time(nullptr);
     auto res = curl_multi_add_handle(mClient, curl);
     if (res != CURLM_OK) {
+        request->mItem->ReleaseConcurrency();
         request->mItem->mStatus = SendingStatus::IDLE;
         FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
         curl_easy_cleanup(curl);
@@ -200,6 +202,9 @@ void HttpSink::HandleCompletedRequests() {
                     long statusCode = 0;
                     curl_easy_getinfo(handler, CURLINFO_RESPONSE_CODE, &statusCode);
                     request->mResponse.mStatusCode = (int32_t)statusCode;
+                    double totalTime = 0;
+                    curl_easy_getinfo(handler, CURLINFO_TOTAL_TIME, &totalTime);
+                    request->mResponse.mResponseTimeMs = static_cast<uint32_t>(totalTime * 1000);
                     static_cast<HttpFlusher*>(request->mItem->mFlusher)->OnSendDone(request->mResponse, request->mItem);
                     FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     break;
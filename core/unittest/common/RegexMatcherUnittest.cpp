@@ -0,0 +1,177 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/ParamExtractor.h"
+#include "common/RegexMatcher.h"
+#include "common/StringTools.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+class RegexMatcherUnittest : public ::testing::Test {
+public:
+    void TestEngine();
+    void TestPrefix();
+    void TestSearch();
+    void TestMatchGroups();
+    void TestConsistency();
+    void TestInvalidPattern();
+
+private:
+    void CheckSame(const RegexMatcher& matcher, const std::string& str) const {
+        std::string exception;
+        const auto& reg = matcher.GetBoostRegex();
+        APSARA_TEST_EQUAL_FATAL(BoostRegexSearch(str.data(), str.size(), reg, exception),
+                                matcher.Search(str.data(), str.size(), exception));
+        APSARA_TEST_EQUAL_FATAL(BoostRegexMatch(str.data(), str.size(), reg, exception),
+                                matcher.Match(str.data(), str.size(), exception));
+        boost::match_results<const char*> what;
+        std::vector<StringView> groups;
+        bool res = BoostRegexMatch(str.data(), str.size(), reg, exception, what, boost::match_default);
+        APSARA_TEST_EQUAL_FATAL(res, matcher.Match(str.data(), str.size(), groups, exception));
+        if (res) {
+            APSARA_TEST_EQUAL_FATAL(what.size() - 1, groups.size());
+            for (size_t i = 0; i < groups.size(); ++i) {
+                APSARA_TEST_EQUAL_FATAL(std::string(what[i + 1].first, what[i + 1].second), groups[i].to_string());
+            }
+        }
+    }
+};
+
+void RegexMatcherUnittest::TestEngine() {
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::PREFIX, RegexMatcher(R"(\d{4}-\d{2}-\d{2})").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::PREFIX, RegexMatcher(R"(\[)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::RE2, RegexMatcher(R"(\d{4}-\d{2}-\d{2}.*)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::RE2, RegexMatcher(R"((\S+)\s+(\w+).*)").GetEngine());
+    // backreference
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"((\w+)\s\1)").GetEngine());
+    // lookahead
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"(\d+(?=ms))").GetEngine());
+    // '$' differs for search
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"(.*end$)").GetEngine());
+}
+
+void RegexMatcherUnittest::TestPrefix() {
+    RegexMatcher matcher(R"(\d{4}-\d{2}-\d{2}\s.*)");
+    APSARA_TEST_EQUAL(11U, matcher.mPrefix.size());
+    APSARA_TEST_FALSE(matcher.mPrefixIsPattern);
+    std::string exception;
+    APSARA_TEST_TRUE(matcher.Search("2024-05-20 10:00:00", 19, exception));
+    APSARA_TEST_FALSE(matcher.Search("\tat com.example", 15, exception));
+    APSARA_TEST_FALSE(matcher.Search("2024-05-2", 9, exception));
+
+    // alternation at top level has no prefix
+    RegexMatcher alter(R"(\d+|\[)");
+    APSARA_TEST_TRUE(alter.mPrefix.empty());
+    APSARA_TEST_TRUE(alter.Search("[a", 2, exception));
+    APSARA_TEST_TRUE(alter.Search("12", 2, exception));
+}
+
+void RegexMatcherUnittest::TestSearch() {
+    std::string exception;
+    {
+        RegexMatcher matcher(R"(\[\d{3}\])");
+        APSARA_TEST_TRUE(matcher.mPrefixIsPattern);
+        std::string str = "[123] hello";
+        APSARA_TEST_TRUE(matcher.Search(str.data(), str.size(), exception));
+        APSARA_TEST_FALSE(matcher.Match(str.data(), str.size(), exception));
+        str = "[123]";
+        APSARA_TEST_TRUE(matcher.Match(str.data(), str.size(), exception));
+        str = "[12a]";
+        APSARA_TEST_FALSE(matcher.Search(str.data(), str.size(), exception));
+    }
+    {
+        // search is anchored at the beginning of buffer
+        RegexMatcher matcher(R"(ERROR.*)");
+        std::string str = "2024 ERROR";
+        APSARA_TEST_FALSE(matcher.Search(str.data(), str.size(), exception));
+        str = "ERROR\nnext line";
+        APSARA_TEST_TRUE(matcher.Match(str.data(), str.size(), exception));
+    }
+}
+
+void RegexMatcherUnittest::TestMatchGroups() {
+    RegexMatcher matcher(R"re((\S+)\s-\s(\S+)\s\[([^]]+)]\s"(\w+)\s(\S+)\s([^"]+)"\s(\d+)\s(\d+)(\s.*)?)re");
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::RE2, matcher.GetEngine());
+    APSARA_TEST_EQUAL(9U, matcher.GetGroupCount());
+    std::string str = R"(127.0.0.1 - - [20/May/2024:10:00:00 +0800] "GET /index.html HTTP/1.1" 200 1024)";
+    std::vector<StringView> groups;
+    std::string exception;
+    APSARA_TEST_TRUE(matcher.Match(str.data(), str.size(), groups, exception));
+    APSARA_TEST_EQUAL(9U, groups.size());
+    APSARA_TEST_EQUAL("127.0.0.1", groups[0].to_string());
+    APSARA_TEST_EQUAL("20/May/2024:10:00:00 +0800", groups[2].to_string());
+    APSARA_TEST_EQUAL("HTTP/1.1", groups[5].to_string());
+    APSARA_TEST_EQUAL("1024", groups[7].to_string());
+    // unmatched group is empty
+    APSARA_TEST_EQUAL("", groups[8].to_string());
+    CheckSame(matcher, str);
+}
+
+void RegexMatcherUnittest::TestConsistency() {
+    const std::vector<std::string> patterns = {R"(\d{4}-\d{2}-\d{2})",
+                                               R"(\d{4}-\d{2}-\d{2}.*)",
+                                               R"(\[\d+\]\s\w+)",
+                                               R"(\s+at\s.*)",
+                                               R"([^\s]+\s.*)",
+                                               R"(.*)",
+                                               R"(^a.*)",
+                                               R"(a.*b$)",
+                                               R"(.*\d$)",
+                                               R"((a|ab)(c|bcd)(d*))",
+                                               R"((\w+)\s\1)",
+                                               R"(\x41\W\D.)",
+                                               R"([a-c\d]{2}[^a]?)",
+                                               R"((a)?b)",
+                                               R"(a{2,}\S*)"};
+    const std::string alphabet = std::string("abcdAB019 -[]\t\n\r\f\v") + '\x80' + '\xe4';
+    std::mt19937 rng(0);
+    for (const auto& pattern : patterns) {
+        RegexMatcher matcher(pattern);
+        for (int i = 0; i < 2000; ++i) {
+            std::string str;
+            size_t size = rng() % 12;
+            for (size_t j = 0; j < size; ++j) {
+                str += alphabet[rng() % alphabet.size()];
+            }
+            CheckSame(matcher, str);
+        }
+    }
+}
+
+void RegexMatcherUnittest::TestInvalidPattern() {
+    APSARA_TEST_FALSE(IsRegexValid("(abc"));
+    bool thrown = false;
+    try {
+        RegexMatcher matcher("(abc");
+    } catch (const boost::regex_error&) {
+        thrown = true;
+    }
+    APSARA_TEST_TRUE(thrown);
+}
+
+UNIT_TEST_CASE(RegexMatcherUnittest, TestEngine)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestPrefix)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestSearch)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestMatchGroups)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestConsistency)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestInvalidPattern)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,225 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/TimeFormatParser.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+class TimeFormatParserUnittest : public ::testing::Test {
+public:
+    void TestCompile();
+    void TestParse();
+    void TestEpoch();
+    void TestNanosecond();
+    void TestSpecifiedYear();
+    void TestConsistency();
+
+private:
+    void CheckSame(const TimeFormatParser& parser, const std::string& str, int32_t specifiedYear) const {
+        LogtailTime expected = {0, 0}, actual = {0, 0};
+        int expectedLength = -1, actualLength = -1;
+        const char* expectedRes
+            = Strptime(str.c_str(), parser.GetFormat().c_str(), &expected, expectedLength, specifiedYear);
+        const char* actualRes = parser.Parse(str.data(), str.size(), actual, actualLength);
+        APSARA_TEST_EQUAL_FATAL(expectedRes, actualRes);
+        if (expectedRes != nullptr) {
+            APSARA_TEST_EQUAL_FATAL(expected.tv_sec, actual.tv_sec);
+            APSARA_TEST_EQUAL_FATAL(expected.tv_nsec, actual.tv_nsec);
+            APSARA_TEST_EQUAL_FATAL(expectedLength, actualLength);
+        }
+    }
+};
+
+void TimeFormatParserUnittest::TestCompile() {
+    const std::vector<std::pair<std::string, bool>> cases = {
+        {"%Y-%m-%d %H:%M:%S", true},
+        {"%Y-%m-%dT%H:%M:%S.%f%z", true},
+        {"%d/%b/%Y:%H:%M:%S %z", true},
+        {"%a %b %e %H:%M:%S %Y", true},
+        {"%F %T", true},
+        {"%c", true},
+        {"%s", true},
+        {"%f", false},
+        {"%Y-%m-%d %H:%M:%S %Z", false},
+        {"%D", false},
+        {"%C%y", false},
+        {"%Ey", false},
+        {"%Y%", false},
+    };
+    for (const auto& c : cases) {
+        TimeFormatParser parser;
+        parser.Init(c.first);
+        APSARA_TEST_EQUAL_DESC(c.second, parser.IsCompiled(), c.first);
+    }
+    TimeFormatParser parser;
+    parser.Init("%Y-%m-%d %H:%M:%S.%f");
+    APSARA_TEST_TRUE(parser.HasNanosecond());
+    APSARA_TEST_TRUE(parser.EndsWithNanosecond());
+    parser.Init("%H:%M:%S.%f %Y-%m-%d");
+    APSARA_TEST_TRUE(parser.HasNanosecond());
+    APSARA_TEST_FALSE(parser.EndsWithNanosecond());
+    parser.Init("%Y");
+    APSARA_TEST_FALSE(parser.HasNanosecond());
+    APSARA_TEST_FALSE(parser.EndsWithNanosecond());
+}
+
+void TimeFormatParserUnittest::TestParse() {
+    TimeFormatParser parser;
+    parser.Init("%Y-%m-%d %H:%M:%S.%f");
+    std::string str = "2017-01-11 15:05:07.012 tail";
+    LogtailTime ts = {0, 0};
+    int nanosecondLength = -1;
+    const char* res = parser.Parse(str.data(), str.size(), ts, nanosecondLength);
+    APSARA_TEST_EQUAL(str.data() + 23, res);
+    LogtailTime expected = {0, 0};
+    int expectedLength = -1;
+    Strptime(str.c_str(), "%Y-%m-%d %H:%M:%S.%f", &expected, expectedLength);
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(12000000L, ts.tv_nsec);
+    APSARA_TEST_EQUAL(3, nanosecondLength);
+
+    // the buffer is not read beyond size
+    res = parser.Parse(str.data(), 19, ts, nanosecondLength);
+    APSARA_TEST_EQUAL(nullptr, res);
+
+    parser.Init("%d/%b/%Y:%H:%M:%S %z");
+    str = "11/jan/2017:15:05:07 +0800";
+    nanosecondLength = -1;
+    res = parser.Parse(str.data(), str.size(), ts, nanosecondLength);
+    APSARA_TEST_EQUAL(str.data() + str.size(), res);
+    // offset in %z is not applied, same as Strptime
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(0L, ts.tv_nsec);
+    APSARA_TEST_EQUAL(-1, nanosecondLength);
+}
+
+void TimeFormatParserUnittest::TestEpoch() {
+    TimeFormatParser parser;
+    parser.Init("%s");
+    const std::vector<std::pair<std::string, std::pair<time_t, long>>> cases = {
+        {"1484147107", {1484147107, 0}},
+        {"1484147107123", {1484147107, 123000000}},
+        {"1484147107123456789", {1484147107, 123456789}},
+        {"148414710", {148414710, 0}},
+        {"1484147107]", {1484147107, 0}},
+    };
+    for (const auto& c : cases) {
+        LogtailTime ts = {0, 0};
+        int nanosecondLength = -1;
+        APSARA_TEST_TRUE(parser.Parse(c.first.data(), c.first.size(), ts, nanosecondLength) != nullptr);
+        APSARA_TEST_EQUAL(c.second.first, ts.tv_sec);
+        APSARA_TEST_EQUAL(c.second.second, ts.tv_nsec);
+        CheckSame(parser, c.first, -1);
+    }
+    // left to Strptime
+    CheckSame(parser, " 1484147107", -1);
+    CheckSame(parser, "01484147107", -1);
+    CheckSame(parser, "0", -1);
+    CheckSame(parser, "abc", -1);
+}
+
+void TimeFormatParserUnittest::TestNanosecond() {
+    const std::vector<std::pair<std::string, long>> cases = {
+        {"1", 100000000},
+        {"012", 12000000},
+        {"12345678", 123456780},
+        {"123456789", 123456789},
+        {"123456789123", static_cast<long>(123456789123ULL & 0xFFFFFFFFULL)},
+        {"5 tail", 500000000},
+    };
+    for (const auto& c : cases) {
+        long nanosecond = 0;
+        int nanosecondLength = 0;
+        const char* res = ParseNanosecond(c.first.data(), c.first.size(), nanosecond, nanosecondLength);
+        APSARA_TEST_TRUE(res != nullptr);
+        APSARA_TEST_EQUAL(c.second, nanosecond);
+        // same as Strptime
+        LogtailTime ts = {0, 0};
+        int length = 0;
+        APSARA_TEST_EQUAL(Strptime(c.first.c_str(), "%f", &ts, length), res);
+        APSARA_TEST_EQUAL(ts.tv_nsec, nanosecond);
+        APSARA_TEST_EQUAL(length, nanosecondLength);
+    }
+    long nanosecond = 0;
+    int nanosecondLength = 0;
+    APSARA_TEST_EQUAL(nullptr, ParseNanosecond("a1", 2, nanosecond, nanosecondLength));
+    APSARA_TEST_EQUAL(nullptr, ParseNanosecond("1", 0, nanosecond, nanosecondLength));
+}
+
+void TimeFormatParserUnittest::TestSpecifiedYear() {
+    for (int32_t year : {-1, 0, 2018}) {
+        TimeFormatParser parser;
+        parser.Init("%b %d %H:%M:%S", year);
+        APSARA_TEST_TRUE(parser.IsCompiled());
+        CheckSame(parser, "Jan 11 15:05:07", year);
+        CheckSame(parser, "Dec 31 23:59:59", year);
+        CheckSame(parser, "Feb 29 00:00:00", year);
+        parser.Init("%Y %b %d %H:%M:%S", year);
+        CheckSame(parser, "2017 Jan 11 15:05:07", year);
+    }
+}
+
+void TimeFormatParserUnittest::TestConsistency() {
+    const std::vector<std::string> formats = {"%Y-%m-%d %H:%M:%S",
+                                              "%Y-%m-%d %H:%M:%S.%f",
+                                              "%Y-%m-%dT%H:%M:%S%z",
+                                              "%d/%b/%Y:%H:%M:%S %z",
+                                              "%a %b %e %H:%M:%S %Y",
+                                              "%y%m%d %I:%M:%S %p",
+                                              "%Y/%m/%d %k:%M:%S,%f",
+                                              "%c",
+                                              "%f %T",
+                                              "%s"};
+    const std::vector<std::string> samples = {"2024-05-20 10:11:12",
+                                              "2024-05-20 10:11:12.123456",
+                                              "2024-05-20T10:11:12+08:00",
+                                              "2024-05-20T10:11:12EDT",
+                                              "20/May/2024:10:11:12 -0730",
+                                              "Mon May 20 10:11:12 2024",
+                                              "240520 11:11:12 PM",
+                                              "2024/05/20  9:11:12,001",
+                                              "0000-01-01 00:00:00",
+                                              "9999-12-31 23:59:60",
+                                              "2024-02-30 25:61:61",
+                                              "1716171072123"};
+    const std::string alphabet = "0123456789 -:/.+ZTMayPM";
+    std::mt19937 rng(0);
+    for (const auto& format : formats) {
+        TimeFormatParser parser;
+        parser.Init(format);
+        for (int i = 0; i < 5000; ++i) {
+            std::string str = samples[rng() % samples.size()];
+            for (uint32_t j = rng() % 3; j > 0 && !str.empty(); --j) {
+                str[rng() % str.size()] = alphabet[rng() % alphabet.size()];
+            }
+            CheckSame(parser, str, -1);
+        }
+    }
+}
+
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestCompile)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestParse)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestEpoch)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestNanosecond)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestSpecifiedYear)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestConsistency)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,148 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/Utf8Util.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+class Utf8UtilUnittest : public ::testing::Test {
+public:
+    void TestFindFirstInvalid();
+    void TestSimdConsistency();
+    void TestReplaceInvalid();
+    void TestAlignTail();
+
+private:
+    std::vector<Utf8SimdLevel> GetSupportedLevels() const {
+        std::vector<Utf8SimdLevel> levels{Utf8SimdLevel::NONE};
+        if (GetUtf8SimdLevel() >= Utf8SimdLevel::SSE4) {
+            levels.push_back(Utf8SimdLevel::SSE4);
+        }
+        if (GetUtf8SimdLevel() >= Utf8SimdLevel::AVX2) {
+            levels.push_back(Utf8SimdLevel::AVX2);
+        }
+        return levels;
+    }
+};
+
+void Utf8UtilUnittest::TestFindFirstInvalid() {
+    // pad so that the invalid byte is checked by simd blocks and by the scalar tail
+    const std::string padding(45, 'a');
+    const std::vector<std::pair<std::string, size_t>> cases = {
+        {"", 0},
+        {"hello", 5},
+        {"中文\xf0\x9f\x98\x80", 10},
+        {"\xed\xa0\x80", 3}, // surrogate is accepted
+        {"\x80", 0}, // single continuation
+        {"a\xc0\xaf", 1}, // overlong 2 bytes
+        {"a\xe0\x80\x80", 1}, // overlong 3 bytes
+        {"a\xf0\x80\x80\x80", 1}, // overlong 4 bytes
+        {"a\xf4\x90\x80\x80", 1}, // > U+10FFFF
+        {"a\xf5\x80\x80\x80", 1},
+        {"a\xff", 1},
+        {"中\xe6\x96", 3}, // truncated
+        {"中\xe6\x96" "a", 3},
+        {"\xc3\xa9\xa9", 2}, // extra continuation
+    };
+    for (auto level : GetSupportedLevels()) {
+        for (const auto& c : cases) {
+            APSARA_TEST_EQUAL(c.second, FindFirstInvalidUtf8(c.first.data(), c.first.size(), level));
+            std::string str = padding + c.first;
+            APSARA_TEST_EQUAL(padding.size() + c.second, FindFirstInvalidUtf8(str.data(), str.size(), level));
+            str = padding + c.first + padding;
+            size_t expected = c.second == c.first.size() ? str.size() : padding.size() + c.second;
+            APSARA_TEST_EQUAL(expected, FindFirstInvalidUtf8(str.data(), str.size(), level));
+        }
+    }
+}
+
+void Utf8UtilUnittest::TestSimdConsistency() {
+    const std::vector<std::string> pieces = {"a",
+                                             " ",
+                                             "\n",
+                                             "\xc3\xa9",
+                                             "\xe4\xb8\xad",
+                                             "\xf0\x9f\x98\x80",
+                                             "\xed\xa0\x80",
+                                             "\xe0\x80\x80",
+                                             "\xc1\xbf",
+                                             "\xf4\x90\x80\x80",
+                                             "\x80",
+                                             "\xe4\xb8",
+                                             "\xf0\x9f"};
+    std::mt19937 rng(0);
+    for (int i = 0; i < 10000; ++i) {
+        std::string str;
+        size_t size = rng() % 200;
+        // mostly valid, so that the invalid byte appears at different offsets
+        while (str.size() < size) {
+            str += rng() % 50 == 0 ? pieces[rng() % pieces.size()] : pieces[rng() % 7];
+        }
+        size_t expected = FindFirstInvalidUtf8(str.data(), str.size(), Utf8SimdLevel::NONE);
+        for (auto level : GetSupportedLevels()) {
+            APSARA_TEST_EQUAL_FATAL(expected, FindFirstInvalidUtf8(str.data(), str.size(), level));
+        }
+    }
+}
+
+void Utf8UtilUnittest::TestReplaceInvalid() {
+    {
+        std::string str = "中文";
+        APSARA_TEST_FALSE(ReplaceInvalidUtf8(const_cast<char*>(str.data()), str.size()));
+        APSARA_TEST_EQUAL("中文", str);
+    }
+    {
+        // each byte not starting a valid character is replaced
+        std::string str = "a\xe4\xb8" "b\xc0\xaf\xf0\x9f\x98\x80\xff";
+        APSARA_TEST_TRUE(ReplaceInvalidUtf8(const_cast<char*>(str.data()), str.size()));
+        APSARA_TEST_EQUAL("a  b  \xf0\x9f\x98\x80 ", str);
+    }
+    {
+        // start from the first invalid offset
+        std::string str = std::string(100, 'a') + "\x80" + std::string(100, 'b');
+        size_t pos = FindFirstInvalidUtf8(str.data(), str.size());
+        APSARA_TEST_EQUAL(100U, pos);
+        APSARA_TEST_TRUE(ReplaceInvalidUtf8(const_cast<char*>(str.data()), str.size(), pos));
+        APSARA_TEST_EQUAL(std::string(100, 'a') + " " + std::string(100, 'b'), str);
+    }
+}
+
+void Utf8UtilUnittest::TestAlignTail() {
+    const std::string str = "为可观测场景而生";
+    APSARA_TEST_EQUAL(str.size(), AlignUtf8Tail(str.data(), str.size()));
+    APSARA_TEST_EQUAL(str.size() - 3, AlignUtf8Tail(str.data(), str.size() - 1));
+    APSARA_TEST_EQUAL(str.size() - 3, AlignUtf8Tail(str.data(), str.size() - 2));
+    APSARA_TEST_EQUAL(str.size() - 3, AlignUtf8Tail(str.data(), str.size() - 3));
+    const std::string emoji = "a\xf0\x9f\x98\x80";
+    APSARA_TEST_EQUAL(1U, AlignUtf8Tail(emoji.data(), 4));
+    APSARA_TEST_EQUAL(5U, AlignUtf8Tail(emoji.data(), 5));
+    // invalid bytes are not aligned
+    const std::string invalid = "a\x80\x80\x80\x80";
+    APSARA_TEST_EQUAL(invalid.size(), AlignUtf8Tail(invalid.data(), invalid.size()));
+    APSARA_TEST_EQUAL(0U, AlignUtf8Tail(str.data(), 0));
+}
+
+UNIT_TEST_CASE(Utf8UtilUnittest, TestFindFirstInvalid)
+UNIT_TEST_CASE(Utf8UtilUnittest, TestSimdConsistency)
+UNIT_TEST_CASE(Utf8UtilUnittest, TestReplaceInvalid)
+UNIT_TEST_CASE(Utf8UtilUnittest, TestAlignTail)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,132 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "ebpf/handler/ObserveHandler.h"
+#include "logger/Logger.h"
+
+using namespace logtail;
+using namespace logtail::ebpf;
+
+// Converts synthetic measures and spans of one service with the observe handlers, and measures the cost of converting
+// one measure or span. Inputs are built before timing.
+// Usage: ebpf_observe_handler_benchmark [measures per batch] [batches]
+
+static std::map<std::string, std::string> MakeTags(uint32_t i) {
+    return {
+        {"workloadName", "apm-http-client"},
+        {"workloadKind", "deployment"},
+        {"namespace", "default"},
+        {"source_ip", "172.16.0.207"},
+        {"host", "172.16.0.207"},
+        {"rpc", "/shoes/" + std::to_string(i % 10)},
+        {"rpcType", "25"},
+        {"callType", "http_client"},
+        {"version", "HTTP1.1"},
+        {"source", "ebpf"},
+        {"endpoint", "/shoes/" + std::to_string(i % 10)},
+    };
+}
+
+template <typename Handler>
+static void BM_ConvertMeasures(const std::string& name, uint32_t measureCount, uint32_t batchCount) {
+    std::vector<std::vector<std::unique_ptr<ApplicationBatchMeasure>>> batches(batchCount);
+    for (auto& batch : batches) {
+        auto appMeasures = std::make_unique<ApplicationBatchMeasure>();
+        appMeasures->app_id_ = "16466f6d0782d6ae16d7ac1ccb673ca7";
+        appMeasures->ip_ = "172.16.0.207";
+        for (uint32_t i = 0; i < measureCount; ++i) {
+            auto measure = std::make_unique<Measure>();
+            measure->type_ = MEASURE_TYPE_APP;
+            measure->tags_ = MakeTags(i);
+            auto inner = std::make_unique<AppSingleMeasure>();
+            inner->request_total_ = i + 1;
+            inner->slow_total_ = 1;
+            inner->error_total_ = 1;
+            inner->duration_ms_sum_ = 100;
+            inner->status_2xx_count_ = i + 1;
+            measure->inner_measure_ = std::move(inner);
+            appMeasures->measures_.emplace_back(std::move(measure));
+        }
+        batch.emplace_back(std::move(appMeasures));
+    }
+
+    Handler handler(nullptr, -1, 0);
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (auto& batch : batches) {
+        handler.handle(std::move(batch), 1000);
+    }
+    uint64_t cost = GetCurrentTimeInMicroSeconds() - startTime;
+    std::cout << name << "\tper batch: " << measureCount << "\tbatches: " << batchCount
+              << "\tcost: " << cost * 1000.0 / measureCount / batchCount << " ns/measure" << std::endl;
+}
+
+static void BM_ConvertSpans(uint32_t spanCount, uint32_t batchCount) {
+    std::vector<std::vector<std::unique_ptr<ApplicationBatchSpan>>> batches(batchCount);
+    for (auto& batch : batches) {
+        auto appSpans = std::make_unique<ApplicationBatchSpan>();
+        appSpans->app_id_ = "a6rx69e8me@582846f37273cf8";
+        for (uint32_t i = 0; i < spanCount; ++i) {
+            auto span = std::make_unique<SingleSpan>();
+            span->tags_ = MakeTags(i);
+            span->span_name_ = "/shoes/" + std::to_string(i % 10);
+            span->span_kind_ = SpanKindInner::Client;
+            span->trace_id_ = "23u927398719379" + std::to_string(i);
+            span->span_id_ = "2121382973984" + std::to_string(i);
+            span->start_timestamp_ = 1000;
+            span->end_timestamp_ = 2000;
+            appSpans->single_spans_.emplace_back(std::move(span));
+        }
+        batch.emplace_back(std::move(appSpans));
+    }
+
+    OtelSpanHandler handler(nullptr, -1, 0);
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (auto& batch : batches) {
+        handler.handle(std::move(batch));
+    }
+    uint64_t cost = GetCurrentTimeInMicroSeconds() - startTime;
+    std::cout << "spans\tper batch: " << spanCount << "\tbatches: " << batchCount
+              << "\tcost: " << cost * 1000.0 / spanCount / batchCount << " ns/span" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    if (argc > 2) {
+        BM_ConvertMeasures<OtelMeterHandler>("otel measures", atoi(argv[1]), atoi(argv[2]));
+#ifdef __ENTERPRISE__
+        BM_ConvertMeasures<ArmsMeterHandler>("arms measures", atoi(argv[1]), atoi(argv[2]));
+#endif
+        BM_ConvertSpans(atoi(argv[1]), atoi(argv[2]));
+        return 0;
+    }
+    for (uint32_t count : {10, 1000}) {
+        BM_ConvertMeasures<OtelMeterHandler>("otel measures", count, 200000 / count);
+#ifdef __ENTERPRISE__
+        BM_ConvertMeasures<ArmsMeterHandler>("arms measures", count, 200000 / count);
+#endif
+        BM_ConvertSpans(count, 200000 / count);
+    }
+    return 0;
+}
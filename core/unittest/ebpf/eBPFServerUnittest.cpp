@@ -14,6 +14,8 @@
 #include "ebpf/config.h"
 #include "app_config/AppConfig.h"
 #include "common/JsonUtil.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+#include "pipeline/queue/QueueKeyManager.h"
 #include "ebpf/config.h"
 
 namespace logtail {
@@ -46,6 +48,8 @@ public:
 
     void TestInitAndStop();
 
+    void TestSecurityAggregation();
+
 protected:
     void SetUp() override {
         config_ = new eBPFAdminConfig;
@@ -811,6 +815,150 @@ void eBPFServerUnittest::TestInitAndStop() {
     EXPECT_EQ(false, ret);
 }
 
+void eBPFServerUnittest::TestSecurityAggregation() {
+    auto generate = [](const std::string& binary, uint64_t ts) {
+        std::vector<std::pair<std::string, std::string>> tags;
+        tags.push_back({"call_name", "sys_enter_execve"});
+        tags.push_back({"binary", binary});
+        tags.push_back({"arguments", "-c date"});
+        tags.push_back({"container.id", "c1"});
+        tags.push_back({"k8s.pod.name", "pod-1"});
+        tags.push_back({"pid", std::to_string(ts)});
+        return std::make_unique<AbstractSecurityEvent>(
+            std::move(tags), SecureEventType::SECURE_EVENT_TYPE_PROCESS_SECURE, ts);
+    };
+
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_security_aggregation");
+    ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(key, 0);
+    auto popGroups = []() {
+        std::vector<PipelineEventGroup> groups;
+        std::unique_ptr<ProcessQueueItem> item;
+        std::string configName;
+        while (ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+            groups.emplace_back(std::move(item->mEventGroup));
+        }
+        return groups;
+    };
+
+    // disabled, every event is pushed at once
+    SecurityHandler handler(nullptr, key, 0, SecurityAggregationConfig{0, 16, 16});
+    std::vector<std::unique_ptr<AbstractSecurityEvent>> events;
+    for (int i = 0; i < 10; ++i) {
+        events.emplace_back(generate("/bin/sh", 1000 + i));
+    }
+    handler.handle(std::move(events));
+    auto groups = popGroups();
+    APSARA_TEST_EQUAL(1U, groups.size());
+    APSARA_TEST_EQUAL(10U, groups[0].GetEvents().size());
+
+    // merged within the window
+    SecurityHandler aggHandler(nullptr, key, 0, SecurityAggregationConfig{60000, 16, 16});
+    events.clear();
+    for (int i = 0; i < 1000; ++i) {
+        events.emplace_back(generate(i % 2 ? "/bin/sh" : "/bin/bash", 1000 + i));
+    }
+    aggHandler.handle(std::move(events));
+    APSARA_TEST_EQUAL(1000U, aggHandler.mProcessTotalCnt);
+    APSARA_TEST_TRUE(popGroups().empty());
+    aggHandler.Flush();
+    APSARA_TEST_TRUE(popGroups().empty());
+
+    // expired window is flushed by the next callback
+    aggHandler.mWindowStartMs = 0;
+    events.clear();
+    events.emplace_back(generate("/bin/sh", 5000));
+    aggHandler.handle(std::move(events));
+    groups = popGroups();
+    APSARA_TEST_EQUAL(1U, groups.size());
+    auto& group = groups[0];
+    APSARA_TEST_EQUAL(2U, group.GetEvents().size());
+    const auto& bash = group.GetEvents()[0].Cast<LogEvent>();
+    APSARA_TEST_EQUAL("/bin/bash", bash.GetContent("binary").to_string());
+    APSARA_TEST_EQUAL("500", bash.GetContent("event_count").to_string());
+    APSARA_TEST_EQUAL("1998", bash.GetContent("last_time").to_string());
+    const auto& sh = group.GetEvents()[1].Cast<LogEvent>();
+    APSARA_TEST_EQUAL("501", sh.GetContent("event_count").to_string());
+    APSARA_TEST_EQUAL("5000", sh.GetContent("last_time").to_string());
+    APSARA_TEST_EQUAL("1001", sh.GetContent("pid").to_string());
+    // container metadata shares one copy in the group
+    APSARA_TEST_EQUAL(bash.GetContent("k8s.pod.name").data(), sh.GetContent("k8s.pod.name").data());
+
+    // expired window is flushed by the timer without any callback
+    events.clear();
+    events.emplace_back(generate("/bin/sh", 6000));
+    aggHandler.handle(std::move(events));
+    APSARA_TEST_TRUE(popGroups().empty());
+    aggHandler.mWindowStartMs = 0;
+    aggHandler.Flush();
+    groups = popGroups();
+    APSARA_TEST_EQUAL(1U, groups.size());
+    APSARA_TEST_EQUAL(1U, groups[0].GetEvents().size());
+
+    // merged events are pushed at once on teardown
+    events.clear();
+    events.emplace_back(generate("/bin/sh", 7000));
+    aggHandler.handle(std::move(events));
+    aggHandler.Flush(true);
+    APSARA_TEST_EQUAL(1U, popGroups().size());
+
+    // too many keys are flushed before the window expires
+    SecurityHandler smallHandler(nullptr, key, 0, SecurityAggregationConfig{60000, 4, 16});
+    events.clear();
+    for (int i = 0; i < 8; ++i) {
+        events.emplace_back(generate("/bin/" + std::to_string(i), 1000 + i));
+    }
+    smallHandler.handle(std::move(events));
+    groups = popGroups();
+    APSARA_TEST_EQUAL(1U, groups.size());
+    APSARA_TEST_EQUAL(8U, groups[0].GetEvents().size());
+
+    // groups refused by the full queue are kept, and pushed again by the timer
+    size_t pushed = 0;
+    while (ProcessQueueManager::GetInstance()->IsValidToPush(key)) {
+        events.clear();
+        events.emplace_back(generate("/bin/sh", 8000));
+        handler.handle(std::move(events));
+        ++pushed;
+    }
+    events.clear();
+    events.emplace_back(generate("/bin/sh", 9000));
+    handler.handle(std::move(events));
+    APSARA_TEST_EQUAL(1U, handler.mPendingItems.size());
+    APSARA_TEST_EQUAL(pushed, popGroups().size());
+    handler.Flush();
+    APSARA_TEST_TRUE(handler.mPendingItems.empty());
+    groups = popGroups();
+    APSARA_TEST_EQUAL(1U, groups.size());
+    APSARA_TEST_EQUAL("9000", groups[0].GetEvents()[0].Cast<LogEvent>().GetContent("pid").to_string());
+
+    // groups of the old context are never pushed after the context is reset
+    while (ProcessQueueManager::GetInstance()->IsValidToPush(key)) {
+        events.clear();
+        events.emplace_back(generate("/bin/sh", 8000));
+        handler.handle(std::move(events));
+    }
+    events.clear();
+    events.emplace_back(generate("/bin/sh", 10000));
+    handler.handle(std::move(events));
+    APSARA_TEST_EQUAL(1U, handler.mPendingItems.size());
+    uint64_t dropCnt = handler.mDropEventCnt;
+    handler.UpdateContext(nullptr, -1, -1);
+    APSARA_TEST_TRUE(handler.mPendingItems.empty());
+    APSARA_TEST_EQUAL(dropCnt + 1, handler.mDropEventCnt);
+    popGroups();
+    handler.Flush();
+    APSARA_TEST_TRUE(popGroups().empty());
+
+    // merged events are pushed to the old queue before the context is switched
+    events.clear();
+    events.emplace_back(generate("/bin/sh", 11000));
+    aggHandler.handle(std::move(events));
+    aggHandler.UpdateContext(nullptr, -1, -1);
+    APSARA_TEST_EQUAL(1U, popGroups().size());
+
+    ProcessQueueManager::GetInstance()->DeleteQueue(key);
+}
+
 UNIT_TEST_CASE(eBPFServerUnittest, TestDefaultEbpfParameters);
 UNIT_TEST_CASE(eBPFServerUnittest, TestDefaultAndLoadEbpfParameters);
 UNIT_TEST_CASE(eBPFServerUnittest, TestLoadEbpfParametersV1);
@@ -821,6 +969,7 @@ UNIT_TEST_CASE(eBPFServerUnittest, TestEnableProcessPlugin)
 UNIT_TEST_CASE(eBPFServerUnittest, TestEnableNetworkSecurePlugin)
 UNIT_TEST_CASE(eBPFServerUnittest, TestEnableFileSecurePlugin)
 UNIT_TEST_CASE(eBPFServerUnittest, TestInitAndStop)
+UNIT_TEST_CASE(eBPFServerUnittest, TestSecurityAggregation)
 }
 }
 
@@ -35,9 +35,44 @@ public:
         Event event1("/source", "object", EVENT_CONTAINER_STOPPED, 0);
         APSARA_TEST_TRUE_FATAL(event1.IsContainerStopped());
     }
+
+    void TestSharedSource() {
+        auto path = make_shared<const string>("/source");
+        Event event0(path, "object", EVENT_MODIFY, 1, 2);
+        APSARA_TEST_EQUAL("/source", event0.GetSource());
+        APSARA_TEST_EQUAL("object", event0.GetObject());
+        APSARA_TEST_EQUAL(path.get(), &event0.GetSource());
+        APSARA_TEST_TRUE(event0.IsModify());
+        APSARA_TEST_EQUAL(1, event0.GetWd());
+        APSARA_TEST_EQUAL(2U, event0.GetCookie());
+
+        // copied event shares source until it is set
+        Event event1(event0);
+        APSARA_TEST_EQUAL(&event0.GetSource(), &event1.GetSource());
+        event1.SetSource("/other");
+        APSARA_TEST_EQUAL("/other", event1.GetSource());
+        APSARA_TEST_EQUAL("/source", event0.GetSource());
+        APSARA_TEST_EQUAL("/source", *path);
+    }
+
+    void TestPooledAllocation() {
+        Event* event0 = new Event("/source", "object", EVENT_MODIFY, 0);
+        delete event0;
+        // freed event is reused
+        Event* event1 = new Event("/source1", "object1", EVENT_CREATE, 0);
+        APSARA_TEST_EQUAL(static_cast<void*>(event0), static_cast<void*>(event1));
+        APSARA_TEST_EQUAL("/source1", event1->GetSource());
+        APSARA_TEST_TRUE(event1->IsCreate());
+        delete event1;
+
+        unique_ptr<Event> event2(new Event("/source2", "object2", EVENT_DELETE, 0));
+        APSARA_TEST_TRUE(event2->IsDeleted());
+    }
 };
 
 APSARA_UNIT_TEST_CASE(EventUnittest, TestIsContainerStopped, 0);
+APSARA_UNIT_TEST_CASE(EventUnittest, TestSharedSource, 0);
+APSARA_UNIT_TEST_CASE(EventUnittest, TestPooledAllocation, 0);
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
@@ -32,6 +32,7 @@ public:
     void OnSuccessfulInit() const;
     void OnFailedInit() const;
     void TestFilePaths() const;
+    void TestContainerPathMatch() const;
 
 private:
     const string pluginType = "test";
@@ -282,9 +283,90 @@ void FileDiscoveryOptionsUnittest::TestFilePaths() const {
     APSARA_TEST_EQUAL("*.log", config->GetFilePattern());
 }
 
+static bool keepContainerBaseDir(ContainerInfo&, const PipelineContext*, const FileDiscoveryOptions*) {
+    return true;
+}
+
+void FileDiscoveryOptionsUnittest::TestContainerPathMatch() const {
+    unique_ptr<FileDiscoveryOptions> config;
+    Json::Value configJson, containerJson;
+    PipelineContext ctx;
+    filesystem::path filePath = filesystem::absolute("*.log");
+    const string c1 = (filesystem::path("/") / "host" / "c1").string();
+    const string c2 = (filesystem::path("/") / "host" / "c2").string();
+    const string c3 = (filesystem::path("/") / "host" / "c3").string();
+
+    configJson["FilePaths"].append(Json::Value(filePath.string()));
+    config.reset(new FileDiscoveryOptions());
+    APSARA_TEST_TRUE(config->Init(configJson, ctx, pluginType));
+    config->SetEnableContainerDiscoveryFlag(true);
+    config->SetDeduceAndSetContainerBaseDirFunc(keepContainerBaseDir);
+    config->SetContainerInfo(make_shared<vector<ContainerInfo>>());
+
+    // add
+    for (const auto& item : vector<pair<string, string>>{{"1", c1}, {"2", c2}, {"3", c3}}) {
+        containerJson["ID"] = Json::Value(item.first);
+        containerJson["Path"] = Json::Value(item.second);
+        APSARA_TEST_TRUE(config->UpdateContainerInfo(containerJson, &ctx));
+    }
+    APSARA_TEST_EQUAL(3U, config->mContainerPathIndex.Size());
+    APSARA_TEST_TRUE(config->IsMatch(c1, "a.log"));
+    APSARA_TEST_TRUE(config->IsMatch(c3, "a.log"));
+    APSARA_TEST_FALSE(config->IsMatch(c1 + "0", "a.log"));
+    APSARA_TEST_FALSE(config->IsMatch(c1, "a.txt"));
+    APSARA_TEST_EQUAL("2", config->GetContainerPathByLogPath((filesystem::path(c2) / "sub").string())->mID);
+    APSARA_TEST_EQUAL(nullptr, config->GetContainerPathByLogPath(c1 + "0"));
+
+    // update
+    containerJson["ID"] = Json::Value("2");
+    containerJson["Path"] = Json::Value(c2 + "0");
+    APSARA_TEST_TRUE(config->UpdateContainerInfo(containerJson, &ctx));
+    APSARA_TEST_FALSE(config->IsMatch(c2, "a.log"));
+    APSARA_TEST_TRUE(config->IsMatch(c2 + "0", "a.log"));
+
+    // delete, containers after the deleted one are still found
+    containerJson.clear();
+    containerJson["ID"] = Json::Value("1");
+    APSARA_TEST_TRUE(config->DeleteContainerInfo(containerJson));
+    APSARA_TEST_EQUAL(2U, config->mContainerPathIndex.Size());
+    APSARA_TEST_FALSE(config->IsMatch(c1, "a.log"));
+    APSARA_TEST_EQUAL("2", config->GetContainerPathByLogPath(c2 + "0")->mID);
+    APSARA_TEST_EQUAL("3", config->GetContainerPathByLogPath(c3)->mID);
+
+    // replace all, the number of containers is unchanged
+    containerJson.clear();
+    for (const auto& item : vector<pair<string, string>>{{"2", c2 + "0"}, {"5", c1}}) {
+        Json::Value container;
+        container["ID"] = Json::Value(item.first);
+        container["Path"] = Json::Value(item.second);
+        containerJson["AllCmd"].append(container);
+    }
+    APSARA_TEST_TRUE(config->UpdateContainerInfo(containerJson, &ctx));
+    APSARA_TEST_EQUAL(2U, config->mContainerPathIndex.Size());
+    APSARA_TEST_EQUAL(nullptr, config->GetContainerPathByLogPath(c3));
+    APSARA_TEST_EQUAL("5", config->GetContainerPathByLogPath(c1)->mID);
+    APSARA_TEST_EQUAL("2", config->GetContainerPathByLogPath(c2 + "0")->mID);
+
+    // containers sharing a root, the first one wins until it is deleted
+    containerJson.clear();
+    containerJson["ID"] = Json::Value("6");
+    containerJson["Path"] = Json::Value(c1);
+    APSARA_TEST_TRUE(config->UpdateContainerInfo(containerJson, &ctx));
+    APSARA_TEST_EQUAL(3U, config->mContainerPathIndex.Size());
+    APSARA_TEST_EQUAL("5", config->GetContainerPathByLogPath(c1)->mID);
+    containerJson.clear();
+    containerJson["ID"] = Json::Value("5");
+    APSARA_TEST_TRUE(config->DeleteContainerInfo(containerJson));
+    APSARA_TEST_EQUAL(2U, config->mContainerPathIndex.Size());
+    APSARA_TEST_EQUAL(2U, config->mContainerPositions.size());
+    APSARA_TEST_EQUAL("6", config->GetContainerPathByLogPath((filesystem::path(c1) / "sub").string())->mID);
+    APSARA_TEST_EQUAL("2", config->GetContainerPathByLogPath(c2 + "0")->mID);
+}
+
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, OnFailedInit)
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, TestFilePaths)
+UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, TestContainerPathMatch)
 
 } // namespace logtail
 
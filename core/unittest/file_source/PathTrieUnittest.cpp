@@ -0,0 +1,93 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "file_server/PathTrie.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class PathTrieUnittest : public testing::Test {
+public:
+    void TestForEachPrefix();
+    void TestErase();
+
+private:
+    vector<int> find(const PathTrie<int>& trie, const string& path) {
+        vector<int> res;
+        trie.ForEachPrefix(path, [&res](int v) { res.push_back(v); });
+        return res;
+    }
+
+    static string p(const vector<string>& components) {
+        string res;
+        for (const auto& c : components) {
+            res += PATH_SEPARATOR + c;
+        }
+        return res.empty() ? PATH_SEPARATOR : res;
+    }
+};
+
+void PathTrieUnittest::TestForEachPrefix() {
+    PathTrie<int> trie;
+    trie.Insert(p({}), 0);
+    trie.Insert(p({"var", "log"}), 1);
+    trie.Insert(p({"var", "log", "app"}), 2);
+    trie.Insert(p({"var", "log"}), 3);
+    trie.Insert(p({"var", "lib"}), 4);
+    APSARA_TEST_EQUAL(5U, trie.Size());
+
+    APSARA_TEST_EQUAL(vector<int>({0}), find(trie, p({"var"})));
+    APSARA_TEST_EQUAL(vector<int>({0, 1, 3}), find(trie, p({"var", "log"})));
+    APSARA_TEST_EQUAL(vector<int>({0, 1, 3, 2}), find(trie, p({"var", "log", "app", "a"})));
+    // component must be matched as a whole
+    APSARA_TEST_EQUAL(vector<int>({0}), find(trie, p({"var", "logs"})));
+    APSARA_TEST_EQUAL(vector<int>({0}), find(trie, p({"var", "lo"})));
+    // redundant separators are ignored
+    APSARA_TEST_EQUAL(vector<int>({0, 4}), find(trie, p({"var", "lib"}) + PATH_SEPARATOR + PATH_SEPARATOR));
+    APSARA_TEST_EQUAL(vector<int>({0, 4}), find(trie, PATH_SEPARATOR + p({"var", "lib"})));
+}
+
+void PathTrieUnittest::TestErase() {
+    PathTrie<int> trie;
+    trie.Insert(p({"a", "b"}), 1);
+    trie.Insert(p({"a", "b", "c"}), 2);
+    trie.Insert(p({"a", "b", "c"}), 3);
+    APSARA_TEST_FALSE(trie.Erase(p({"a", "b", "c"}), 1));
+    APSARA_TEST_FALSE(trie.Erase(p({"a", "x"}), 1));
+    APSARA_TEST_TRUE(trie.Erase(p({"a", "b", "c"}), 2));
+    APSARA_TEST_EQUAL(vector<int>({1, 3}), find(trie, p({"a", "b", "c"})));
+    APSARA_TEST_TRUE(trie.Erase(p({"a", "b"}), 1));
+    APSARA_TEST_EQUAL(vector<int>({3}), find(trie, p({"a", "b", "c"})));
+    APSARA_TEST_TRUE(trie.Erase(p({"a", "b", "c"}), 3));
+    APSARA_TEST_EQUAL(0U, trie.Size());
+    // empty nodes are pruned
+    APSARA_TEST_TRUE(trie.mRoot.mChildren.empty());
+
+    trie.Insert(p({"a"}), 1);
+    trie.Clear();
+    APSARA_TEST_EQUAL(0U, trie.Size());
+    APSARA_TEST_TRUE(find(trie, p({"a"})).empty());
+}
+
+UNIT_TEST_CASE(PathTrieUnittest, TestForEachPrefix)
+UNIT_TEST_CASE(PathTrieUnittest, TestErase)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
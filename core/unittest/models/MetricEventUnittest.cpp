@@ -103,6 +103,13 @@ void MetricEventUnittest::TestTag() {
         APSARA_TEST_FALSE(mMetricEvent->HasTag(key));
         APSARA_TEST_EQUAL("", mMetricEvent->GetTag(key).to_string());
     }
+    {
+        mMetricEvent->SetTag(string("key0"), string("value0"));
+        mMetricEvent->SetTag(string("key3"), string("value33"));
+        APSARA_TEST_EQUAL("value33", mMetricEvent->GetTag("key3").to_string());
+        APSARA_TEST_EQUAL((size_t)4, mMetricEvent->TagsSize());
+        APSARA_TEST_EQUAL("key0", mMetricEvent->TagsBegin()->first.to_string());
+    }
 }
 
 void MetricEventUnittest::TestSize() {
@@ -27,6 +27,7 @@ public:
     void TestSetMetadata();
     void TestDelMetadata();
     void TestFromJsonToJson();
+    void TestTagsHash();
 
 protected:
     void SetUp() override {
@@ -135,11 +136,62 @@ void PipelineEventGroupUnittest::TestFromJsonToJson() {
     APSARA_TEST_STREQ_FATAL(CompactJson(inJson).c_str(), CompactJson(outJson).c_str());
 }
 
+void PipelineEventGroupUnittest::TestTagsHash() {
+    size_t emptyHash = mEventGroup->GetTagsHash();
+    APSARA_TEST_NOT_EQUAL(0U, emptyHash);
+
+    mEventGroup->SetTag(std::string("key1"), std::string("value1"));
+    mEventGroup->SetTag(std::string("key2"), std::string("value2"));
+    size_t hash = mEventGroup->GetTagsHash();
+    APSARA_TEST_NOT_EQUAL(emptyHash, hash);
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+
+    {
+        // same tags set in different order from a different buffer
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup group(sourceBuffer);
+        group.SetTag(std::string("key2"), std::string("value2"));
+        group.SetTag(std::string("key1"), std::string("value1"));
+        APSARA_TEST_EQUAL(hash, group.GetTagsHash());
+        // boundaries between keys and values matter
+        PipelineEventGroup shifted(sourceBuffer);
+        shifted.SetTag(std::string("key1v"), std::string("alue1"));
+        shifted.SetTag(std::string("key2"), std::string("value2"));
+        APSARA_TEST_NOT_EQUAL(hash, shifted.GetTagsHash());
+    }
+
+    // cached value is kept by copy and move
+    auto copy = mEventGroup->Copy();
+    APSARA_TEST_EQUAL(hash, copy.GetTagsHash());
+    PipelineEventGroup moved(std::move(copy));
+    APSARA_TEST_EQUAL(hash, moved.GetTagsHash());
+
+    // any modification invalidates the cached value
+    mEventGroup->SetTag(std::string("key1"), std::string("value3"));
+    APSARA_TEST_NOT_EQUAL(hash, mEventGroup->GetTagsHash());
+    mEventGroup->SetTag(std::string("key1"), std::string("value1"));
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+
+    mEventGroup->SetMetadata(EventGroupMetaKey::SOURCE_ID, std::string("source"));
+    size_t sourceHash = mEventGroup->GetTagsHash();
+    APSARA_TEST_NOT_EQUAL(hash, sourceHash);
+    mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FILE_PATH, std::string("/var/log/message"));
+    APSARA_TEST_EQUAL(sourceHash, mEventGroup->GetTagsHash());
+    mEventGroup->DelMetadata(EventGroupMetaKey::SOURCE_ID);
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+
+    mEventGroup->GetSizedTags().Erase("key2");
+    APSARA_TEST_NOT_EQUAL(hash, mEventGroup->GetTagsHash());
+    mEventGroup->DelTag("key1");
+    APSARA_TEST_EQUAL(emptyHash, mEventGroup->GetTagsHash());
+}
+
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSwapEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestFromJsonToJson)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestTagsHash)
 
 } // namespace logtail
 
@@ -0,0 +1,124 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "observer/network/protocols/aggregation_table.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FlatAggregationTableUnittest : public testing::Test {
+public:
+    void TestFindAndInsert();
+    void TestReset();
+    void TestShrink();
+
+private:
+    struct Item {
+        string mKey;
+        int mCount = 0;
+    };
+};
+
+void FlatAggregationTableUnittest::TestFindAndInsert() {
+    FlatAggregationTable<Item> table;
+    APSARA_TEST_EQUAL(nullptr, table.Find(1));
+    // hashes colliding in the index are probed linearly
+    for (uint64_t hash : {1, 17, 33, 2}) {
+        Item& item = table.Insert(hash);
+        item.mKey = to_string(hash);
+        ++item.mCount;
+    }
+    APSARA_TEST_EQUAL(4U, table.Size());
+    for (uint64_t hash : {1, 17, 33, 2}) {
+        Item* item = table.Find(hash);
+        APSARA_TEST_NOT_EQUAL(nullptr, item);
+        APSARA_TEST_EQUAL(to_string(hash), item->mKey);
+    }
+    APSARA_TEST_EQUAL(nullptr, table.Find(49));
+
+    // the index grows to keep at most half full
+    for (uint64_t hash = 100; hash < 1100; ++hash) {
+        table.Insert(hash * 7919).mKey = to_string(hash);
+    }
+    APSARA_TEST_EQUAL(1004U, table.Size());
+    APSARA_TEST_EQUAL(2048U, table.mIndex.size());
+    for (uint64_t hash = 100; hash < 1100; ++hash) {
+        APSARA_TEST_EQUAL(to_string(hash), table.Find(hash * 7919)->mKey);
+    }
+    APSARA_TEST_EQUAL("17", table.Find(17)->mKey);
+
+    vector<string> keys;
+    table.ForEach([&keys](Item& item) { keys.push_back(item.mKey); });
+    APSARA_TEST_EQUAL(1004U, keys.size());
+    APSARA_TEST_EQUAL("1", keys[0]);
+    APSARA_TEST_EQUAL("1099", keys.back());
+}
+
+void FlatAggregationTableUnittest::TestReset() {
+    FlatAggregationTable<Item> table;
+    table.Insert(1).mKey = "a";
+    table.Insert(2).mKey = "b";
+    table.Reset();
+    APSARA_TEST_EQUAL(0U, table.Size());
+    APSARA_TEST_EQUAL(nullptr, table.Find(1));
+    APSARA_TEST_EQUAL(nullptr, table.Find(2));
+
+    // items are reused with their old content
+    Item& item = table.Insert(2);
+    APSARA_TEST_EQUAL("a", item.mKey);
+    item.mKey = "c";
+    APSARA_TEST_EQUAL("c", table.Find(2)->mKey);
+    APSARA_TEST_EQUAL(nullptr, table.Find(1));
+
+    // generation wraps around
+    table.mGeneration = UINT32_MAX;
+    table.Reset();
+    APSARA_TEST_EQUAL(1U, table.mGeneration);
+    APSARA_TEST_EQUAL(nullptr, table.Find(2));
+}
+
+void FlatAggregationTableUnittest::TestShrink() {
+    FlatAggregationTable<Item> table;
+    for (uint64_t hash = 0; hash < 10000; ++hash) {
+        table.Insert(hash);
+    }
+    table.Reset();
+    // kept for the next interval of the same size
+    APSARA_TEST_EQUAL(10000U, table.mItems.size());
+    APSARA_TEST_EQUAL(32768U, table.mIndex.size());
+
+    for (uint64_t hash = 0; hash < 100; ++hash) {
+        table.Insert(hash);
+    }
+    table.Reset();
+    APSARA_TEST_EQUAL(200U, table.mItems.size());
+    APSARA_TEST_EQUAL(256U, table.mIndex.size());
+    for (uint64_t hash = 0; hash < 1000; ++hash) {
+        table.Insert(hash);
+    }
+    APSARA_TEST_EQUAL(1000U, table.Size());
+    APSARA_TEST_NOT_EQUAL(nullptr, table.Find(999));
+}
+
+UNIT_TEST_CASE(FlatAggregationTableUnittest, TestFindAndInsert)
+UNIT_TEST_CASE(FlatAggregationTableUnittest, TestReset)
+UNIT_TEST_CASE(FlatAggregationTableUnittest, TestShrink)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
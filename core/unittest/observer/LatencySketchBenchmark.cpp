@@ -0,0 +1,87 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+
+#include "common/TimeUtil.h"
+#include "observer/network/protocols/sketch.h"
+
+using namespace logtail;
+
+// Measures the cost of adding latencies to the sketch and merging sketches, and the relative error of quantiles
+// compared to the exact ones.
+// Usage: latency_sketch_benchmark [value count]
+static void BM_LatencySketch(const std::string& name, const std::function<int64_t()>& gen, size_t count) {
+    std::vector<int64_t> values(count);
+    for (auto& v : values) {
+        v = gen();
+    }
+
+    LatencySketch sketch;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (auto v : values) {
+        sketch.Add(v);
+    }
+    uint64_t addTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    // merge as the aggregator does, 100 keys into one
+    std::vector<LatencySketch> parts(100);
+    for (size_t i = 0; i < values.size(); ++i) {
+        parts[i % parts.size()].Add(values[i]);
+    }
+    LatencySketch merged;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (const auto& part : parts) {
+        merged.Merge(part);
+    }
+    uint64_t mergeTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    std::sort(values.begin(), values.end());
+    std::cout << name << "\tadd: " << addTime * 1000.0 / count << " ns/value"
+              << "\tmerge: " << mergeTime / static_cast<double>(parts.size()) << " us/sketch"
+              << "\tserialized: " << sketch.Serialize().size() << " bytes" << std::endl;
+    for (double q : {0.5, 0.9, 0.99, 0.999}) {
+        double expected = values[static_cast<size_t>(q * (values.size() - 1))];
+        double error = expected == 0 ? 0 : std::abs(sketch.Quantile(q) - expected) / expected;
+        double mergedError = expected == 0 ? 0 : std::abs(merged.Quantile(q) - expected) / expected;
+        std::cout << "\tp" << q * 100 << "\texact: " << static_cast<int64_t>(expected) << "\terror: " << error
+                  << "\tmerged error: " << mergedError << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    size_t count = argc > 1 ? atoi(argv[1]) : 1000000;
+    std::mt19937_64 rng(0);
+    // about 0.4ms median with a long tail
+    std::lognormal_distribution<double> lognormal(13.0, 1.5);
+    BM_LatencySketch("lognormal", [&]() { return static_cast<int64_t>(lognormal(rng)); }, count);
+    // most requests hit the cache, the rest go to disk
+    std::uniform_int_distribution<int64_t> cacheHit(50000, 150000), diskRead(5000000, 50000000);
+    std::uniform_int_distribution<int> ratio(0, 99);
+    BM_LatencySketch(
+        "bimodal", [&]() { return ratio(rng) < 95 ? cacheHit(rng) : diskRead(rng); }, count);
+    std::exponential_distribution<double> exponential(1.0 / 2000000);
+    BM_LatencySketch("exponential", [&]() { return static_cast<int64_t>(exponential(rng)); }, count);
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <random>
+
+#include "observer/network/protocols/sketch.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class LatencySketchUnittest : public testing::Test {
+public:
+    void TestQuantile();
+    void TestMerge();
+    void TestBoundedBuckets();
+    void TestSerialize();
+
+private:
+    // CheckQuantiles checks the quantiles of @sketch against the exact ones of @values, low quantiles are skipped
+    // because the lowest buckets may be collapsed
+    void CheckQuantiles(const LatencySketch& sketch, vector<int64_t> values) {
+        sort(values.begin(), values.end());
+        for (double q : {0.5, 0.9, 0.99, 1.0}) {
+            int64_t expected = values[static_cast<size_t>(q * (values.size() - 1))];
+            int64_t actual = sketch.Quantile(q);
+            APSARA_TEST_TRUE_DESC(abs(actual - expected) <= expected * LatencySketch::kRelativeAccuracy + 1,
+                                  to_string(q) + " " + to_string(expected) + " " + to_string(actual));
+        }
+    }
+};
+
+void LatencySketchUnittest::TestQuantile() {
+    LatencySketch sketch;
+    APSARA_TEST_TRUE(sketch.IsEmpty());
+    APSARA_TEST_EQUAL(0, sketch.Quantile(0.99));
+
+    mt19937_64 rng(0);
+    lognormal_distribution<double> dist(13.0, 1.5);
+    vector<int64_t> values;
+    for (size_t i = 0; i < 100000; ++i) {
+        values.push_back(static_cast<int64_t>(dist(rng)) + 1);
+        sketch.Add(values.back());
+    }
+    APSARA_TEST_EQUAL(values.size(), sketch.GetCount());
+    CheckQuantiles(sketch, values);
+
+    // non-positive values
+    LatencySketch zeroSketch;
+    zeroSketch.Add(0);
+    zeroSketch.Add(-1);
+    zeroSketch.Add(1000);
+    APSARA_TEST_EQUAL(0, zeroSketch.Quantile(0.5));
+    APSARA_TEST_TRUE(abs(zeroSketch.Quantile(1) - 1000) <= 20);
+
+    zeroSketch.Clear();
+    APSARA_TEST_TRUE(zeroSketch.IsEmpty());
+    APSARA_TEST_TRUE(zeroSketch.mBuckets.empty());
+}
+
+void LatencySketchUnittest::TestMerge() {
+    mt19937_64 rng(1);
+    uniform_int_distribution<int64_t> fast(100000, 200000), slow(50000000, 80000000);
+    LatencySketch fastSketch, slowSketch, emptySketch;
+    vector<int64_t> values;
+    for (size_t i = 0; i < 10000; ++i) {
+        values.push_back(fast(rng));
+        fastSketch.Add(values.back());
+    }
+    for (size_t i = 0; i < 500; ++i) {
+        values.push_back(slow(rng));
+        slowSketch.Add(values.back());
+    }
+    // merged in both orders
+    LatencySketch merged;
+    merged.Merge(slowSketch);
+    merged.Merge(emptySketch);
+    merged.Merge(fastSketch);
+    CheckQuantiles(merged, values);
+    fastSketch.Merge(slowSketch);
+    CheckQuantiles(fastSketch, values);
+    APSARA_TEST_EQUAL(merged.Serialize(), fastSketch.Serialize());
+}
+
+void LatencySketchUnittest::TestBoundedBuckets() {
+    // from 1ns to about 1000s
+    LatencySketch sketch;
+    vector<int64_t> values;
+    for (int64_t v = 1; v < 1000000000000; v = v * 11 / 10 + 1) {
+        values.push_back(v);
+        sketch.Add(v);
+    }
+    APSARA_TEST_EQUAL(LatencySketch::kMaxBucketCount, sketch.mBuckets.size());
+    // high quantiles are kept accurate
+    sort(values.begin(), values.end());
+    int64_t p99 = values[static_cast<size_t>(0.99 * (values.size() - 1))];
+    APSARA_TEST_TRUE(abs(sketch.Quantile(0.99) - p99) <= p99 * LatencySketch::kRelativeAccuracy);
+
+    // values lower than the lowest bucket are counted in it
+    LatencySketch highSketch;
+    highSketch.Add(1000000000000);
+    highSketch.Add(1);
+    APSARA_TEST_EQUAL(LatencySketch::kMaxBucketCount, highSketch.mBuckets.size());
+    APSARA_TEST_EQUAL(1U, highSketch.mBuckets[0]);
+    highSketch.Merge(sketch);
+    APSARA_TEST_EQUAL(LatencySketch::kMaxBucketCount, highSketch.mBuckets.size());
+    APSARA_TEST_EQUAL(values.size() + 2, highSketch.GetCount());
+}
+
+void LatencySketchUnittest::TestSerialize() {
+    LatencySketch sketch;
+    APSARA_TEST_EQUAL("0.02;0;0;", sketch.Serialize());
+    sketch.Add(0);
+    sketch.Add(1000);
+    sketch.Add(1000);
+    sketch.Add(1090);
+    // ceil(ln(1000) / ln(1.02 / 0.98)) = 173
+    APSARA_TEST_EQUAL("0.02;1;173;2,,1", sketch.Serialize());
+}
+
+UNIT_TEST_CASE(LatencySketchUnittest, TestQuantile)
+UNIT_TEST_CASE(LatencySketchUnittest, TestMerge)
+UNIT_TEST_CASE(LatencySketchUnittest, TestBoundedBuckets)
+UNIT_TEST_CASE(LatencySketchUnittest, TestSerialize)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
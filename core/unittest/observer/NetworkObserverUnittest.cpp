@@ -238,6 +238,45 @@ public:
         inferMySQL();
     }
 
+    void TestAggregatorOverflow() {
+        DNSProtocolEventAggregator dnsAgg(1, 2);
+        auto addEvent = [&](const std::string& resource, PacketRoleType role) {
+            DNSProtocolEvent dnsEvent;
+            dnsEvent.Info.LatencyNs = 300;
+            dnsEvent.Key.ReqResource = resource;
+            dnsEvent.Key.ConnKey.Role = role;
+            // the role is part of the connection hash, as done with packet headers
+            dnsEvent.Key.ConnKey.HashVal = static_cast<uint64_t>(role);
+            return dnsAgg.AddEvent(std::move(dnsEvent));
+        };
+        for (const auto& resource : {"a", "b", "a", "c", "d"}) {
+            APSARA_TEST_TRUE(addEvent(resource, PacketRoleType::Server));
+        }
+        APSARA_TEST_TRUE(addEvent("a", PacketRoleType::Client));
+        APSARA_TEST_FALSE(addEvent("a", PacketRoleType::Unknown));
+
+        google::protobuf::RepeatedPtrField<sls_logs::Log_Content> globalTags;
+        std::vector<sls_logs::Log> allData;
+        dnsAgg.FlushLogs(allData, "", globalTags, 1);
+        APSARA_TEST_EQUAL_FATAL(allData.size(), size_t(4));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[0], "req_resource", "a"));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[0], "count", "2"));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[1], "req_resource", "b"));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[2], "role", "c"));
+        // events of new keys beyond the limit are aggregated without keys
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[3], "req_resource", ""));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[3], "role", "s"));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[3], "count", "2"));
+
+        // keys are reset after flush
+        allData.clear();
+        APSARA_TEST_TRUE(addEvent("d", PacketRoleType::Server));
+        dnsAgg.FlushLogs(allData, "", globalTags, 1);
+        APSARA_TEST_EQUAL_FATAL(allData.size(), size_t(1));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[0], "req_resource", "d"));
+        APSARA_TEST_TRUE(UnitTestHelper::LogKeyMatched(&allData[0], "count", "1"));
+    }
+
     NetworkObserver* mObserver = NetworkObserver::GetInstance();
 };
 
@@ -248,6 +287,7 @@ APSARA_UNIT_TEST_CASE(NetworkObserverUnittest, TestToPB, 0);
 APSARA_UNIT_TEST_CASE(NetworkObserverUnittest, TestRawPacketUDPReader, 0);
 APSARA_UNIT_TEST_CASE(NetworkObserverUnittest, TestRawPacketTCPReader, 0);
 APSARA_UNIT_TEST_CASE(NetworkObserverUnittest, TestInferProtocol, 0);
+APSARA_UNIT_TEST_CASE(NetworkObserverUnittest, TestAggregatorOverflow, 0);
 } // namespace logtail
 
 
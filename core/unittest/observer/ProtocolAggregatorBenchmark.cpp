@@ -0,0 +1,98 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "common/TimeUtil.h"
+#include "logger/Logger.h"
+#include "network/protocols/http/type.h"
+
+using namespace logtail;
+
+// Replays synthetic HTTP events of a gateway to the aggregator, and measures the cost of aggregating events and
+// flushing one interval.
+// Usage: protocol_aggregator_benchmark [distinct keys per interval] [events per interval]
+static void BM_AggregateHTTP(uint32_t keyCount, uint32_t eventCount, int intervals) {
+    // keys are skewed, as some urls are much hotter than others
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<uint32_t> keyDist(0, keyCount - 1);
+    std::exponential_distribution<double> latencyDist(1.0 / 2000000);
+    // events refer to keys owned here, like events refer to strings kept by parsers
+    std::vector<CommonAggKey> connKeys(64);
+    for (uint32_t i = 0; i < connKeys.size(); ++i) {
+        connKeys[i].Role = PacketRoleType::Server;
+        connKeys[i].HashVal = i;
+        connKeys[i].RemoteIp = "10.0.0." + std::to_string(i);
+    }
+    std::vector<std::string> resources(keyCount);
+    for (uint32_t i = 0; i < keyCount; ++i) {
+        resources[i] = "/api/v1/items/" + std::to_string(i);
+    }
+    std::vector<HTTPProtocolEvent> events(eventCount);
+    for (auto& event : events) {
+        uint32_t key = std::min(keyDist(rng), keyDist(rng));
+        event.Key.ConnKey = &connKeys[key % 64];
+        event.Key.ReqType = "GET";
+        event.Key.ReqDomain = "gateway.example.com";
+        event.Key.ReqResource = resources[key];
+        event.Key.Version = "1.1";
+        event.Key.RespCode = 200;
+        event.Key.RespStatus = 2;
+        event.Info.LatencyNs = static_cast<int64_t>(latencyDist(rng));
+        event.Info.ReqBytes = 256;
+        event.Info.RespBytes = 1024;
+    }
+
+    // large enough to hold all keys, so that no event is spilled
+    HTTPProtocolEventAggregator aggregator(keyCount, keyCount);
+    google::protobuf::RepeatedPtrField<sls_logs::Log_Content> globalTags;
+    uint64_t addTime = 0, flushTime = 0;
+    size_t logCount = 0;
+    for (int i = 0; i < intervals; ++i) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (auto& event : events) {
+            aggregator.AddEvent(std::move(event));
+        }
+        addTime += GetCurrentTimeInMicroSeconds() - startTime;
+
+        std::vector<sls_logs::Log> allData;
+        startTime = GetCurrentTimeInMicroSeconds();
+        aggregator.FlushLogs(allData, "", globalTags, 15);
+        flushTime += GetCurrentTimeInMicroSeconds() - startTime;
+        logCount += allData.size();
+    }
+    std::cout << "keys: " << keyCount << "\tevents: " << eventCount
+              << "\tadd: " << addTime * 1000.0 / eventCount / intervals << " ns/event"
+              << "\tflush: " << flushTime / 1000.0 / intervals << " ms/interval"
+              << "\tlogs: " << logCount / intervals << "/interval" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    if (argc > 2) {
+        BM_AggregateHTTP(atoi(argv[1]), atoi(argv[2]), 10);
+        return 0;
+    }
+    for (uint32_t keyCount : {1000, 10000, 50000}) {
+        BM_AggregateHTTP(keyCount, 500000, 10);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "logger/Logger.h"
+#include "network/protocols/http/parser.h"
+#include "network/protocols/mysql/parser.h"
+#include "network/protocols/redis/parser.h"
+
+using namespace logtail;
+
+// Replays synthetic request and response payloads of one connection to the protocol parsers, and measures the cost of
+// parsing and aggregating one request and response pair.
+// Usage: protocol_parser_benchmark [distinct keys] [pairs]
+
+static PacketEventHeader MakeHeader() {
+    PacketEventHeader header{};
+    header.PID = 1;
+    header.SockHash = 12345;
+    header.RoleType = PacketRoleType::Server;
+    header.SrcAddr.Type = SockAddressType_IPV4;
+    header.SrcAddr.Addr.IPV4 = htonl(0x0a000001);
+    header.DstAddr.Type = SockAddressType_IPV4;
+    header.DstAddr.Addr.IPV4 = htonl(0x0a000002);
+    header.SrcPort = 80;
+    header.DstPort = 34567;
+    return header;
+}
+
+template <typename Parser, typename Aggregator>
+static void Replay(const std::string& name,
+                   const std::vector<std::string>& requests,
+                   const std::string& response,
+                   uint32_t pairCount) {
+    PacketEventHeader header = MakeHeader();
+    // large enough to hold all keys, so that no event is spilled
+    Aggregator aggregator(requests.size(), requests.size());
+    Parser parser(&aggregator, &header);
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (uint32_t i = 0; i < pairCount; ++i) {
+        const std::string& request = requests[i % requests.size()];
+        header.TimeNano = i * 2000;
+        parser.OnPacket(PacketType_In,
+                        MessageType_Request,
+                        &header,
+                        request.data(),
+                        (int32_t)request.size(),
+                        (int32_t)request.size());
+        header.TimeNano = i * 2000 + 1000;
+        parser.OnPacket(PacketType_Out,
+                        MessageType_Response,
+                        &header,
+                        response.data(),
+                        (int32_t)response.size(),
+                        (int32_t)response.size());
+    }
+    uint64_t cost = GetCurrentTimeInMicroSeconds() - startTime;
+
+    std::vector<sls_logs::Log> allData;
+    google::protobuf::RepeatedPtrField<sls_logs::Log_Content> globalTags;
+    aggregator.FlushLogs(allData, "", globalTags, 15);
+    std::cout << name << "\tkeys: " << requests.size() << "\tpairs: " << pairCount
+              << "\tcost: " << cost * 1000.0 / pairCount << " ns/pair"
+              << "\tlogs: " << allData.size() << std::endl;
+}
+
+static void BM_ParseHTTP(uint32_t keyCount, uint32_t pairCount) {
+    std::vector<std::string> requests;
+    for (uint32_t i = 0; i < keyCount; ++i) {
+        requests.push_back("GET /api/v1/items/" + std::to_string(i)
+                           + "?session=0123456789abcdef&page=1 HTTP/1.1\r\n"
+                             "Host: gateway.example.com\r\n"
+                             "User-Agent: benchmark/1.0\r\n"
+                             "Accept: */*\r\n\r\n");
+    }
+    std::string response = "HTTP/1.1 200 OK\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Content-Length: 2\r\n\r\n{}";
+    Replay<HTTPProtocolParser, HTTPProtocolEventAggregator>("http", requests, response, pairCount);
+}
+
+static void BM_ParseRedis(uint32_t keyCount, uint32_t pairCount) {
+    std::vector<std::string> requests;
+    for (uint32_t i = 0; i < keyCount; ++i) {
+        std::string cmd = "GET user:" + std::to_string(i);
+        requests.push_back("*1\r\n$" + std::to_string(cmd.size()) + "\r\n" + cmd + "\r\n");
+    }
+    Replay<RedisProtocolParser, RedisProtocolEventAggregator>("redis", requests, "+OK\r\n", pairCount);
+}
+
+static void BM_ParseMySQL(uint32_t keyCount, uint32_t pairCount) {
+    std::vector<std::string> requests;
+    for (uint32_t i = 0; i < keyCount; ++i) {
+        // COM_PREPARE keeps the whole statement
+        std::string sql = "SELECT name FROM items WHERE id = ? AND shard = " + std::to_string(i);
+        std::string packet(5, '\0');
+        packet[0] = (char)((sql.size() + 1) & 0xff);
+        packet[1] = (char)((sql.size() + 1) >> 8);
+        packet[4] = 0x16;
+        requests.push_back(packet + sql);
+    }
+    // OK packet
+    std::string response("\x07\x00\x00\x01\x00\x01\x01\x02\x00\x00\x00", 11);
+    Replay<MySQLProtocolParser, MySQLProtocolEventAggregator>("mysql", requests, response, pairCount);
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    if (argc > 2) {
+        BM_ParseHTTP(atoi(argv[1]), atoi(argv[2]));
+        BM_ParseRedis(atoi(argv[1]), atoi(argv[2]));
+        BM_ParseMySQL(atoi(argv[1]), atoi(argv[2]));
+        return 0;
+    }
+    for (uint32_t keyCount : {10, 1000}) {
+        BM_ParseHTTP(keyCount, 1000000);
+        BM_ParseRedis(keyCount, 1000000);
+        BM_ParseMySQL(keyCount, 1000000);
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <string>
+
+#include "metas/ConnectionMetaManager.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// SocketInodeScannerUnittest scans a fake proc tree, whose fd and ns links point to nowhere like the real ones, and
+// dumps connections from a fake table instead of netlink.
+class SocketInodeScannerUnittest : public testing::Test {
+public:
+    void TestScan();
+    void TestRequestPid();
+    void TestInvalidate();
+    void TestExitedPid();
+    void TestReusedFd();
+    void TestScanCost();
+
+protected:
+    void SetUp() override {
+        mProcDir = filesystem::temp_directory_path() / ("socket_inode_scanner_" + to_string(getpid()));
+        filesystem::remove_all(mProcDir);
+        filesystem::create_directories(mProcDir);
+        mConnections.clear();
+        mFetchCount = 0;
+        ConnectionMetaStatistic::Clear();
+    }
+
+    void TearDown() override { filesystem::remove_all(mProcDir); }
+
+    void AddPid(uint32_t pid, uint32_t netNs) {
+        filesystem::create_directories(mProcDir / to_string(pid) / "fd");
+        filesystem::create_directories(mProcDir / to_string(pid) / "ns");
+        filesystem::create_symlink("net:[" + to_string(netNs) + "]", mProcDir / to_string(pid) / "ns" / "net");
+        // not a socket
+        filesystem::create_symlink("/dev/null", mProcDir / to_string(pid) / "fd" / "0");
+    }
+
+    void AddSocket(uint32_t pid, uint32_t fd, uint32_t netNs, uint32_t inode) {
+        filesystem::create_symlink("socket:[" + to_string(inode) + "]",
+                                   mProcDir / to_string(pid) / "fd" / to_string(fd));
+        auto info = make_shared<ConnectionInfo>();
+        info->family = AF_INET;
+        info->localPort = inode;
+        mConnections[netNs][inode] = info;
+    }
+
+    unique_ptr<SocketInodeScanner> CreateScanner() {
+        return unique_ptr<SocketInodeScanner>(new SocketInodeScanner(
+            mProcDir.string(), [this](uint32_t pid, uint32_t netNs, SocketInodeScanner::ConnectionMap& infos) {
+                ++mFetchCount;
+                infos = mConnections[netNs];
+                return true;
+            }));
+    }
+
+    static ConnectionInfoPtr Find(const SocketInodeScanner::Snapshot& snapshot, uint32_t pid, uint32_t fd) {
+        auto iter = snapshot.mConnections.find((uint64_t)pid << 32 | fd);
+        return iter == snapshot.mConnections.end() ? nullptr : iter->second.mInfo;
+    }
+
+    filesystem::path mProcDir;
+    unordered_map<uint32_t, SocketInodeScanner::ConnectionMap> mConnections;
+    size_t mFetchCount = 0;
+};
+
+void SocketInodeScannerUnittest::TestScan() {
+    AddPid(100, 1);
+    AddSocket(100, 3, 1, 1000);
+    AddSocket(100, 4, 1, 1001);
+    AddPid(101, 1);
+    AddSocket(101, 3, 1, 1002);
+    AddPid(200, 2);
+    AddSocket(200, 5, 2, 2000);
+    // no sockets, no dump of its namespace
+    AddPid(300, 3);
+    filesystem::create_directories(mProcDir / "self");
+
+    auto scanner = CreateScanner();
+    APSARA_TEST_EQUAL(nullptr, scanner->TakeSnapshot());
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(2U, mFetchCount);
+    APSARA_TEST_EQUAL(4U, ConnectionMetaStatistic::GetInstance()->mScanFdDirCount.load());
+    auto snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_NOT_EQUAL(nullptr, snapshot);
+    APSARA_TEST_EQUAL(nullptr, scanner->TakeSnapshot());
+    APSARA_TEST_EQUAL(4U, snapshot->mConnections.size());
+    APSARA_TEST_EQUAL(1000U, Find(*snapshot, 100, 3)->localPort);
+    APSARA_TEST_EQUAL(1001U, Find(*snapshot, 100, 4)->localPort);
+    APSARA_TEST_EQUAL(1002U, Find(*snapshot, 101, 3)->localPort);
+    APSARA_TEST_EQUAL(2000U, Find(*snapshot, 200, 5)->localPort);
+    APSARA_TEST_EQUAL(nullptr, Find(*snapshot, 100, 0));
+
+    // nothing new, nothing read again
+    APSARA_TEST_FALSE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(2U, mFetchCount);
+    APSARA_TEST_EQUAL(4U, ConnectionMetaStatistic::GetInstance()->mScanFdDirCount.load());
+    APSARA_TEST_EQUAL(nullptr, scanner->TakeSnapshot());
+}
+
+void SocketInodeScannerUnittest::TestRequestPid() {
+    AddPid(100, 1);
+    AddSocket(100, 3, 1, 1000);
+    AddPid(200, 2);
+    AddSocket(200, 3, 2, 2000);
+    auto scanner = CreateScanner();
+    scanner->ScanOnce();
+    APSARA_TEST_EQUAL(2U, mFetchCount);
+
+    AddSocket(100, 4, 1, 1001);
+    // fds of known pids are not read again unless requested
+    APSARA_TEST_FALSE(scanner->ScanOnce());
+    scanner->RequestPid(100);
+    // exited pids are ignored
+    scanner->RequestPid(101);
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    // only the namespace of the requested pid is dumped
+    APSARA_TEST_EQUAL(3U, mFetchCount);
+    auto snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_EQUAL(3U, snapshot->mConnections.size());
+    APSARA_TEST_EQUAL(1001U, Find(*snapshot, 100, 4)->localPort);
+
+    // new pids are read in the next round, their known namespaces are dumped again only for unknown sockets
+    AddPid(102, 1);
+    AddSocket(102, 3, 1, 1000);
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(3U, mFetchCount);
+    snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_EQUAL(4U, snapshot->mConnections.size());
+    APSARA_TEST_EQUAL(1000U, Find(*snapshot, 102, 3)->localPort);
+    AddPid(103, 1);
+    AddSocket(103, 3, 1, 1003);
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(4U, mFetchCount);
+    snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_EQUAL(5U, snapshot->mConnections.size());
+    APSARA_TEST_EQUAL(1003U, Find(*snapshot, 103, 3)->localPort);
+}
+
+void SocketInodeScannerUnittest::TestInvalidate() {
+    size_t hookCount = 0;
+    AddPid(100, 1);
+    AddSocket(100, 3, 1, 1000);
+    AddSocket(100, 4, 1, 1001);
+    AddPid(200, 2);
+    AddSocket(200, 3, 2, 2000);
+    SocketInodeScanner scanner(
+        mProcDir.string(),
+        [this](uint32_t pid, uint32_t netNs, SocketInodeScanner::ConnectionMap& infos) {
+            ++mFetchCount;
+            infos = mConnections[netNs];
+            return true;
+        },
+        [&hookCount]() { ++hookCount; });
+    scanner.ScanOnce();
+    auto snapshot = scanner.TakeSnapshot();
+    APSARA_TEST_EQUAL(3U, snapshot->mConnections.size());
+
+    // socket closed
+    mConnections[1].erase(1001);
+    scanner.Invalidate();
+    APSARA_TEST_TRUE(scanner.ScanOnce());
+    APSARA_TEST_EQUAL(1U, hookCount);
+    APSARA_TEST_EQUAL(4U, mFetchCount);
+    snapshot = scanner.TakeSnapshot();
+    APSARA_TEST_EQUAL(2U, snapshot->mConnections.size());
+    APSARA_TEST_EQUAL(nullptr, Find(*snapshot, 100, 4));
+
+    APSARA_TEST_FALSE(scanner.ScanOnce());
+    APSARA_TEST_EQUAL(1U, hookCount);
+    APSARA_TEST_EQUAL(4U, mFetchCount);
+}
+
+void SocketInodeScannerUnittest::TestExitedPid() {
+    AddPid(100, 1);
+    AddSocket(100, 3, 1, 1000);
+    AddPid(200, 2);
+    AddSocket(200, 3, 2, 2000);
+    auto scanner = CreateScanner();
+    scanner->ScanOnce();
+    scanner->TakeSnapshot();
+
+    filesystem::remove_all(mProcDir / "200");
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    auto snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_EQUAL(1U, snapshot->mConnections.size());
+    APSARA_TEST_EQUAL(nullptr, Find(*snapshot, 200, 3));
+
+    // the namespace is dumped again when a pid lives in it again
+    AddPid(201, 2);
+    AddSocket(201, 3, 2, 2001);
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(3U, mFetchCount);
+    snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_EQUAL(2001U, Find(*snapshot, 201, 3)->localPort);
+}
+
+void SocketInodeScannerUnittest::TestScanCost() {
+    const uint32_t pidCount = 2000, socketCount = 16, netNsCount = 50;
+    for (uint32_t pid = 1; pid <= pidCount; ++pid) {
+        AddPid(pid, pid % netNsCount + 1);
+        for (uint32_t fd = 1; fd <= socketCount; ++fd) {
+            AddSocket(pid, fd, pid % netNsCount + 1, pid * socketCount + fd);
+        }
+    }
+    auto scanner = CreateScanner();
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(pidCount, ConnectionMetaStatistic::GetInstance()->mScanFdDirCount.load());
+    APSARA_TEST_EQUAL(netNsCount, mFetchCount);
+    APSARA_TEST_EQUAL(pidCount * socketCount, scanner->TakeSnapshot()->mConnections.size());
+
+    // one new process and one missed lookup
+    AddPid(pidCount + 1, 1);
+    AddSocket(pidCount + 1, 1, 1, 0xFFFFFF);
+    AddSocket(1, socketCount + 1, 2, 0xFFFFFE);
+    scanner->RequestPid(1);
+    APSARA_TEST_TRUE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(pidCount + 2, ConnectionMetaStatistic::GetInstance()->mScanFdDirCount.load());
+    // the namespaces of both are dumped again in the same round
+    APSARA_TEST_EQUAL(netNsCount + 2, mFetchCount);
+    APSARA_TEST_EQUAL(pidCount * socketCount + 2, scanner->TakeSnapshot()->mConnections.size());
+
+    APSARA_TEST_FALSE(scanner->ScanOnce());
+    APSARA_TEST_EQUAL(pidCount + 2, ConnectionMetaStatistic::GetInstance()->mScanFdDirCount.load());
+}
+
+void SocketInodeScannerUnittest::TestReusedFd() {
+    AddPid(100, 1);
+    AddSocket(100, 3, 1, 1000);
+    auto scanner = CreateScanner();
+    scanner->ScanOnce();
+    auto snapshot = scanner->TakeSnapshot();
+    APSARA_TEST_EQUAL(1000U, snapshot->mConnections[(uint64_t)100 << 32 | 3].mInode);
+    APSARA_TEST_TRUE(scanner->IsSocketFdUnchanged(100, 3, 1000));
+
+    // fd closed and reused by another socket before the next scan
+    filesystem::remove(mProcDir / "100" / "fd" / "3");
+    APSARA_TEST_FALSE(scanner->IsSocketFdUnchanged(100, 3, 1000));
+    AddSocket(100, 3, 1, 1001);
+    APSARA_TEST_FALSE(scanner->IsSocketFdUnchanged(100, 3, 1000));
+    APSARA_TEST_TRUE(scanner->IsSocketFdUnchanged(100, 3, 1001));
+    // not a socket
+    APSARA_TEST_FALSE(scanner->IsSocketFdUnchanged(100, 0, 0));
+}
+
+UNIT_TEST_CASE(SocketInodeScannerUnittest, TestScan)
+UNIT_TEST_CASE(SocketInodeScannerUnittest, TestRequestPid)
+UNIT_TEST_CASE(SocketInodeScannerUnittest, TestInvalidate)
+UNIT_TEST_CASE(SocketInodeScannerUnittest, TestExitedPid)
+UNIT_TEST_CASE(SocketInodeScannerUnittest, TestScanCost)
+UNIT_TEST_CASE(SocketInodeScannerUnittest, TestReusedFd)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
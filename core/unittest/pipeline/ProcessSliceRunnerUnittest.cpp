@@ -0,0 +1,160 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "models/LogEvent.h"
+#include "pipeline/plugin/instance/ProcessorInstance.h"
+#include "runner/ProcessSliceRunner.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(process_slice_thread_count);
+DECLARE_FLAG_INT32(process_slice_min_events);
+DECLARE_FLAG_INT32(process_slice_events);
+
+using namespace std;
+
+namespace logtail {
+
+// ProcessorSliceMock copies content with a new string allocated from the group, and drops every 7th event.
+class ProcessorSliceMock : public Processor {
+public:
+    static const string sName;
+
+    const string& Name() const override { return sName; }
+    bool Init(const Json::Value& config) override { return true; }
+    void Process(PipelineEventGroup& logGroup) override {
+        EventsContainer& events = logGroup.MutableEvents();
+        size_t wIdx = 0;
+        for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
+            LogEvent& event = events[rIdx].Cast<LogEvent>();
+            StringView content = event.GetContent("content");
+            if (content.back() == '7') {
+                continue;
+            }
+            string copy = content.to_string() + "@" + logGroup.GetTag("tag").to_string();
+            event.SetContentNoCopy("copy", StringView(logGroup.GetSourceBuffer()->CopyString(copy).data, copy.size()));
+            if (wIdx != rIdx) {
+                events[wIdx] = std::move(events[rIdx]);
+            }
+            ++wIdx;
+        }
+        events.resize(wIdx);
+    }
+    bool IsParallelizable() const override { return true; }
+
+protected:
+    bool IsSupportedEvent(const PipelineEventPtr& e) const override { return true; }
+};
+
+const string ProcessorSliceMock::sName = "processor_slice_mock";
+
+class ProcessSliceRunnerUnittest : public testing::Test {
+public:
+    void TestProcess();
+    void TestSmallGroup();
+
+protected:
+    void SetUp() override {
+        INT32_FLAG(process_slice_thread_count) = 3;
+        INT32_FLAG(process_slice_min_events) = 100;
+        INT32_FLAG(process_slice_events) = 16;
+        mProcessor
+            = make_unique<ProcessorInstance>(new ProcessorSliceMock(), PluginInstance::PluginMeta("0", "0", "1"));
+        Json::Value config;
+        mProcessor->Init(config, mContext);
+    }
+
+    void TearDown() override {
+        INT32_FLAG(process_slice_thread_count) = -1;
+        INT32_FLAG(process_slice_min_events) = 4096;
+        INT32_FLAG(process_slice_events) = 512;
+    }
+
+private:
+    PipelineEventGroup CreateGroup(size_t eventCnt) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        group.SetTag(string("tag"), string("value"));
+        for (size_t i = 0; i < eventCnt; ++i) {
+            auto event = group.AddLogEvent();
+            event->SetContent(string("content"), to_string(i));
+        }
+        return group;
+    }
+
+    PipelineContext mContext;
+    unique_ptr<ProcessorInstance> mProcessor;
+};
+
+void ProcessSliceRunnerUnittest::TestProcess() {
+    ProcessSliceRunner runner;
+    APSARA_TEST_TRUE_FATAL(runner.IsEnabled());
+    vector<ProcessorInstance*> processors{mProcessor.get(), mProcessor.get()};
+
+    for (size_t eventCnt : {100, 101, 1000}) {
+        vector<PipelineEventGroup> groups;
+        groups.emplace_back(CreateGroup(eventCnt));
+        auto sourceBuffer = groups[0].GetSourceBuffer();
+        runner.Process(processors, groups);
+
+        APSARA_TEST_EQUAL_FATAL(1U, groups.size());
+        APSARA_TEST_EQUAL(sourceBuffer, groups[0].GetSourceBuffer());
+        APSARA_TEST_EQUAL("value", groups[0].GetTag("tag").to_string());
+        // order is kept, and strings allocated in slices are still valid
+        size_t idx = 0;
+        for (size_t i = 0; i < eventCnt; ++i) {
+            if (i % 10 == 7) {
+                continue;
+            }
+            APSARA_TEST_TRUE_FATAL(idx < groups[0].GetEvents().size());
+            PipelineEventPtr& e = groups[0].MutableEvents()[idx++];
+            // events point to the original group again
+            APSARA_TEST_EQUAL(sourceBuffer, e->GetSourceBuffer());
+            const LogEvent& event = e.Cast<LogEvent>();
+            APSARA_TEST_EQUAL(to_string(i), event.GetContent("content").to_string());
+            APSARA_TEST_EQUAL(to_string(i) + "@value", event.GetContent("copy").to_string());
+        }
+        APSARA_TEST_EQUAL(idx, groups[0].GetEvents().size());
+    }
+}
+
+void ProcessSliceRunnerUnittest::TestSmallGroup() {
+    ProcessSliceRunner runner;
+    vector<ProcessorInstance*> processors{mProcessor.get()};
+    vector<PipelineEventGroup> groups;
+    groups.emplace_back(CreateGroup(20));
+    runner.Process(processors, groups);
+    APSARA_TEST_EQUAL(18U, groups[0].GetEvents().size());
+    APSARA_TEST_EQUAL(groups[0].GetSourceBuffer(), groups[0].MutableEvents()[0]->GetSourceBuffer());
+
+    // exactly once groups are always processed serially
+    groups.clear();
+    groups.emplace_back(CreateGroup(1000));
+    groups[0].SetExactlyOnceCheckpoint(make_shared<RangeCheckpoint>());
+    APSARA_TEST_FALSE(runner.CanSplit(groups[0]));
+
+    INT32_FLAG(process_slice_thread_count) = 0;
+    ProcessSliceRunner disabledRunner;
+    APSARA_TEST_FALSE(disabledRunner.IsEnabled());
+}
+
+UNIT_TEST_CASE(ProcessSliceRunnerUnittest, TestProcess)
+UNIT_TEST_CASE(ProcessSliceRunnerUnittest, TestSmallGroup)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,135 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "file_server/polling/BatchStat.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_stat_batch_size);
+DECLARE_FLAG_BOOL(enable_polling_stat_io_uring);
+
+using namespace std;
+
+namespace logtail {
+
+class BatchStatUnittest : public ::testing::Test {
+public:
+    void TestSequential();
+    void TestThreadPool();
+    void TestIoUring();
+
+protected:
+    static void SetUpTestCase() {
+        sTestDir = GetProcessExecutionDir() + "BatchStatUnittest";
+        bfs::remove_all(sTestDir);
+        bfs::create_directories(sTestDir);
+        // 1/10 of paths are not existing.
+        for (size_t i = 0; i < sFileCount; ++i) {
+            string path = PathJoin(sTestDir, "file_" + ToString(i));
+            if (i % 10 != 0) {
+                ofstream(path) << string(i, 'a');
+            }
+            sPaths.push_back(path);
+        }
+        bfs::create_directories(PathJoin(sTestDir, "dir"));
+        sPaths.push_back(PathJoin(sTestDir, "dir"));
+    }
+
+    static void TearDownTestCase() { bfs::remove_all(sTestDir); }
+
+    void TearDown() override {
+        INT32_FLAG(polling_stat_batch_size) = 256;
+        BOOL_FLAG(enable_polling_stat_io_uring) = true;
+    }
+
+private:
+    void checkResults(const vector<BatchStat::Result>& results);
+
+    static const size_t sFileCount = 1000;
+    static string sTestDir;
+    static vector<string> sPaths;
+};
+
+string BatchStatUnittest::sTestDir;
+vector<string> BatchStatUnittest::sPaths;
+
+void BatchStatUnittest::checkResults(const vector<BatchStat::Result>& results) {
+    APSARA_TEST_EQUAL_FATAL(sPaths.size(), results.size());
+    for (size_t i = 0; i < sPaths.size(); ++i) {
+        fsutil::PathStat expected;
+        if (!fsutil::PathStat::stat(sPaths[i], expected)) {
+            APSARA_TEST_EQUAL(ENOENT, results[i].err);
+            continue;
+        }
+        APSARA_TEST_EQUAL(0, results[i].err);
+        APSARA_TEST_TRUE(expected.GetDevInode() == results[i].stat.GetDevInode());
+        APSARA_TEST_EQUAL(expected.GetFileSize(), results[i].stat.GetFileSize());
+        APSARA_TEST_EQUAL(expected.IsDir(), results[i].stat.IsDir());
+        APSARA_TEST_EQUAL(expected.IsRegFile(), results[i].stat.IsRegFile());
+        int64_t expectedSec = 0, expectedNsec = 0, sec = 0, nsec = 0;
+        expected.GetLastWriteTime(expectedSec, expectedNsec);
+        results[i].stat.GetLastWriteTime(sec, nsec);
+        APSARA_TEST_EQUAL(expectedSec, sec);
+        APSARA_TEST_EQUAL(expectedNsec, nsec);
+    }
+}
+
+void BatchStatUnittest::TestSequential() {
+    INT32_FLAG(polling_stat_batch_size) = 1;
+    BatchStat batchStat;
+    vector<BatchStat::Result> results;
+    batchStat.Stat(sPaths, results);
+    APSARA_TEST_TRUE(BatchStat::Backend::SEQUENTIAL == batchStat.GetBackend());
+    checkResults(results);
+}
+
+void BatchStatUnittest::TestThreadPool() {
+    BOOL_FLAG(enable_polling_stat_io_uring) = false;
+    BatchStat batchStat;
+    vector<BatchStat::Result> results;
+    batchStat.Stat(sPaths, results);
+    APSARA_TEST_TRUE(BatchStat::Backend::THREAD_POOL == batchStat.GetBackend());
+    checkResults(results);
+
+    // empty and single path
+    batchStat.Stat(vector<string>(), results);
+    APSARA_TEST_TRUE(results.empty());
+    batchStat.Stat(vector<string>{sPaths[1]}, results);
+    APSARA_TEST_EQUAL(1U, results.size());
+    APSARA_TEST_EQUAL(0, results[0].err);
+}
+
+void BatchStatUnittest::TestIoUring() {
+    BatchStat batchStat;
+    vector<BatchStat::Result> results;
+    // The backend depends on kernel and seccomp, results should be the same anyway.
+    batchStat.Stat(sPaths, results);
+    LOG_INFO(sLogger, ("batch stat backend", static_cast<int>(batchStat.GetBackend())));
+    checkResults(results);
+    // ring is reused across batches
+    batchStat.Stat(sPaths, results);
+    checkResults(results);
+}
+
+UNIT_TEST_CASE(BatchStatUnittest, TestSequential)
+UNIT_TEST_CASE(BatchStatUnittest, TestThreadPool)
+UNIT_TEST_CASE(BatchStatUnittest, TestIoUring)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,87 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "file_server/polling/BatchStat.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_stat_batch_size);
+DECLARE_FLAG_BOOL(enable_polling_stat_io_uring);
+
+using namespace logtail;
+
+// Compares the time of one polling round (stat all files once) of different backends.
+// Usage: polling_stat_benchmark [dir] [file count]
+// Put dir on NFS or overlay filesystem to see the difference, page cache makes local
+// filesystem too fast.
+static void BM_PollingRound(const std::string& dir, int fileCount, int rounds) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < fileCount; ++i) {
+        std::string path = PathJoin(dir, "file_" + ToString(i));
+        if (!CheckExistance(path)) {
+            std::ofstream(path) << "a";
+        }
+        paths.push_back(path);
+    }
+
+    struct Case {
+        const char* name;
+        int32_t batchSize;
+        bool enableIoUring;
+    };
+    const Case cases[] = {{"sequential (current loop)", 1, false},
+                          {"thread pool", 256, false},
+                          {"io_uring statx", 256, true}};
+    for (const auto& c : cases) {
+        INT32_FLAG(polling_stat_batch_size) = c.batchSize;
+        BOOL_FLAG(enable_polling_stat_io_uring) = c.enableIoUring;
+        BatchStat batchStat;
+        std::vector<BatchStat::Result> results;
+        uint64_t durationTime = 0;
+        for (int r = 0; r < rounds; ++r) {
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            // same batching as PollingModify
+            for (size_t begin = 0; begin < paths.size(); begin += BatchStat::GetBatchSize()) {
+                size_t end = std::min(paths.size(), begin + BatchStat::GetBatchSize());
+                std::vector<std::string> batch(paths.begin() + begin, paths.begin() + end);
+                batchStat.Stat(batch, results);
+            }
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << c.name << "\tbackend: " << static_cast<int>(batchStat.GetBackend())
+                  << "\tfiles: " << fileCount << "\tround time: " << durationTime / rounds / 1000.0 << " ms"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::string dir = argc > 1 ? argv[1] : GetProcessExecutionDir() + "polling_stat_benchmark";
+    int fileCount = argc > 2 ? atoi(argv[2]) : 50000;
+    bfs::create_directories(dir);
+    std::cout << "BM_PollingRound" << std::endl;
+    BM_PollingRound(dir, fileCount, 10);
+    return 0;
+}
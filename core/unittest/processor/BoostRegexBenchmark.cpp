@@ -18,6 +18,8 @@
 #include <iostream>
 #include <sstream>
 
+#include "common/RegexMatcher.h"
+#include "common/StringTools.h"
 #include "unittest/Unittest.h"
 
 
@@ -94,6 +96,74 @@ static void BM_Regex_Search(int size, int batchSize) {
     }
 }
 
+// compare boost and RegexMatcher on multiline start patterns, where most lines are continuation lines
+static void BM_Regex_Matcher_Search(int batchSize) {
+    const std::vector<std::string> patterns = {R"(\d{4}-\d{2}-\d{2}.*)",
+                                               R"(\[\d+-\d+-\w+:\d+:\d+\.\d+\]\s+\[\w+\].*)",
+                                               R"(\[.*)",
+                                               R"(\S+\s+\d+.*)",
+                                               R"((\w+)\s+\1.*)"};
+    const std::vector<std::string> lines
+        = {"2024-05-20 10:00:00.123 [ERROR] java.lang.NullPointerException: null",
+           "\tat com.example.Service.handle(Service.java:42)",
+           "\tat com.example.Controller.dispatch(Controller.java:108)",
+           "[2024-05-20 10:00:00.123] [info] hello world",
+           "Caused by: java.lang.IllegalStateException: oops"};
+    for (const auto& pattern : patterns) {
+        boost::regex reg(pattern);
+        RegexMatcher matcher(pattern);
+        std::string exception;
+        uint64_t boostTime = 0, matcherTime = 0;
+        size_t boostCnt = 0, matcherCnt = 0;
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < batchSize; ++i) {
+            for (const auto& line : lines) {
+                boostCnt += BoostRegexSearch(line.data(), line.size(), reg, exception);
+            }
+        }
+        boostTime = GetCurrentTimeInMicroSeconds() - startTime;
+        startTime = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < batchSize; ++i) {
+            for (const auto& line : lines) {
+                matcherCnt += matcher.Search(line.data(), line.size(), exception);
+            }
+        }
+        matcherTime = GetCurrentTimeInMicroSeconds() - startTime;
+        if (boostCnt != matcherCnt) {
+            std::cout << "error" << std::endl;
+        }
+        std::cout << pattern << '\t' << "engine: " << static_cast<int>(matcher.GetEngine()) << '\t'
+                  << "boost: " << boostTime << "us" << '\t' << "matcher: " << matcherTime << "us" << std::endl;
+    }
+}
+
+// compare boost and RegexMatcher on processor_parse_regex_native style patterns with capturing groups
+static void BM_Regex_Matcher_Match(int batchSize) {
+    const std::string pattern = R"re((\S+)\s-\s(\S+)\s\[([^]]+)]\s"(\w+)\s(\S+)\s([^"]+)"\s(\d+)\s(\d+).*)re";
+    const std::string line = R"(127.0.0.1 - - [20/May/2024:10:00:00 +0800] "GET /index.html HTTP/1.1" 200 1024 "-")";
+    boost::regex reg(pattern);
+    RegexMatcher matcher(pattern);
+    std::string exception;
+    boost::match_results<const char*> what;
+    std::vector<StringView> groups;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; ++i) {
+        if (!BoostRegexMatch(line.data(), line.size(), reg, exception, what, boost::match_default)) {
+            std::cout << "error" << std::endl;
+        }
+    }
+    uint64_t boostTime = GetCurrentTimeInMicroSeconds() - startTime;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; ++i) {
+        if (!matcher.Match(line.data(), line.size(), groups, exception)) {
+            std::cout << "error" << std::endl;
+        }
+    }
+    uint64_t matcherTime = GetCurrentTimeInMicroSeconds() - startTime;
+    std::cout << "engine: " << static_cast<int>(matcher.GetEngine()) << '\t' << "boost: " << boostTime << "us" << '\t'
+              << "matcher: " << matcherTime << "us" << std::endl;
+}
+
 int main(int argc, char** argv) {
     logtail::Logger::Instance().InitGlobalLoggers();
 #ifdef NDEBUG
@@ -105,5 +175,9 @@ int main(int argc, char** argv) {
     BM_Regex_Match(100, 10000);
     std::cout << "BM_Regex_Search" << std::endl;
     BM_Regex_Search(100, 10000);
+    std::cout << "BM_Regex_Matcher_Search" << std::endl;
+    BM_Regex_Matcher_Search(100000);
+    std::cout << "BM_Regex_Matcher_Match" << std::endl;
+    BM_Regex_Matcher_Match(100000);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "models/PipelineEventGroup.h"
+#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterModeSimdParser.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+class DelimiterModeSimdParserUnittest : public ::testing::Test {
+public:
+    void TestParse();
+    void TestParseFailure();
+    void TestLongLine();
+    void TestFsmConsistency();
+
+private:
+    bool Parse(char quote, char separator, const std::string& line, std::vector<std::string>& res) {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        LogEvent* event = group.AddLogEvent();
+        // surround the line, so that bytes out of [begin, end) are not read
+        std::string buffer = std::string(1, quote) + line + std::string(1, separator);
+        std::vector<StringView> columnValues;
+        DelimiterModeSimdParser parser(quote, separator);
+        bool ok = parser.ParseDelimiterLine(StringView(buffer), 1, 1 + line.size(), columnValues, *event);
+        res.clear();
+        for (const auto& value : columnValues) {
+            res.emplace_back(value.data(), value.size());
+        }
+        return ok;
+    }
+};
+
+void DelimiterModeSimdParserUnittest::TestParse() {
+    const std::vector<std::pair<std::string, std::vector<std::string>>> cases = {
+        {"", {""}},
+        {"a", {"a"}},
+        {",", {"", ""}},
+        {"a,b,,c", {"a", "b", "", "c"}},
+        {"'a,b',c", {"a,b", "c"}},
+        {"''", {""}},
+        {"'',''", {"", ""}},
+        {"'a''b',c", {"a'b", "c"}},
+        {"'''',''''''", {"'", "''"}},
+        {"'a\nb',c\n", {"a\nb", "c\n"}},
+    };
+    for (const auto& c : cases) {
+        std::vector<std::string> res;
+        APSARA_TEST_TRUE(Parse('\'', ',', c.first, res));
+        APSARA_TEST_EQUAL(c.second, res);
+    }
+}
+
+void DelimiterModeSimdParserUnittest::TestParseFailure() {
+    const std::vector<std::string> cases = {"'", "'a", "a'b", "'a'b", "'a'b',c", "'''", "a,'b", "'a,b"};
+    for (const auto& c : cases) {
+        std::vector<std::string> res;
+        APSARA_TEST_FALSE(Parse('\'', ',', c, res));
+        APSARA_TEST_TRUE(res.empty());
+    }
+}
+
+void DelimiterModeSimdParserUnittest::TestLongLine() {
+    // fields and quoted parts cross the 64 bytes blocks
+    std::string line;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 40; ++i) {
+        std::string value(i * 3, 'a' + i % 26);
+        if (i % 3 == 0) {
+            expected.push_back(value + "," + value);
+            line += "\"" + value + "," + value + "\",";
+        } else if (i % 3 == 1) {
+            expected.push_back(value + "\"");
+            line += "\"" + value + "\"\"\",";
+        } else {
+            expected.push_back(value);
+            line += value + ",";
+        }
+    }
+    line.pop_back();
+    std::vector<std::string> res;
+    APSARA_TEST_TRUE(Parse('"', ',', line, res));
+    APSARA_TEST_EQUAL(expected, res);
+    APSARA_TEST_FALSE(Parse('"', ',', line + "\"", res));
+}
+
+void DelimiterModeSimdParserUnittest::TestFsmConsistency() {
+    std::mt19937 rng(0);
+    const std::vector<std::pair<char, char>> chars = {{'"', ','}, {'\'', '\t'}, {'"', '\0'}, {'\0', '|'}};
+    for (int i = 0; i < 100000; ++i) {
+        const auto& c = chars[rng() % chars.size()];
+        char quote = c.first;
+        char separator = c.second;
+        const char alphabet[] = {quote, separator, 'a', quote, separator, 'b'};
+        std::string line;
+        size_t size = rng() % (rng() % 4 == 0 ? 300 : 40);
+        if (i % 2 == 0) {
+            for (size_t j = 0; j < size; ++j) {
+                line += alphabet[rng() % sizeof(alphabet)];
+            }
+        } else {
+            // mostly valid lines
+            while (line.size() < size) {
+                if (rng() % 2 == 0) {
+                    line += std::string(rng() % 5, 'x');
+                } else {
+                    line += quote;
+                    for (int k = rng() % 40; k > 0; --k) {
+                        int c = rng() % 4;
+                        line += c == 0 ? std::string(2, quote) : std::string(1, c == 1 ? separator : 'y');
+                    }
+                    line += quote;
+                }
+                line += separator;
+            }
+            if (!line.empty() && rng() % 10 == 0) {
+                line[rng() % line.size()] = alphabet[rng() % sizeof(alphabet)];
+            }
+        }
+
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        LogEvent* event = group.AddLogEvent();
+        std::vector<StringView> expected, res;
+        DelimiterModeFsmParser fsmParser(quote, separator);
+        DelimiterModeSimdParser simdParser(quote, separator);
+        bool expectedResult = fsmParser.ParseDelimiterLine(StringView(line), 0, line.size(), expected, *event);
+        APSARA_TEST_EQUAL_FATAL(expectedResult,
+                                simdParser.ParseDelimiterLine(StringView(line), 0, line.size(), res, *event));
+        APSARA_TEST_EQUAL_FATAL(expected, res);
+    }
+}
+
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestParse)
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestParseFailure)
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestLongLine)
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestFsmConsistency)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,150 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "common/StringTools.h"
+#include "models/PipelineEventGroup.h"
+#include "pipeline/PipelineContext.h"
+#include "plugin/processor/ProcessorFilterNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+// Compares boost::regex per key / per tree node against the compiled FilterProgram.
+// Usage: filter_benchmark [key count] [event count]
+static void PrepareEvents(PipelineEventGroup& group, int keyCount, int eventCount) {
+    for (int i = 0; i < eventCount; ++i) {
+        LogEvent* event = group.AddLogEvent();
+        for (int k = 0; k < keyCount; ++k) {
+            // most events pass, every 10th event is dropped by the last key
+            std::string value = (k == keyCount - 1 && i % 10 == 0) ? "debug" : "value_" + ToString(k) + "_ok";
+            event->SetContent("key_" + ToString(k), value);
+        }
+    }
+}
+
+static void BM_RuleMode(int keyCount, int eventCount, int rounds) {
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup group(sourceBuffer);
+    PrepareEvents(group, keyCount, eventCount);
+    PipelineContext ctx;
+
+    std::vector<std::string> keys, exps;
+    std::vector<boost::regex> regs;
+    for (int k = 0; k < keyCount; ++k) {
+        keys.push_back("key_" + ToString(k));
+        exps.push_back("value_\\d+_.*|info");
+        regs.emplace_back(exps.back());
+    }
+
+    uint64_t passed = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& e : group.GetEvents()) {
+            const auto& event = e.Cast<LogEvent>();
+            bool res = true;
+            std::string exception;
+            for (size_t k = 0; k < keys.size() && res; ++k) {
+                const auto& content = event.FindContent(keys[k]);
+                res = content != event.end()
+                    && BoostRegexMatch(content->second.data(), content->second.size(), regs[k], exception);
+            }
+            passed += res;
+        }
+    }
+    uint64_t boostTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    FilterProgram program;
+    program.Compile(keys, exps);
+    uint64_t compiledPassed = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        FilterProgram::Session session(program);
+        for (const auto& e : group.GetEvents()) {
+            compiledPassed += program.Match(e.Cast<LogEvent>(), session, ctx);
+        }
+    }
+    uint64_t compiledTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (passed != compiledPassed) {
+        std::cout << "error: result mismatch " << passed << " vs " << compiledPassed << std::endl;
+    }
+    std::cout << "keys: " << keyCount << "\tboost: " << boostTime / 1000.0 << " ms"
+              << "\tcompiled: " << compiledTime / 1000.0 << " ms" << std::endl;
+}
+
+static void BM_ExpressionMode(int keyCount, int eventCount, int rounds) {
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup group(sourceBuffer);
+    PrepareEvents(group, keyCount, eventCount);
+    PipelineContext ctx;
+
+    // and of (key matches one of several patterns and not a drop pattern) for all keys
+    BaseFilterNodePtr root;
+    for (int k = 0; k < keyCount; ++k) {
+        const std::string key = "key_" + ToString(k);
+        BaseFilterNodePtr keep(new BinaryFilterOperatorNode(
+            OR_OPERATOR,
+            BaseFilterNodePtr(new RegexFilterValueNode(key, "info|warn")),
+            BaseFilterNodePtr(new RegexFilterValueNode(key, "value_\\d+_.*"))));
+        BaseFilterNodePtr drop(new UnaryFilterOperatorNode(BaseFilterNodePtr(new RegexFilterValueNode(key, "debug"))));
+        BaseFilterNodePtr clause(new BinaryFilterOperatorNode(AND_OPERATOR, keep, drop));
+        root = root ? BaseFilterNodePtr(new BinaryFilterOperatorNode(AND_OPERATOR, root, clause)) : clause;
+    }
+
+    uint64_t passed = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& e : group.GetEvents()) {
+            passed += root->Match(e.Cast<LogEvent>(), ctx);
+        }
+    }
+    uint64_t treeTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    FilterProgram program;
+    program.Compile(root);
+    uint64_t compiledPassed = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        FilterProgram::Session session(program);
+        for (const auto& e : group.GetEvents()) {
+            compiledPassed += program.Match(e.Cast<LogEvent>(), session, ctx);
+        }
+    }
+    uint64_t compiledTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (passed != compiledPassed) {
+        std::cout << "error: result mismatch " << passed << " vs " << compiledPassed << std::endl;
+    }
+    std::cout << "keys: " << keyCount << "\ttree: " << treeTime / 1000.0 << " ms"
+              << "\tcompiled: " << compiledTime / 1000.0 << " ms" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    int keyCount = argc > 1 ? atoi(argv[1]) : 24;
+    int eventCount = argc > 2 ? atoi(argv[2]) : 10000;
+    std::cout << "BM_RuleMode" << std::endl;
+    BM_RuleMode(keyCount, eventCount, 10);
+    std::cout << "BM_ExpressionMode" << std::endl;
+    BM_ExpressionMode(keyCount, eventCount, 10);
+    return 0;
+}
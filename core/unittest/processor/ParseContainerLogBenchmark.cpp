@@ -16,6 +16,7 @@
 #include <cstring>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "config/PipelineConfig.h"
 #include "models/LogEvent.h"
@@ -40,7 +41,7 @@ std::string formatSize(long long size) {
     return ss.str();
 }
 
-static void BM_DockerJson(int size, int batchSize) {
+static void BM_DockerJson(int size, int batchSize, const std::vector<std::string>& lines) {
     logtail::Logger::Instance().InitGlobalLoggers();
 
     PipelineContext mContext;
@@ -53,65 +54,24 @@ static void BM_DockerJson(int size, int batchSize) {
     processor.SetContext(mContext);
     processor.SetMetricsRecordRef(ProcessorParseContainerLogNative::sName, "1", "1", "1");
 
-    std::string data1
-        = R"({"log":"Exception in thread \"main\" java.lang.NullPointerExceptionat  com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})";
-    std::string data2
-        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873976048Z"})";
-    std::string data3
-        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873978568Z"})";
-    std::string data4
-        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.87398107Z"})";
-    std::cout << "log size:\t" << formatSize((data1.size() + data2.size() + data3.size() + data4.size() + 7 * 4) * size)
-              << std::endl;
+    size_t linesSize = 0;
+    for (const auto& line : lines) {
+        linesSize += line.size() + 7;
+    }
+    std::cout << "log size:\t" << formatSize(linesSize * size) << std::endl;
 
     // make events
     Json::Value root;
     Json::Value events;
     for (int i = 0; i < size; i++) {
-        {
+        for (const auto& line : lines) {
             Json::Value event;
             event["type"] = 1;
             event["timestamp"] = 1234567890;
             event["timestampNanosecond"] = 0;
             {
                 Json::Value contents;
-                contents["content"] = data1;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data2;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data3;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data4;
+                contents["content"] = line;
                 event["contents"] = std::move(contents);
             }
             events.append(event);
@@ -147,12 +107,35 @@ static void BM_DockerJson(int size, int batchSize) {
         }
         std::cout << "durationTime: " << durationTime << std::endl;
         std::cout << "process: "
-                  << formatSize((data1.size() + data2.size() + data3.size() + data4.size() + 7 * 4) * (uint64_t)count
-                                * 1000000 * (uint64_t)size / durationTime)
-                  << std::endl;
+                  << formatSize(linesSize * (uint64_t)count * 1000000 * (uint64_t)size / durationTime) << std::endl;
     }
 }
 
+static std::vector<std::string> GetDockerJsonLines() {
+    std::string data1
+        = R"({"log":"Exception in thread \"main\" java.lang.NullPointerExceptionat  com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})";
+    std::string data2
+        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873976048Z"})";
+    std::string data3
+        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873978568Z"})";
+    std::string data4
+        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.87398107Z"})";
+    return {data1, data2, data3, data4};
+}
+
+// Lines with escapes as written by docker, e.g. html chars, quotes and non-ascii chars.
+static std::vector<std::string> GetEscapedDockerJsonLines() {
+    std::string data1
+        = R"({"log":"{\"level\":\"info\",\"msg\":\"request \u003cGET /api/v1/users?id=1\u0026name=\u4e2d\u6587\u003e done\",\"cost\":\"12ms\"}\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})";
+    std::string data2
+        = R"({"log":"\tat com.example.myproject.Book.getTitle(Book.java:16)\n","stream":"stderr","time":"2024-04-07T08:02:40.873976048Z"})";
+    std::string data3
+        = R"({"log":"2024-04-07 08:02:40.873 INFO  [main] c.e.m.Application - Started Application in 3.2 seconds (JVM running for 3.9) \ud83c\udf0d\n","stream":"stdout","time":"2024-04-07T08:02:40.873978568Z"})";
+    std::string data4
+        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.87398107Z"})";
+    return {data1, data2, data3, data4};
+}
+
 static void BM_ContainerdText(int size, int batchSize) {
     logtail::Logger::Instance().InitGlobalLoggers();
 
@@ -274,7 +257,9 @@ int main(int argc, char** argv) {
     std::cout << "debug" << std::endl;
 #endif
     std::cout << "docker json" << std::endl;
-    BM_DockerJson(512, 100);
+    BM_DockerJson(512, 100, GetDockerJsonLines());
+    std::cout << "docker json with escapes" << std::endl;
+    BM_DockerJson(512, 100, GetEscapedDockerJsonLines());
     std::cout << "containerdText" << std::endl;
     BM_ContainerdText(512, 100);
     return 0;
@@ -0,0 +1,85 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "common/TimeUtil.h"
+#include "models/PipelineEventGroup.h"
+#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterModeSimdParser.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+// Compares DelimiterModeFsmParser against DelimiterModeSimdParser.
+// Usage: parse_delimiter_benchmark [count]
+static void BM_ParseDelimiter(const std::string& name, const std::string& line, int count) {
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    LogEvent* event = group.AddLogEvent();
+    DelimiterModeFsmParser fsmParser('"', ',');
+    DelimiterModeSimdParser simdParser('"', ',');
+    std::vector<StringView> columnValues;
+    StringView buffer(line);
+
+    size_t fsmSum = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < count; ++i) {
+        columnValues.clear();
+        fsmParser.ParseDelimiterLine(buffer, 0, buffer.size(), columnValues, *event);
+        fsmSum += columnValues.size();
+    }
+    uint64_t fsmTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    size_t simdSum = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < count; ++i) {
+        columnValues.clear();
+        simdParser.ParseDelimiterLine(buffer, 0, buffer.size(), columnValues, *event);
+        simdSum += columnValues.size();
+    }
+    uint64_t simdTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (fsmSum != simdSum) {
+        std::cout << "error: result mismatch " << fsmSum << " vs " << simdSum << std::endl;
+    }
+    std::cout << name << "\tsize: " << line.size() << "\tFsm: " << fsmTime / 1000.0
+              << " ms\tSimd: " << simdTime / 1000.0 << " ms" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    std::string wideLine;
+    std::string wideQuotedLine;
+    for (int i = 0; i < 40; ++i) {
+        wideLine += "value_" + std::to_string(i) + ",";
+        wideQuotedLine += "\"value, " + std::to_string(i) + "\",";
+    }
+    wideLine.pop_back();
+    wideQuotedLine.pop_back();
+
+    BM_ParseDelimiter("short", "2013-10-31 21:03:49,POST,PutData?Category=YunOsAccountOpLog,0.024,18204,200", count);
+    BM_ParseDelimiter(
+        "quoted", "\"2013-10-31 21:03:49\",POST,\"PutData?Category=\"\"YunOsAccountOpLog\"\"\",0.024", count);
+    BM_ParseDelimiter("40 columns", wideLine, count);
+    BM_ParseDelimiter("40 quoted columns", wideQuotedLine, count);
+    return 0;
+}
@@ -11,6 +11,8 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <tuple>
+
 #include "common/JsonUtil.h"
 #include "models/LogEvent.h"
 #include "pipeline/plugin/instance/ProcessorInstance.h"
@@ -34,6 +36,8 @@ public:
     void TestCastSensWordMulti();
     void TestMultipleLines();
     void TestMultipleLinesWithProcessorMergeMultilineLogNative();
+    void TestRequiredLiteral();
+    void TestReplacingStringWithGroups();
 
     PipelineContext mContext;
 };
@@ -54,6 +58,10 @@ UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleLines);
 
 UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleLinesWithProcessorMergeMultilineLogNative);
 
+UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestRequiredLiteral);
+
+UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestReplacingStringWithGroups);
+
 PluginInstance::PluginMeta getPluginMeta(){
     PluginInstance::PluginMeta pluginMeta{"testgetPluginID", "testNodeID", "testNodeChildID"};
     return pluginMeta;
@@ -1523,6 +1531,90 @@ void ProcessorDesensitizeNativeUnittest::TestCastSensWordMulti() {
         APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
     }
 }
+
+void ProcessorDesensitizeNativeUnittest::TestRequiredLiteral() {
+    const std::vector<std::tuple<std::string, std::string, std::string>> cases = {
+        {"pwd=", "[^,]+", "pwd="},
+        {"pass\\.word:", "\\S+", "pass.word:"},
+        {"pwd=?", "[^,]+", "pwd"},
+        {"pw+d=", "[^,]+", "pw"},
+        {"\\bpwd=", "[^,]+", ""},
+        {"(?i)pwd=", "[^,]+", ""},
+        {"pwd=", "[^,]+|key", ""},
+        {"pwd=", "?[^,]+", ""},
+    };
+    for (const auto& c : cases) {
+        Json::Value config = GetCastSensWordConfig("cast1", "const", "***", std::get<0>(c), std::get<1>(c), true);
+        ProcessorDesensitizeNative& processor = *(new ProcessorDesensitizeNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        APSARA_TEST_EQUAL(std::get<2>(c), processor.mRequiredLiteral);
+    }
+}
+
+void ProcessorDesensitizeNativeUnittest::TestReplacingStringWithGroups() {
+    Json::Value config = GetCastSensWordConfig("cast1", "const", "<\\2\\\\>", "(p)wd=", "[^,]+", true);
+    ProcessorDesensitizeNative& processor = *(new ProcessorDesensitizeNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+    APSARA_TEST_TRUE(processor.mRewriteCompiled);
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    std::string inJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "cast1" : "pwd=abc,user=x,pwd=12345"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "cast1" : "no password here"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    eventGroup.FromJsonString(inJson);
+    std::vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.emplace_back(std::move(eventGroup));
+    processorInstance.Process(eventGroupList);
+
+    std::string expectJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "cast1" : "pwd=<p\\>,user=x,pwd=<p\\>"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "cast1" : "no password here"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            }
+        ]
+    })";
+    std::string outJson = eventGroupList[0].ToJsonString();
+    APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -31,6 +31,8 @@ public:
     void TestLogFilterRule();
     void TestBaseFilter();
     void TestFilterNoneUtf8();
+    void TestFilterProgram();
+    void TestFilterProgramReorder();
 
     PipelineContext mContext;
 };
@@ -40,6 +42,8 @@ UNIT_TEST_CASE(ProcessorFilterNativeUnittest, OnFailedInit)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestLogFilterRule)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestBaseFilter)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterNoneUtf8)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterProgram)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterProgramReorder)
 
 PluginInstance::PluginMeta getPluginMeta(){
     PluginInstance::PluginMeta pluginMeta{"testgetPluginID", "testNodeID", "testNodeChildID"};
@@ -68,8 +72,8 @@ void ProcessorFilterNativeUnittest::OnSuccessfulInit() {
     processor->SetContext(mContext);
     processor->SetMetricsRecordRef(ProcessorFilterNative::sName, "1", "1", "1");
     APSARA_TEST_TRUE(processor->Init(configJson));
-    APSARA_TEST_EQUAL(1, processor->mFilterRule->FilterKeys.size());
-    APSARA_TEST_EQUAL(1, processor->mFilterRule->FilterRegs.size());
+    APSARA_TEST_TRUE(processor->mFilterMode == ProcessorFilterNative::Mode::RULE_MODE);
+    APSARA_TEST_FALSE(processor->mProgram.Empty());
 }
 
 void ProcessorFilterNativeUnittest::OnFailedInit() {
@@ -116,7 +120,7 @@ void ProcessorFilterNativeUnittest::OnFailedInit() {
     APSARA_TEST_FALSE(processor->Init(configJson));
 }
 
-// To test bool ProcessorFilterNative::Filter(LogEvent& sourceEvent, const LogFilterRule* filterRule)
+// To test filtering by the rules of param Include
 void ProcessorFilterNativeUnittest::TestLogFilterRule() {
     Json::Value config;
     config["Include"] = Json::Value(Json::objectValue);
@@ -1030,6 +1034,87 @@ void ProcessorFilterNativeUnittest::TestFilterNoneUtf8() {
     }
 } // end of case
 
+void ProcessorFilterNativeUnittest::TestFilterProgram() {
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    LogEvent* event = eventGroup.AddLogEvent();
+    event->SetContent(string("level"), string("ERROR"));
+    event->SetContent(string("msg"), string("line1\nline2 abab"));
+
+    {
+        // patterns of the same key are merged into one set, backreference falls back to boost
+        FilterProgram program;
+        APSARA_TEST_TRUE(program.Compile({"level", "msg", "msg", "msg"},
+                                         {"ERROR|WARN", ".*line2.*", "(?i).*LINE1.*", ".*(ab)\\1"}));
+        APSARA_TEST_EQUAL(2U, program.mClauses.size());
+        APSARA_TEST_EQUAL(2U, program.mKeys.size());
+        APSARA_TEST_EQUAL(2U, program.mKeys[1].mSetSize);
+        APSARA_TEST_TRUE(program.mPatterns[3].mRegex != nullptr);
+        FilterProgram::Session session(program);
+        APSARA_TEST_TRUE(program.Match(*event, session, mContext));
+    }
+    {
+        // full match and byte semantics as boost::regex_match
+        FilterProgram program;
+        APSARA_TEST_TRUE(program.Compile({"level"}, {"ERR"}));
+        FilterProgram::Session session(program);
+        APSARA_TEST_FALSE(program.Match(*event, session, mContext));
+        APSARA_TEST_TRUE(program.Compile({"msg"}, {"^line1$\n^line2.*"}));
+        FilterProgram::Session session2(program);
+        APSARA_TEST_TRUE(program.Match(*event, session2, mContext));
+    }
+    {
+        // missing key
+        FilterProgram program;
+        APSARA_TEST_TRUE(program.Compile({"level", "none"}, {".*", ".*"}));
+        FilterProgram::Session session(program);
+        APSARA_TEST_FALSE(program.Match(*event, session, mContext));
+    }
+    {
+        // not (level == INFO or msg == x) and level == ERROR
+        BaseFilterNodePtr info(new RegexFilterValueNode("level", "INFO"));
+        BaseFilterNodePtr x(new RegexFilterValueNode("msg", "x"));
+        BaseFilterNodePtr error(new RegexFilterValueNode("level", "ERROR"));
+        BaseFilterNodePtr orNode(new BinaryFilterOperatorNode(OR_OPERATOR, info, x));
+        BaseFilterNodePtr notNode(new UnaryFilterOperatorNode(orNode));
+        BaseFilterNodePtr root(new BinaryFilterOperatorNode(AND_OPERATOR, notNode, error));
+        FilterProgram program;
+        APSARA_TEST_TRUE(program.Compile(root));
+        APSARA_TEST_EQUAL(2U, program.mClauses.size());
+        FilterProgram::Session session(program);
+        APSARA_TEST_EQUAL(root->Match(*event, mContext), program.Match(*event, session, mContext));
+        APSARA_TEST_TRUE(program.Match(*event, session, mContext));
+
+        event->SetContent(string("level"), string("INFO"));
+        APSARA_TEST_EQUAL(root->Match(*event, mContext), program.Match(*event, session, mContext));
+        APSARA_TEST_FALSE(program.Match(*event, session, mContext));
+    }
+}
+
+void ProcessorFilterNativeUnittest::TestFilterProgramReorder() {
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    LogEvent* event = eventGroup.AddLogEvent();
+    event->SetContent(string("a"), string("1"));
+    event->SetContent(string("b"), string("2"));
+
+    FilterProgram program;
+    APSARA_TEST_TRUE(program.Compile({"a", "b"}, {"1", "1"}));
+    APSARA_TEST_EQUAL(vector<uint32_t>({0, 1}), program.mOrder);
+    {
+        FilterProgram::Session session(program);
+        for (uint64_t i = 0; i < FilterProgram::kReorderInterval; ++i) {
+            APSARA_TEST_FALSE(program.Match(*event, session, mContext));
+        }
+    }
+    // clause of key b rejects all events
+    APSARA_TEST_EQUAL(vector<uint32_t>({1, 0}), program.mOrder);
+    FilterProgram::Session session(program);
+    APSARA_TEST_FALSE(program.Match(*event, session, mContext));
+    APSARA_TEST_EQUAL(0U, session.mEvaluated[0]);
+    APSARA_TEST_EQUAL(1U, session.mRejected[1]);
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -2262,6 +2262,41 @@ void ProcessorParseContainerLogNativeUnittest::TestParseDockerLog() {
         APSARA_TEST_FALSE(result);
         delete[] buffer;
     }
+    // Test with surrogate pairs and invalid unicode escapes, which are kept as is.
+    {
+        DockerLog dockerLog;
+        std::string str
+            = R"({"log":"\ud83c\udf0d \u00e9 \u12g4 \u12","stream":"stdout","time":"2021-12-01T00:00:00.000Z"})";
+        int32_t size = str.size();
+
+        char* buffer = new char[size + 1]();
+        strcpy(buffer, str.c_str());
+
+        bool result = ProcessorParseContainerLogNative::ParseDockerLog(buffer, size, dockerLog);
+
+        APSARA_TEST_TRUE(result);
+        APSARA_TEST_STREQ("🌍 é \\u12g4 \\u12", dockerLog.log.to_string().c_str());
+        APSARA_TEST_EQUAL("stdout", dockerLog.stream);
+        delete[] buffer;
+    }
+    // Test with a long log without escapes, and escapes across simd blocks.
+    {
+        DockerLog dockerLog;
+        std::string log(100, 'a');
+        std::string str = R"({"log":")" + log + R"(\t)" + log + R"(\")" + R"(","stream":"stderr","time":"t"})";
+        int32_t size = str.size();
+
+        char* buffer = new char[size + 1]();
+        strcpy(buffer, str.c_str());
+
+        bool result = ProcessorParseContainerLogNative::ParseDockerLog(buffer, size, dockerLog);
+
+        APSARA_TEST_TRUE(result);
+        APSARA_TEST_EQUAL(log + "\t" + log + "\"", dockerLog.log.to_string());
+        APSARA_TEST_EQUAL("stderr", dockerLog.stream);
+        APSARA_TEST_EQUAL("t", dockerLog.time);
+        delete[] buffer;
+    }
 }
 
 } // namespace logtail
@@ -12,12 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 
 #include "common/Constants.h"
 #include "common/JsonUtil.h"
 #include "config/PipelineConfig.h"
+#include "file_server/reader/LogFileReader.h"
 #include "pipeline/plugin/instance/ProcessorInstance.h"
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 #include "unittest/Unittest.h"
@@ -31,6 +33,7 @@ public:
     void TestInit();
     void TestProcessJson();
     void TestProcessCommon();
+    void TestProcessWithLineIndex();
 
     PipelineContext mContext;
 };
@@ -38,6 +41,7 @@ public:
 UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestProcessJson)
 UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestProcessCommon)
+UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestProcessWithLineIndex)
 
 PluginInstance::PluginMeta getPluginMeta(){
     PluginInstance::PluginMeta pluginMeta{"testgetPluginID", "testNodeID", "testNodeChildID"};
@@ -224,6 +228,48 @@ void ProcessorSplitLogStringNativeUnittest::TestProcessCommon() {
     APSARA_TEST_EQUAL_FATAL(4, processor.GetContext().GetProcessProfile().splitLines);
 }
 
+void ProcessorSplitLogStringNativeUnittest::TestProcessWithLineIndex() {
+    Json::Value config;
+    config["AppendingLogPositionMeta"] = true;
+    ProcessorSplitLogStringNative processor;
+    processor.SetContext(mContext);
+    APSARA_TEST_TRUE_FATAL(processor.Init(config));
+
+    const std::vector<std::string> logs
+        = {"line1\nline2", "line1\n\nline3\n", "\nline2", "line1", "\n\n", std::string(1000, 'a') + "\nline2"};
+    for (const auto& log : logs) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup expected(sourceBuffer);
+        auto event = expected.AddLogEvent();
+        StringBuffer content = sourceBuffer->CopyString(log);
+        event->SetContentNoCopy(DEFAULT_CONTENT_KEY, StringView(content.data, content.size));
+        event->SetTimestamp(12345678901);
+        event->SetPosition(10, log.size() + 1);
+        PipelineEventGroup actual = expected.Copy();
+        auto index = LogFileReader::BuildLineIndex(StringView(content.data, content.size), '\n');
+        APSARA_TEST_TRUE_FATAL(index != nullptr);
+        APSARA_TEST_EQUAL(static_cast<size_t>(std::count(log.begin(), log.end(), '\n')),
+                          index->mSplitPositions.size());
+        actual.SetLineIndex(std::move(index));
+
+        processor.Process(expected);
+        processor.Process(actual);
+        APSARA_TEST_EQUAL(expected.ToJsonString(true), actual.ToJsonString(true));
+        APSARA_TEST_EQUAL(nullptr, actual.GetLineIndex(StringView(content.data, content.size), '\n'));
+    }
+    {
+        // index of another split char is ignored
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        auto event = eventGroup.AddLogEvent();
+        StringBuffer content = sourceBuffer->CopyString(std::string("line1\nline2"));
+        event->SetContentNoCopy(DEFAULT_CONTENT_KEY, StringView(content.data, content.size));
+        eventGroup.SetLineIndex(LogFileReader::BuildLineIndex(StringView(content.data, content.size), '\0'));
+        processor.Process(eventGroup);
+        APSARA_TEST_EQUAL(2U, eventGroup.GetEvents().size());
+    }
+}
+
 } // namespace logtail
 
-UNIT_TEST_MAIN
\ No newline at end of file
+UNIT_TEST_MAIN
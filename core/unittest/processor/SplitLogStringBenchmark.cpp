@@ -0,0 +1,98 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "common/Constants.h"
+#include "common/TimeUtil.h"
+#include "file_server/reader/LogFileReader.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+// Compares ProcessorSplitLogStringNative scanning the buffer by itself against building the reader line index
+// (enable_reader_line_index) and splitting with it. Both sides are single threaded: the index moves the scan from the
+// processor thread to the reader thread, so the build time is what the reader pays per buffer.
+// Usage: split_log_string_benchmark [count]
+static void BM_SplitLogString(const std::string& name, const std::string& buffer, int count) {
+    PipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    ProcessorSplitLogStringNative processor;
+    processor.SetContext(ctx);
+    Json::Value config;
+    processor.Init(config);
+    StringView content(buffer);
+
+    auto makeGroup = [&content]() {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        LogEvent* event = group.AddLogEvent();
+        event->SetContentNoCopy(DEFAULT_CONTENT_KEY, content);
+        event->SetPosition(0, content.size());
+        return group;
+    };
+
+    size_t scanSum = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < count; ++i) {
+        PipelineEventGroup group = makeGroup();
+        processor.Process(group);
+        scanSum += group.GetEvents().size();
+    }
+    uint64_t scanTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    size_t indexSum = 0;
+    uint64_t buildTime = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < count; ++i) {
+        PipelineEventGroup group = makeGroup();
+        uint64_t buildStart = GetCurrentTimeInMicroSeconds();
+        group.SetLineIndex(LogFileReader::BuildLineIndex(content, '\n'));
+        buildTime += GetCurrentTimeInMicroSeconds() - buildStart;
+        processor.Process(group);
+        indexSum += group.GetEvents().size();
+    }
+    uint64_t indexTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (scanSum != indexSum) {
+        std::cout << "error: result mismatch " << scanSum << " vs " << indexSum << std::endl;
+    }
+    std::cout << name << "\tsize: " << buffer.size() << "\tScan: " << scanTime / 1000.0
+              << " ms\tIndex: " << indexTime / 1000.0 << " ms (build " << buildTime / 1000.0 << " ms)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    int count = argc > 1 ? atoi(argv[1]) : 1000;
+
+    std::string shortLines;
+    std::string longLines;
+    for (int i = 0; i < 10000; ++i) {
+        shortLines += "2013-10-31 21:03:49 INFO " + std::to_string(i) + "\n";
+    }
+    for (int i = 0; i < 500; ++i) {
+        longLines += "2013-10-31 21:03:49 INFO " + std::string(1000, 'a') + "\n";
+    }
+
+    BM_SplitLogString("short lines", shortLines, count);
+    BM_SplitLogString("long lines", longLines, count);
+    return 0;
+}
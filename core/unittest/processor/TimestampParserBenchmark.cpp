@@ -0,0 +1,103 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "common/TimeFormatParser.h"
+#include "common/TimeUtil.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+// Compares Strptime against the compiled TimeFormatParser on common formats.
+// Every time string differs from the previous one in seconds, so that no second-level cache would help.
+// Usage: timestamp_parser_benchmark [count]
+struct FormatCase {
+    std::string mFormat;
+    std::string mExample;
+    // offset of the seconds in mExample, increased for each time string
+    size_t mSecondPos;
+};
+
+static std::vector<std::string> PrepareTimeStrs(const FormatCase& c, int count) {
+    std::vector<std::string> strs;
+    strs.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string str = c.mExample;
+        str[c.mSecondPos] = '0' + (i / 10) % 6;
+        str[c.mSecondPos + 1] = '0' + i % 10;
+        strs.push_back(str);
+    }
+    return strs;
+}
+
+static void BM_ParseTime(const FormatCase& c, int count) {
+    std::vector<std::string> strs = PrepareTimeStrs(c, count);
+    TimeFormatParser parser;
+    parser.Init(c.mFormat);
+
+    int64_t strptimeSum = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (const auto& str : strs) {
+        LogtailTime ts = {0, 0};
+        int nanosecondLength = -1;
+        if (Strptime(str.c_str(), c.mFormat.c_str(), &ts, nanosecondLength) != nullptr) {
+            strptimeSum += ts.tv_sec + ts.tv_nsec;
+        }
+    }
+    uint64_t strptimeTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    int64_t compiledSum = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (const auto& str : strs) {
+        LogtailTime ts = {0, 0};
+        int nanosecondLength = -1;
+        if (parser.Parse(str.data(), str.size(), ts, nanosecondLength) != nullptr) {
+            compiledSum += ts.tv_sec + ts.tv_nsec;
+        }
+    }
+    uint64_t compiledTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (strptimeSum != compiledSum) {
+        std::cout << "error: result mismatch " << strptimeSum << " vs " << compiledSum << std::endl;
+    }
+    std::cout << c.mFormat << "\tcompiled: " << parser.IsCompiled() << "\tStrptime: " << strptimeTime / 1000.0
+              << " ms\tTimeFormatParser: " << compiledTime / 1000.0 << " ms" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    const std::vector<FormatCase> cases = {
+        {"%Y-%m-%d %H:%M:%S", "2024-05-20 10:11:12", 17},
+        {"%Y-%m-%d %H:%M:%S.%f", "2024-05-20 10:11:12.123456", 17},
+        {"%Y-%m-%dT%H:%M:%S.%f%z", "2024-05-20T10:11:12.123456789+08:00", 17},
+        {"%d/%b/%Y:%H:%M:%S %z", "20/May/2024:10:11:12 +0800", 18},
+        {"%a %b %e %H:%M:%S %Y", "Mon May 20 10:11:12 2024", 17},
+        {"%s", "1716171012", 8},
+        {"%s", "1716171012123", 8},
+        // falls back to Strptime
+        {"%Y-%m-%d %H:%M:%S %Z", "2024-05-20 10:11:12 UTC", 17},
+    };
+    for (const auto& c : cases) {
+        BM_ParseTime(c, count);
+    }
+    return 0;
+}
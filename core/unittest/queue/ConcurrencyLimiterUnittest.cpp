@@ -0,0 +1,169 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipeline/limiter/ConcurrencyLimiter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ConcurrencyLimiterUnittest : public testing::Test {
+public:
+    void TestPopAndSendDone();
+    void TestAdditiveIncrease();
+    void TestMultiplicativeDecrease();
+    void TestSlowResponse();
+    void TestConvergence();
+
+private:
+    // SimulateRound sends as many requests as the limiter allows to a backend which can serve @capacity requests at
+    // the same time. Requests beyond the capacity fail as if the server were busy, and the response time grows when
+    // the backend is more than half loaded.
+    // @return the number of succeeded requests
+    uint32_t SimulateRound(ConcurrencyLimiter& limiter, time_t curTime, uint32_t capacity, bool withLatency);
+};
+
+void ConcurrencyLimiterUnittest::TestPopAndSendDone() {
+    ConcurrencyLimiter limiter(3);
+    for (size_t i = 0; i < 3; ++i) {
+        APSARA_TEST_TRUE(limiter.IsValidToPop());
+        limiter.PostPop();
+    }
+    APSARA_TEST_FALSE(limiter.IsValidToPop());
+    APSARA_TEST_EQUAL(3U, limiter.GetInSendingCount());
+
+    limiter.OnSendDone();
+    APSARA_TEST_TRUE(limiter.IsValidToPop());
+    APSARA_TEST_EQUAL(2U, limiter.GetInSendingCount());
+
+    // items popped without limits are not counted
+    limiter.OnSendDone();
+    limiter.OnSendDone();
+    limiter.OnSendDone();
+    APSARA_TEST_EQUAL(0U, limiter.GetInSendingCount());
+}
+
+void ConcurrencyLimiterUnittest::TestAdditiveIncrease() {
+    ConcurrencyLimiter limiter(10, 2);
+    limiter.SetLimit(4);
+    for (size_t i = 0; i < 3; ++i) {
+        limiter.OnSuccess(1);
+    }
+    APSARA_TEST_EQUAL(4U, limiter.GetCurrentLimit());
+    limiter.OnSuccess(1);
+    APSARA_TEST_EQUAL(5U, limiter.GetCurrentLimit());
+
+    // never exceeds the max limit
+    for (size_t i = 0; i < 100; ++i) {
+        limiter.OnSuccess(1);
+    }
+    APSARA_TEST_EQUAL(10U, limiter.GetCurrentLimit());
+}
+
+void ConcurrencyLimiterUnittest::TestMultiplicativeDecrease() {
+    ConcurrencyLimiter limiter(16, 2);
+    limiter.OnFail(1);
+    APSARA_TEST_EQUAL(8U, limiter.GetCurrentLimit());
+    // failures in the same second are caused by the same congestion
+    limiter.OnFail(1);
+    APSARA_TEST_EQUAL(8U, limiter.GetCurrentLimit());
+    limiter.OnFail(2);
+    APSARA_TEST_EQUAL(4U, limiter.GetCurrentLimit());
+    limiter.OnFail(3);
+    limiter.OnFail(4);
+    APSARA_TEST_EQUAL(2U, limiter.GetCurrentLimit());
+
+    // successes before a failure do not count towards the next increase
+    limiter.OnSuccess(5);
+    limiter.OnFail(6);
+    limiter.OnSuccess(7);
+    APSARA_TEST_EQUAL(2U, limiter.GetCurrentLimit());
+    limiter.OnSuccess(7);
+    APSARA_TEST_EQUAL(3U, limiter.GetCurrentLimit());
+}
+
+void ConcurrencyLimiterUnittest::TestSlowResponse() {
+    ConcurrencyLimiter limiter(100);
+    limiter.SetLimit(50);
+    limiter.OnSuccess(1, 50);
+    APSARA_TEST_EQUAL(50U, limiter.GetCurrentLimit());
+    // slower, but not much slower
+    limiter.OnSuccess(1, 140);
+    APSARA_TEST_EQUAL(50U, limiter.GetCurrentLimit());
+    limiter.OnSuccess(1, 200);
+    APSARA_TEST_EQUAL(45U, limiter.GetCurrentLimit());
+    APSARA_TEST_EQUAL(0U, limiter.mMinResponseTimeMs);
+}
+
+void ConcurrencyLimiterUnittest::TestConvergence() {
+    const uint32_t capacity = 20;
+    for (bool withLatency : {false, true}) {
+        ConcurrencyLimiter limiter(80);
+        time_t curTime = 1;
+        // converges from the max limit
+        for (size_t i = 0; i < 10; ++i) {
+            SimulateRound(limiter, curTime++, capacity, withLatency);
+        }
+        uint32_t minLimit = limiter.GetCurrentLimit(), maxLimit = limiter.GetCurrentLimit();
+        uint64_t succeeded = 0;
+        const size_t rounds = 200;
+        for (size_t i = 0; i < rounds; ++i) {
+            succeeded += SimulateRound(limiter, curTime++, capacity, withLatency);
+            minLimit = min(minLimit, limiter.GetCurrentLimit());
+            maxLimit = max(maxLimit, limiter.GetCurrentLimit());
+        }
+        APSARA_TEST_TRUE_DESC(minLimit >= capacity / 2 - 1, minLimit);
+        APSARA_TEST_TRUE_DESC(maxLimit <= capacity + 1, maxLimit);
+        // at least half of the capacity is used
+        APSARA_TEST_TRUE_DESC(succeeded >= rounds * capacity / 2, succeeded);
+        APSARA_TEST_EQUAL(0U, limiter.GetInSendingCount());
+    }
+}
+
+uint32_t ConcurrencyLimiterUnittest::SimulateRound(ConcurrencyLimiter& limiter,
+                                                  time_t curTime,
+                                                  uint32_t capacity,
+                                                  bool withLatency) {
+    uint32_t sent = 0;
+    while (limiter.IsValidToPop()) {
+        limiter.PostPop();
+        ++sent;
+    }
+    uint32_t succeeded = 0;
+    for (uint32_t i = 0; i < sent; ++i) {
+        if (i < capacity) {
+            uint32_t responseTimeMs = 20;
+            if (withLatency && sent > capacity / 2) {
+                responseTimeMs += (sent - capacity / 2) * 20;
+            }
+            limiter.OnSuccess(curTime, responseTimeMs);
+            ++succeeded;
+        } else {
+            limiter.OnFail(curTime);
+        }
+        limiter.OnSendDone();
+    }
+    return succeeded;
+}
+
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestPopAndSendDone)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestAdditiveIncrease)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestMultiplicativeDecrease)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestSlowResponse)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestConvergence)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -245,7 +245,7 @@ void ExactlyOnceQueueManagerUnittest::TestGetAllAvailableSenderQueueItems() {
         vector<SenderQueueItem*> items;
         sManager->GetAllAvailableSenderQueueItems(items);
         APSARA_TEST_EQUAL(3U, items.size());
-        APSARA_TEST_EQUAL(0, regionConcurrencyLimiter->GetLimit());
+        APSARA_TEST_EQUAL(3U, regionConcurrencyLimiter->GetInSendingCount());
     }
 }
 
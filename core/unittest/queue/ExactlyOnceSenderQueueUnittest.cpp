@@ -139,10 +139,12 @@ void ExactlyOnceSenderQueueUnittest::TestGetAllAvailableItems() {
         mQueue->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(1U, items.size());
         APSARA_TEST_EQUAL(sDataSize, mQueue->mRateLimiter->mLastSecondTotalBytes);
-        APSARA_TEST_EQUAL(0, mQueue->mConcurrencyLimiters[0]->GetLimit());
+        APSARA_TEST_EQUAL(1U, mQueue->mConcurrencyLimiters[0]->GetInSendingCount());
         for (auto& item : items) {
+            item->ReleaseConcurrency();
             item->mStatus = SendingStatus::IDLE;
         }
+        APSARA_TEST_EQUAL(0U, mQueue->mConcurrencyLimiters[0]->GetInSendingCount());
         mQueue->mRateLimiter->mLastSecondTotalBytes = 0;
     }
     {
@@ -153,7 +155,7 @@ void ExactlyOnceSenderQueueUnittest::TestGetAllAvailableItems() {
         mQueue->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(1U, items.size());
         APSARA_TEST_EQUAL(sDataSize, mQueue->mRateLimiter->mLastSecondTotalBytes);
-        APSARA_TEST_EQUAL(2, mQueue->mConcurrencyLimiters[0]->GetLimit());
+        APSARA_TEST_EQUAL(1U, mQueue->mConcurrencyLimiters[0]->GetInSendingCount());
         mQueue->mRateLimiter->mLastSecondTotalBytes = 0;
     }
     {
@@ -164,7 +166,7 @@ void ExactlyOnceSenderQueueUnittest::TestGetAllAvailableItems() {
         mQueue->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(1U, items.size());
         APSARA_TEST_EQUAL(sDataSize, mQueue->mRateLimiter->mLastSecondTotalBytes);
-        APSARA_TEST_EQUAL(2, mQueue->mConcurrencyLimiters[0]->GetLimit());
+        APSARA_TEST_EQUAL(2U, mQueue->mConcurrencyLimiters[0]->GetInSendingCount());
     }
 }
 
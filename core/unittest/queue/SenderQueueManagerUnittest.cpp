@@ -213,7 +213,7 @@ void SenderQueueManagerUnittest::TestGetAllAvailableItems() {
         vector<SenderQueueItem*> items;
         sManager->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(3U, items.size());
-        APSARA_TEST_EQUAL(0, regionConcurrencyLimiter->GetLimit());
+        APSARA_TEST_EQUAL(3U, regionConcurrencyLimiter->GetInSendingCount());
     }
 }
 
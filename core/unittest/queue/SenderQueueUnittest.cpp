@@ -133,10 +133,12 @@ void SenderQueueUnittest::TestGetAllAvailableItems() {
         mQueue->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(1U, items.size());
         APSARA_TEST_EQUAL(sDataSize, mQueue->mRateLimiter->mLastSecondTotalBytes);
-        APSARA_TEST_EQUAL(0, sConcurrencyLimiter->GetLimit());
+        APSARA_TEST_EQUAL(1U, sConcurrencyLimiter->GetInSendingCount());
         for (auto& item : items) {
+            item->ReleaseConcurrency();
             item->mStatus = SendingStatus::IDLE;
         }
+        APSARA_TEST_EQUAL(0U, sConcurrencyLimiter->GetInSendingCount());
         mQueue->mRateLimiter->mLastSecondTotalBytes = 0;
     }
     {
@@ -147,7 +149,7 @@ void SenderQueueUnittest::TestGetAllAvailableItems() {
         mQueue->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(1U, items.size());
         APSARA_TEST_EQUAL(sDataSize, mQueue->mRateLimiter->mLastSecondTotalBytes);
-        APSARA_TEST_EQUAL(2, sConcurrencyLimiter->GetLimit());
+        APSARA_TEST_EQUAL(1U, sConcurrencyLimiter->GetInSendingCount());
         mQueue->mRateLimiter->mLastSecondTotalBytes = 0;
     }
     {
@@ -158,7 +160,7 @@ void SenderQueueUnittest::TestGetAllAvailableItems() {
         mQueue->GetAllAvailableItems(items);
         APSARA_TEST_EQUAL(1U, items.size());
         APSARA_TEST_EQUAL(sDataSize, mQueue->mRateLimiter->mLastSecondTotalBytes);
-        APSARA_TEST_EQUAL(2, sConcurrencyLimiter->GetLimit());
+        APSARA_TEST_EQUAL(2U, sConcurrencyLimiter->GetInSendingCount());
     }
 }
 
@@ -0,0 +1,126 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "file_server/reader/AsyncReadEngine.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_reader_io_uring_read);
+DECLARE_FLAG_INT32(reader_io_uring_max_inflight);
+
+using namespace logtail;
+
+static const size_t kChunkSize = 512 * 1024;
+
+static void dropPageCache(const std::vector<int>& fds) {
+    for (int fd : fds) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+}
+
+// Compares the time of reading one chunk of every file, like LogInput does when all files have new data.
+// Usage: async_read_benchmark [dir] [file count]
+// Put dir on a throttled block device (e.g. dm-delay, or a cgroup io.max limit) to see the difference,
+// page cache is dropped before each round but local SSD is still fast.
+static void BM_ReadRound(const std::string& dir, int fileCount, int rounds) {
+    std::vector<int> fds;
+    std::string content(kChunkSize, 'a');
+    for (int i = 0; i < fileCount; ++i) {
+        std::string path = PathJoin(dir, "file_" + ToString(i));
+        if (!CheckExistance(path)) {
+            std::ofstream(path) << content;
+        }
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cout << "open file failed: " << path << std::endl;
+            return;
+        }
+        fds.push_back(fd);
+    }
+
+    {
+        std::unique_ptr<char[]> buf(new char[kChunkSize + 1]);
+        uint64_t durationTime = 0, bytes = 0;
+        for (int r = 0; r < rounds; ++r) {
+            dropPageCache(fds);
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            for (int fd : fds) {
+                bytes += pread(fd, buf.get(), kChunkSize, 0);
+            }
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "pread (current path)\tfiles: " << fileCount << "\tround time: " << durationTime / rounds / 1000.0
+                  << " ms\tbytes: " << bytes / rounds << std::endl;
+    }
+
+    {
+        BOOL_FLAG(enable_reader_io_uring_read) = true;
+        AsyncReadEngine engine;
+        if (!engine.IsEnabled()) {
+            std::cout << "io_uring read is not supported" << std::endl;
+        } else {
+            const size_t batch = static_cast<size_t>(INT32_FLAG(reader_io_uring_max_inflight));
+            uint64_t durationTime = 0, bytes = 0;
+            for (int r = 0; r < rounds; ++r) {
+                dropPageCache(fds);
+                uint64_t startTime = GetCurrentTimeInMicroSeconds();
+                for (size_t begin = 0; begin < fds.size(); begin += batch) {
+                    size_t end = std::min(fds.size(), begin + batch);
+                    for (size_t i = begin; i < end; ++i) {
+                        engine.Prefetch(&fds[i], fds[i], 0, 0, kChunkSize);
+                    }
+                    engine.Submit();
+                    for (size_t i = begin; i < end; ++i) {
+                        AsyncReadEngine::Completion completion;
+                        if (engine.Take(&fds[i], fds[i], 0, 0, 0, completion)) {
+                            bytes += completion.size;
+                        }
+                    }
+                }
+                durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+            }
+            std::cout << "io_uring (inflight " << batch << ")\tfiles: " << fileCount
+                      << "\tround time: " << durationTime / rounds / 1000.0 << " ms\tbytes: " << bytes / rounds
+                      << std::endl;
+        }
+    }
+
+    for (int fd : fds) {
+        close(fd);
+    }
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::string dir = argc > 1 ? argv[1] : GetProcessExecutionDir() + "async_read_benchmark";
+    int fileCount = argc > 2 ? atoi(argv[2]) : 1000;
+    bfs::create_directories(dir);
+    std::cout << "BM_ReadRound" << std::endl;
+    BM_ReadRound(dir, fileCount, 5);
+    return 0;
+}
@@ -0,0 +1,195 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/reader/AsyncReadEngine.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_reader_io_uring_read);
+
+using namespace std;
+
+namespace logtail {
+
+class AsyncReadEngineUnittest : public ::testing::Test {
+public:
+    void TestDisabled();
+    void TestPrefetchAndTake();
+    void TestMismatch();
+    void TestCancel();
+    void TestDefer();
+
+protected:
+    static void SetUpTestCase() {
+        sTestDir = GetProcessExecutionDir() + "AsyncReadEngineUnittest";
+        bfs::remove_all(sTestDir);
+        bfs::create_directories(sTestDir);
+        sContent.reserve(sFileSize);
+        for (size_t i = 0; i < sFileSize; ++i) {
+            sContent.push_back('a' + i % 26);
+        }
+        sFilePath = PathJoin(sTestDir, "test.log");
+        ofstream(sFilePath) << sContent;
+    }
+
+    static void TearDownTestCase() { bfs::remove_all(sTestDir); }
+
+    void SetUp() override {
+        BOOL_FLAG(enable_reader_io_uring_read) = true;
+        mFd = open(sFilePath.c_str(), O_RDONLY);
+        APSARA_TEST_TRUE_FATAL(mFd >= 0);
+    }
+
+    void TearDown() override {
+        close(mFd);
+        BOOL_FLAG(enable_reader_io_uring_read) = false;
+    }
+
+private:
+    static const size_t sFileSize = 1024 * 1024;
+    static string sTestDir;
+    static string sFilePath;
+    static string sContent;
+    int mFd = -1;
+};
+
+string AsyncReadEngineUnittest::sTestDir;
+string AsyncReadEngineUnittest::sFilePath;
+string AsyncReadEngineUnittest::sContent;
+
+void AsyncReadEngineUnittest::TestDisabled() {
+    BOOL_FLAG(enable_reader_io_uring_read) = false;
+    AsyncReadEngine engine;
+    int owner = 0;
+    APSARA_TEST_FALSE(engine.IsEnabled());
+    APSARA_TEST_FALSE(engine.Prefetch(&owner, mFd, 0, 0, 1024));
+    APSARA_TEST_FALSE(engine.ShouldDefer(&owner));
+    AsyncReadEngine::Completion completion;
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd, 0, 0, 0, completion));
+    APSARA_TEST_TRUE(completion.sourceBuffer == nullptr);
+}
+
+void AsyncReadEngineUnittest::TestPrefetchAndTake() {
+    AsyncReadEngine engine;
+    if (!engine.IsEnabled()) {
+        LOG_INFO(sLogger, ("io_uring read is not supported", "skip"));
+        return;
+    }
+    vector<int> owners(10);
+    const size_t reserved = 100, size = 4096;
+    for (size_t i = 0; i < owners.size(); ++i) {
+        APSARA_TEST_TRUE(engine.Prefetch(&owners[i], mFd, i * size, reserved, size));
+    }
+    engine.Submit();
+    APSARA_TEST_EQUAL(owners.size(), engine.GetInflightCount());
+    for (size_t i = 0; i < owners.size(); ++i) {
+        AsyncReadEngine::Completion completion;
+        APSARA_TEST_TRUE(engine.Take(&owners[i], mFd, i * size, reserved, size, completion));
+        APSARA_TEST_TRUE(completion.sourceBuffer != nullptr);
+        APSARA_TEST_EQUAL(size, completion.size);
+        APSARA_TEST_EQUAL(sContent.substr(i * size, size), string(completion.data + reserved, completion.size));
+    }
+    APSARA_TEST_EQUAL(0U, engine.GetInflightCount());
+
+    // read at the end of file
+    int owner = 0;
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, sFileSize - 10, 0, 4096));
+    AsyncReadEngine::Completion completion;
+    APSARA_TEST_TRUE(engine.Take(&owner, mFd, sFileSize - 10, 0, 10, completion));
+    APSARA_TEST_EQUAL(10U, completion.size);
+    APSARA_TEST_EQUAL(sContent.substr(sFileSize - 10), string(completion.data, completion.size));
+}
+
+void AsyncReadEngineUnittest::TestMismatch() {
+    AsyncReadEngine engine;
+    if (!engine.IsEnabled()) {
+        return;
+    }
+    int owner = 0;
+    AsyncReadEngine::Completion completion;
+    // offset changed
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 0, 0, 4096));
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd, 10, 0, 4096, completion));
+    // cache size changed
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 0, 0, 4096));
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd, 0, 10, 4096, completion));
+    // fd changed
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 0, 0, 4096));
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd + 1, 0, 0, 4096, completion));
+    // less than required
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, sFileSize - 10, 0, 4096));
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd, sFileSize - 10, 0, 4096, completion));
+    // taken once only
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd, sFileSize - 10, 0, 10, completion));
+    APSARA_TEST_TRUE(completion.sourceBuffer == nullptr);
+    APSARA_TEST_EQUAL(0U, engine.GetInflightCount());
+}
+
+void AsyncReadEngineUnittest::TestCancel() {
+    AsyncReadEngine engine;
+    if (!engine.IsEnabled()) {
+        return;
+    }
+    int owner = 0;
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 0, 0, 4096));
+    engine.Cancel(&owner);
+    AsyncReadEngine::Completion completion;
+    APSARA_TEST_FALSE(engine.Take(&owner, mFd, 0, 0, 4096, completion));
+
+    // prefetch again drops the previous one
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 0, 0, 4096));
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 4096, 0, 4096));
+    APSARA_TEST_TRUE(engine.Take(&owner, mFd, 4096, 0, 4096, completion));
+    APSARA_TEST_EQUAL(sContent.substr(4096, 4096), string(completion.data, completion.size));
+
+    // canceled requests are released when completed
+    for (size_t i = 0; i < 1000 && engine.GetInflightCount() > 0; ++i) {
+        usleep(1000);
+        engine.reap();
+    }
+    APSARA_TEST_EQUAL(0U, engine.GetInflightCount());
+}
+
+void AsyncReadEngineUnittest::TestDefer() {
+    AsyncReadEngine engine;
+    if (!engine.IsEnabled()) {
+        return;
+    }
+    int owner = 0, other = 0;
+    APSARA_TEST_FALSE(engine.ShouldDefer(&owner));
+    APSARA_TEST_TRUE(engine.Prefetch(&owner, mFd, 0, 0, sFileSize));
+    // read may complete at once with page cache, defer at most once anyway
+    engine.ShouldDefer(&owner);
+    APSARA_TEST_FALSE(engine.ShouldDefer(&owner));
+    APSARA_TEST_FALSE(engine.ShouldDefer(&other));
+    AsyncReadEngine::Completion completion;
+    APSARA_TEST_TRUE(engine.Take(&owner, mFd, 0, 0, sFileSize, completion));
+    APSARA_TEST_EQUAL(sContent, string(completion.data, completion.size));
+}
+
+UNIT_TEST_CASE(AsyncReadEngineUnittest, TestDisabled)
+UNIT_TEST_CASE(AsyncReadEngineUnittest, TestPrefetchAndTake)
+UNIT_TEST_CASE(AsyncReadEngineUnittest, TestMismatch)
+UNIT_TEST_CASE(AsyncReadEngineUnittest, TestCancel)
+UNIT_TEST_CASE(AsyncReadEngineUnittest, TestDefer)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -26,6 +26,8 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(force_release_deleted_file_fd_timeout);
+DECLARE_FLAG_INT32(reader_catch_up_min_backlog_bytes);
+DECLARE_FLAG_INT32(reader_catch_up_readahead_bytes);
 
 namespace logtail {
 
@@ -66,10 +68,13 @@ public:
     }
     void TearDown() override {
         LogFileReader::BUFFER_SIZE = 1024 * 512;
+        INT32_FLAG(reader_catch_up_min_backlog_bytes) = 256 * 1024 * 1024;
+        INT32_FLAG(reader_catch_up_readahead_bytes) = 16 * 1024 * 1024;
         FileServer::GetInstance()->RemoveFileDiscoveryConfig("");
     }
     void TestReadGBK();
     void TestReadUTF8();
+    void TestCatchUpMode();
 
     std::unique_ptr<char[]> expectedContent;
     static std::string logPathDir;
@@ -82,6 +87,7 @@ public:
 
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadGBK);
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestCatchUpMode);
 
 std::string LogFileReaderUnittest::logPathDir;
 std::string LogFileReaderUnittest::gbkFile;
@@ -506,6 +512,42 @@ void LogFileReaderUnittest::TestReadUTF8() {
     }
 }
 
+void LogFileReaderUnittest::TestCatchUpMode() {
+    INT32_FLAG(reader_catch_up_min_backlog_bytes) = 200;
+    INT32_FLAG(reader_catch_up_readahead_bytes) = 150;
+    MultilineOptions multilineOpts;
+    FileReaderOptions readerOpts;
+    readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+    LogFileReader reader(
+        logPathDir, utf8File, DevInode(), std::make_pair(&readerOpts, &ctx), std::make_pair(&multilineOpts, &ctx));
+    LogFileReader::BUFFER_SIZE = 200;
+    reader.UpdateReaderManual();
+    reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+    reader.CheckFileSignatureAndOffset(true);
+    int64_t fileSize = reader.mLogFileOp.GetFileSize();
+    APSARA_TEST_TRUE_FATAL(fileSize > 400);
+
+    // backlog is large, enter catch-up mode and read ahead
+    LogBuffer logBuffer;
+    APSARA_TEST_TRUE_FATAL(reader.GetRawData(logBuffer, fileSize));
+    APSARA_TEST_TRUE(reader.mCatchUpMode);
+    APSARA_TEST_EQUAL(150, reader.mReadaheadEnd);
+    std::string content(logBuffer.rawBuffer.data(), logBuffer.rawBuffer.size());
+
+    // leave catch-up mode near EOF, read result is not affected
+    for (int i = 0; i < 100 && reader.mLastFilePos < fileSize; ++i) {
+        int64_t backlog = fileSize - reader.mLastFilePos;
+        LogBuffer buffer;
+        reader.GetRawData(buffer, fileSize);
+        if (!buffer.rawBuffer.empty()) {
+            content.append("\n").append(buffer.rawBuffer.data(), buffer.rawBuffer.size());
+        }
+        APSARA_TEST_EQUAL(backlog > 150, reader.mCatchUpMode);
+    }
+    APSARA_TEST_FALSE(reader.mCatchUpMode);
+    APSARA_TEST_EQUAL(std::string(expectedContent.get()), content);
+}
+
 class LogMultiBytesUnittest : public ::testing::Test {
 public:
     static void SetUpTestCase() {
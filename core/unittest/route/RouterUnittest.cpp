@@ -25,6 +25,7 @@ class RouterUnittest : public testing::Test {
 public:
     void TestInit();
     void TestRoute();
+    void TestRouteWithTags();
 
 private:
     PipelineContext ctx;
@@ -107,10 +108,12 @@ void RouterUnittest::TestRoute() {
 
     Router router;
     router.Init(configs, ctx);
+    APSARA_TEST_TRUE(router.mIsCompiled);
+    vector<size_t> buffer;
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         g.AddLogEvent();
-        auto res = router.Route(g);
+        const auto& res = router.Route(g, buffer);
         APSARA_TEST_EQUAL(2U, res.size());
         APSARA_TEST_EQUAL(1U, res[0]);
         APSARA_TEST_EQUAL(0U, res[1]);
@@ -118,14 +121,107 @@ void RouterUnittest::TestRoute() {
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         g.AddMetricEvent();
-        auto res = router.Route(g);
+        const auto& res = router.Route(g, buffer);
         APSARA_TEST_EQUAL(1U, res.size());
         APSARA_TEST_EQUAL(1U, res[0]);
     }
+    {
+        // no condition
+        Router router;
+        router.Init({{0, nullptr}, {1, nullptr}}, ctx);
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        const auto& res = router.Route(g, buffer);
+        APSARA_TEST_EQUAL(&router.mAlwaysMatchedFlusherIdx, &res);
+        APSARA_TEST_EQUAL(2U, res.size());
+    }
+}
+
+void RouterUnittest::TestRouteWithTags() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"(
+        [
+            {
+                "Type": "tag",
+                "Key": "tenant",
+                "Value": "b"
+            },
+            {
+                "Type": "event_type",
+                "Value": "metric"
+            },
+            {
+                "Type": "tag",
+                "Key": "tenant",
+                "Value": "a"
+            },
+            {
+                "Type": "tag",
+                "Key": "tenant",
+                "Value": "a"
+            }
+        ]
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    vector<pair<size_t, const Json::Value*>> configs;
+    // flusher indices differ from condition indices
+    for (Json::Value::ArrayIndex i = 0; i < configJson.size(); ++i) {
+        configs.emplace_back(i + 1, &configJson[i]);
+    }
+    configs.emplace_back(0, nullptr);
+
+    Router router;
+    APSARA_TEST_TRUE(router.Init(configs, ctx));
+    APSARA_TEST_TRUE(router.mIsCompiled);
+    APSARA_TEST_EQUAL(2U, router.mTagValues.size());
+
+    vector<size_t> buffer;
+    for (const string& tenant : {"a", "b", "c", ""}) {
+        for (size_t eventType = 0; eventType < 3; ++eventType) {
+            PipelineEventGroup g(make_shared<SourceBuffer>());
+            if (!tenant.empty()) {
+                g.SetTag(string("tenant"), tenant);
+            }
+            if (eventType == 1) {
+                g.AddLogEvent();
+            } else if (eventType == 2) {
+                g.AddMetricEvent();
+            }
+            vector<size_t> expected{0};
+            for (const auto& item : router.mConditions) {
+                if (item.second.Check(g)) {
+                    expected.push_back(item.first);
+                }
+            }
+            const auto& res = router.Route(g, buffer);
+            APSARA_TEST_EQUAL(expected, res);
+        }
+    }
+    {
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.SetTag(string("tenant"), string("a"));
+        g.AddMetricEvent();
+        APSARA_TEST_EQUAL(vector<size_t>({0, 2, 3, 4}), router.Route(g, buffer));
+    }
+
+    // conditions on different tag keys are evaluated one by one
+    configJson[1]["Type"] = "tag";
+    configJson[1]["Key"] = "region";
+    configJson[1]["Value"] = "cn";
+    Router uncompiledRouter;
+    APSARA_TEST_TRUE(uncompiledRouter.Init(configs, ctx));
+    APSARA_TEST_FALSE(uncompiledRouter.mIsCompiled);
+    PipelineEventGroup g(make_shared<SourceBuffer>());
+    g.SetTag(string("tenant"), string("b"));
+    g.SetTag(string("region"), string("cn"));
+    const auto& res = uncompiledRouter.Route(g, buffer);
+    APSARA_TEST_EQUAL(&buffer, &res);
+    APSARA_TEST_EQUAL(vector<size_t>({0, 1, 2}), res);
 }
 
 UNIT_TEST_CASE(RouterUnittest, TestInit)
 UNIT_TEST_CASE(RouterUnittest, TestRoute)
+UNIT_TEST_CASE(RouterUnittest, TestRouteWithTags)
 
 } // namespace logtail
 
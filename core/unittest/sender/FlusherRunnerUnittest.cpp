@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "app_config/AppConfig.h"
 #include "pipeline/plugin/PluginRegistry.h"
 #include "pipeline/queue/SenderQueueManager.h"
 #include "runner/FlusherRunner.h"
@@ -26,6 +27,7 @@ namespace logtail {
 class FlusherRunnerUnittest : public ::testing::Test {
 public:
     void TestDispatch();
+    void TestTakeAndDispatchItems();
 };
 
 void FlusherRunnerUnittest::TestDispatch() {
@@ -61,7 +63,53 @@ void FlusherRunnerUnittest::TestDispatch() {
     }
 }
 
+void FlusherRunnerUnittest::TestTakeAndDispatchItems() {
+    auto flusher = make_unique<FlusherHttpMock>();
+    Json::Value tmp;
+    flusher->Init(Json::Value(), tmp);
+
+    vector<SenderQueueItem*> items;
+    for (time_t enqueTime : {3, 1, 2, 1}) {
+        auto item = make_unique<SenderQueueItem>("content", 10, flusher.get(), flusher->GetQueueKey());
+        items.push_back(item.get());
+        flusher->PushToQueue(std::move(item));
+        items.back()->mEnqueTime = enqueTime;
+    }
+
+    auto runner = FlusherRunner::GetInstance();
+    // only 2 more requests can be sent
+    runner->mHttpSendingCnt = AppConfig::GetInstance()->GetSendRequestConcurrency() - 2;
+    APSARA_TEST_TRUE(runner->TakeAndDispatchItems());
+    // earliest enqueued items are dispatched first, and the rest are pending instead of blocking the runner
+    APSARA_TEST_NOT_EQUAL(0, items[1]->mLastSendTime);
+    APSARA_TEST_NOT_EQUAL(0, items[3]->mLastSendTime);
+    APSARA_TEST_EQUAL(0, items[0]->mLastSendTime);
+    APSARA_TEST_EQUAL(0, items[2]->mLastSendTime);
+    APSARA_TEST_EQUAL(2U, runner->mPendingItems.size());
+    APSARA_TEST_EQUAL(items[2], runner->mPendingItems.top().mItem);
+    APSARA_TEST_FALSE(runner->TakeAndDispatchItems());
+
+    runner->DecreaseHttpSendingCnt();
+    APSARA_TEST_TRUE(runner->TakeAndDispatchItems());
+    APSARA_TEST_NOT_EQUAL(0, items[2]->mLastSendTime);
+    APSARA_TEST_EQUAL(0, items[0]->mLastSendTime);
+
+    runner->DecreaseHttpSendingCnt();
+    APSARA_TEST_TRUE(runner->TakeAndDispatchItems());
+    APSARA_TEST_NOT_EQUAL(0, items[0]->mLastSendTime);
+    APSARA_TEST_TRUE(runner->mPendingItems.empty());
+
+    unique_ptr<HttpSinkRequest> req;
+    size_t reqCnt = 0;
+    while (HttpSink::GetInstance()->mQueue.TryPop(req)) {
+        ++reqCnt;
+    }
+    APSARA_TEST_EQUAL(4U, reqCnt);
+    runner->mHttpSendingCnt = 0;
+}
+
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestDispatch)
+UNIT_TEST_CASE(FlusherRunnerUnittest, TestTakeAndDispatchItems)
 
 } // namespace logtail
 